@@ -0,0 +1,25 @@
+#ifndef BENCHOPTIONS_H
+#define BENCHOPTIONS_H
+
+/******************************************************************************
+ *  Command-line options shared by the benchmarks, algs4cpp-sort-bench and
+ *  algs4cpp-pq-bench.
+ ******************************************************************************/
+
+// the comma-separated items of list, each of which must be one of the choices, if any are given
+inline std::vector<std::string> choose(const std::string& list, const std::vector<std::string>& choices)
+{
+    std::vector<std::string> chosen = std::vector<std::string>();
+    size_t start = 0;
+    while (start <= list.size())
+    {
+        size_t end = std::min(list.find(',', start), list.size());
+        std::string item = list.substr(start, end - start);
+        if (!choices.empty() && std::find(choices.begin(), choices.end(), item) == choices.end()) error("unknown choice: {}", item);
+        chosen.push_back(item);
+        start = end + 1;
+    }
+    return chosen;
+}
+
+#endif
@@ -0,0 +1,58 @@
+#include "ExternalSort.h"
+#include "StdOut.h"
+
+/******************************************************************************
+ *  Execution:    external-sort [-n] [-m megabytes] [-k fan-in] [-t tmpdir] input output
+ *
+ *  Sorts the lines (or, with -n, the integers) of a file that may be much
+ *  larger than memory, using at most about the given number of megabytes
+ *  and merging at most fan-in sorted runs at a time.
+ *
+ *  % external-sort -m 4096 -t /scratch big.txt big-sorted.txt
+ *  runs: 27, merge passes: 1
+ *
+ ******************************************************************************/
+
+/**
+ *  Reads the options and the input and output files from the command line,
+ *  sorts the input into the output with an {@link ExternalSort}, and prints
+ *  the number of runs and merge passes to standard output.
+ *
+ * @param args the command-line arguments
+ */
+int main(int argc, char** argv)
+{
+    bool integers = false;
+    long long megabytes = 1024;
+    int fan_in = 64;
+    std::string temp_dir = "";
+
+    int i = 1;
+    for (; i < argc && argv[i][0] == '-'; i++)
+    {
+        std::string option = argv[i];
+        if (option == "-n") integers = true;
+        else if (i + 1 == argc) break;
+        else if (option == "-m") megabytes = atoll(argv[++i]);
+        else if (option == "-k") fan_in = atoi(argv[++i]);
+        else if (option == "-t") temp_dir = argv[++i];
+        else break;
+    }
+    if (argc - i != 2)
+    {
+        StdOut::println("usage: external-sort [-n] [-m megabytes] [-k fan-in] [-t tmpdir] input output");
+        return 1;
+    }
+
+    ExternalSort sorter = ExternalSort(megabytes << 20, fan_in, temp_dir);
+    try
+    {
+        if (integers) sorter.sort_integers(argv[i], argv[i + 1]);
+        else          sorter.sort_lines(argv[i], argv[i + 1]);
+    }
+    catch (const std::exception& e)
+    {
+        error("{}", e.what());
+    }
+    StdOut::printf("runs: %d, merge passes: %d\n", sorter.runs(), sorter.merge_passes());
+}
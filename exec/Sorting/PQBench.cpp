@@ -0,0 +1,202 @@
+#include "IndexMinPQ.h"
+#include "RadixHeap.h"
+#include "BucketQueue.h"
+#include "Stopwatch.h"
+#include "StdRandom.h"
+#include "StdOut.h"
+#include "BenchOptions.h"
+
+/******************************************************************************
+ *  Execution:    algs4cpp-pq-bench [-n min] [-N max] [-c ranges] [-q queues]
+ *                                  [-r repeats] [-f csv|json]
+ *
+ *  Times the monotone indexed priority queues against the binary and 4-ary
+ *  heaps of IndexMinPQ on the workload of Dijkstra's algorithm, at queue
+ *  sizes doubling from min to max and at each range of keys: n indices are
+ *  inserted, then each of 4n rounds removes the minimum, inserts it again
+ *  at a random distance of 1 to range above it, and decreases the key of a
+ *  random index to a random key between the minimum and its own, before the
+ *  queue is drained. Prints one record per run: the best time of the repeats
+ *  in nanoseconds per operation. The heaps pay O(log n) compares per
+ *  operation and do not depend on the range; the radix heap pays O(log C)
+ *  bucket moves per key, and the bucket queue a scan of O(C) buckets per
+ *  unit of growth of the minimum over the run. Build in Release.
+ *
+ *  Queues:  binary 4-ary radix bucket
+ *
+ *  % algs4cpp-pq-bench -n 1000 -N 512000 -c 10,1000000 -r 2
+ *  queue,n,range,ns_per_operation
+ *  binary,1000,10,32.54
+ *  4-ary,1000,10,26.83
+ *  radix,1000,10,13.85
+ *  bucket,1000,10,9.38
+ *  ...
+ *  binary,1000,1000000,40.66
+ *  4-ary,1000,1000000,31.74
+ *  radix,1000,1000000,36.15
+ *  bucket,1000,1000000,472.05
+ *  ...
+ *  binary,512000,1000000,98.19
+ *  4-ary,512000,1000000,94.49
+ *  radix,512000,1000000,104.53
+ *  bucket,512000,1000000,48.95
+ *
+ ******************************************************************************/
+
+static const std::vector<std::string> QUEUES = { "binary", "4-ary", "radix", "bucket" };
+
+// the random choices of a run, drawn before the timing
+struct Workload
+{
+    std::vector<int> keys;          // initial key of each index
+    std::vector<int> distances;     // distance of each reinsertion above the minimum, 1 to range
+    std::vector<int> indices;       // index to decrease in each round
+    std::vector<double> fractions;  // how far down towards the minimum to decrease it
+};
+
+static Workload workload(int n, int range)
+{
+    Workload w;
+    for (int i = 0; i < n; i++)
+        w.keys.push_back(StdRandom::uniform_int(range + 1));
+    for (int r = 0; r < 4 * n; r++)
+    {
+        w.distances.push_back(StdRandom::uniform_int(1, range + 1));
+        w.indices.push_back(StdRandom::uniform_int(n));
+        w.fractions.push_back(StdRandom::uniform_double());
+    }
+    return w;
+}
+
+// seconds to run the workload on the queue, and the number of operations
+template <typename PQ>
+static std::pair<double, long long> run(PQ& pq, const Workload& w)
+{
+    int n = w.keys.size();
+    long long operations = 0;
+    long long checksum = 0;
+    Stopwatch timer = Stopwatch();
+    for (int i = 0; i < n; i++)
+        pq.insert(i, w.keys[i]);
+    operations += n;
+
+    for (int r = 0; r < w.distances.size(); r++)
+    {
+        int min = pq.min_key();
+        int i = pq.del_min();
+        pq.insert(i, min + w.distances[r]);
+
+        int j = w.indices[r];
+        int key = pq.key_of(j);
+        int lower = min + (int) ((key - min) * w.fractions[r]);
+        if (lower < key) pq.decrease_key(j, lower);
+        operations += 3;
+    }
+
+    while (!pq.is_empty())
+        checksum += pq.del_min();
+    operations += n;
+    double time = timer.elapsed_time();
+
+    // keep the drain from being optimized away
+    if (checksum != (long long) n * (n - 1) / 2) error("lost an index");
+    return { time, operations };
+}
+
+// best nanoseconds per operation of the queue called name over the repeats
+static double time(const std::string& name, const Workload& w, int range, int repeats)
+{
+    int n = w.keys.size();
+    double best = std::numeric_limits<double>::infinity();
+    for (int r = 0; r < repeats; r++)
+    {
+        std::pair<double, long long> result;
+        if (name == "binary")
+        {
+            IndexMinPQ<int> pq = IndexMinPQ<int>(n);
+            result = run(pq, w);
+        }
+        else if (name == "4-ary")
+        {
+            IndexMinPQ<int, std::less<int>, 4> pq = IndexMinPQ<int, std::less<int>, 4>(n);
+            result = run(pq, w);
+        }
+        else if (name == "radix")
+        {
+            RadixHeap<int> pq = RadixHeap<int>(n);
+            result = run(pq, w);
+        }
+        else
+        {
+            BucketQueue<int> pq = BucketQueue<int>(n, range);
+            result = run(pq, w);
+        }
+        best = std::min(best, result.first * 1e9 / result.second);
+    }
+    return best;
+}
+
+/**
+ *  Reads the options from the command line, times every chosen queue at
+ *  every size and range, and prints the results as CSV or JSON.
+ *
+ * @param args the command-line arguments
+ */
+int main(int argc, char** argv)
+{
+    int min = 1000, max = 256000, repeats = 3;
+    std::vector<int> ranges = { 10, 1000, 100000, 10000000 };
+    std::vector<std::string> queues = QUEUES;
+    bool json = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string option = argv[i];
+        if (i + 1 == argc)
+        {
+            StdOut::println("usage: algs4cpp-pq-bench [-n min] [-N max] [-c ranges] [-q queues] [-r repeats] [-f csv|json]");
+            return 1;
+        }
+        std::string value = argv[++i];
+        if      (option == "-n") min = std::stoi(value);
+        else if (option == "-N") max = std::stoi(value);
+        else if (option == "-q") queues = choose(value, QUEUES);
+        else if (option == "-r") repeats = std::stoi(value);
+        else if (option == "-f") json = choose(value, { "csv", "json" })[0] == "json";
+        else if (option == "-c")
+        {
+            ranges.clear();
+            for (const std::string& range : choose(value, {}))
+                ranges.push_back(std::stoi(range));
+        }
+        else error("unknown option: {}", option);
+    }
+    if (min < 1 || max < min || repeats < 1) error("sizes and repeats must be positive");
+    for (int range : ranges)
+        if (range < 1 || range > (1 << 30) / 8) error("range must be between 1 and 2^27: {}", range);
+
+    if (json) StdOut::println("[");
+    else      StdOut::println("queue,n,range,ns_per_operation");
+    bool first = true;
+    for (int range : ranges)
+    {
+        for (int n = min; n <= max; n *= 2)
+        {
+            // the same workload for every queue
+            StdRandom::set_seed(n);
+            Workload w = workload(n, range);
+            for (const std::string& name : queues)
+            {
+                double ns = time(name, w, range, repeats);
+                if (json)
+                {
+                    StdOut::printf("%s  {\"queue\": \"%s\", \"n\": %d, \"range\": %d, \"ns_per_operation\": %.2f}",
+                        first ? "" : ",\n", name.c_str(), n, range, ns);
+                }
+                else StdOut::printf("%s,%d,%d,%.2f\n", name.c_str(), n, range, ns);
+                first = false;
+            }
+        }
+    }
+    if (json) StdOut::println("\n]");
+}
@@ -0,0 +1,235 @@
+#include "Insertion.h"
+#include "Shell.h"
+#include "Merge.h"
+#include "MergeBU.h"
+#include "MergeX.h"
+#include "Quick.h"
+#include "Quick3way.h"
+#include "QuickX.h"
+#include "QuickBentleyMcIlroy.h"
+#include "Heap.h"
+#include "Counted.h"
+#include "Transaction.h"
+#include "Stopwatch.h"
+#include "StdRandom.h"
+#include "StdOut.h"
+#include "BenchOptions.h"
+
+/******************************************************************************
+ *  Execution:    algs4cpp-sort-bench [-n min] [-N max] [-s sorts] [-i inputs]
+ *                                    [-r repeats] [-q max] [-f csv|json]
+ *
+ *  Times every sort on every input distribution at sizes doubling from min
+ *  to max, and prints one record per run: the best time of the repeats in
+ *  nanoseconds per element, the numbers of compares, exchanges and other
+ *  element moves (counted on {@link Counted} keys), and the ratio of the
+ *  time to the time at half the size. Quadratic sorts skip sizes above the -q limit.
+ *  Build in Release: the assertions of Debug builds add compares.
+ *
+ *  Sorts:   insertion shell merge mergebu mergex quick quick3way quickx
+ *           quickbentleymcilroy heap
+ *  Inputs:  random sorted reversed few-unique zipf organ-pipe strings
+ *           transactions
+ *
+ *  % algs4cpp-sort-bench -n 100000 -N 200000 -s quick,heap -i random
+ *  sort,input,n,ns_per_element,compares,swaps,moves,doubling_ratio
+ *  quick,random,100000,162.75,2111213,493824,66612,
+ *  quick,random,200000,172.85,4597046,1028498,133140,2.124176
+ *  heap,random,100000,143.21,1699869,0,2089106,
+ *  heap,random,200000,151.94,3598883,0,4468630,2.121858
+ *
+ ******************************************************************************/
+
+static const std::vector<std::string> SORTS = {
+    "insertion", "shell", "merge", "mergebu", "mergex", "quick", "quick3way", "quickx", "quickbentleymcilroy", "heap"
+};
+
+static const std::vector<std::string> INPUTS = {
+    "random", "sorted", "reversed", "few-unique", "zipf", "organ-pipe", "strings", "transactions"
+};
+
+static const std::vector<std::string> NAMES = {
+    "Turing", "Knuth", "Hoare", "Dijkstra", "Tarjan", "Floyd", "Liskov", "Lovelace", "Hopper", "Sedgewick"
+};
+
+// sort a with the sort called name
+template <typename Key>
+static void sort(const std::string& name, std::vector<Key>& a)
+{
+    if      (name == "insertion")           Insertion<Key>::sort(a);
+    else if (name == "shell")               Shell<Key>::sort(a);
+    else if (name == "merge")               Merge<Key>::sort(a);
+    else if (name == "mergebu")             MergeBU<Key>::sort(a);
+    else if (name == "mergex")              MergeX<Key>::sort(a);
+    else if (name == "quick")               Quick<Key>::sort(a);
+    else if (name == "quick3way")           Quick3way<Key>::sort(a);
+    else if (name == "quickx")              QuickX<Key>::sort(a);
+    else if (name == "quickbentleymcilroy") QuickBentleyMcIlroy<Key>::sort(a);
+    else if (name == "heap")                Heap<Key>::sort(a);
+}
+
+// n integers in the given distribution
+static std::vector<int> integers(const std::string& input, int n)
+{
+    std::vector<int> a = std::vector<int>(n);
+    if (input == "zipf")
+    {
+        // value k with probability proportional to 1/k
+        std::vector<double> cumulative = std::vector<double>(n);
+        double sum = 0;
+        for (int k = 0; k < n; k++)
+            cumulative[k] = sum += 1.0 / (k + 1);
+        for (int i = 0; i < n; i++)
+            a[i] = std::lower_bound(cumulative.begin(), cumulative.end(), StdRandom::uniform_double() * sum) - cumulative.begin();
+        return a;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        if      (input == "sorted")     a[i] = i;
+        else if (input == "reversed")   a[i] = n - i;
+        else if (input == "few-unique") a[i] = StdRandom::uniform_int(16);
+        else if (input == "organ-pipe") a[i] = std::min(i, n - i);
+        else                            a[i] = StdRandom::uniform_int(std::numeric_limits<int>::max());
+    }
+    return a;
+}
+
+// n random strings of 8 to 16 lowercase letters
+static std::vector<std::string> strings(int n)
+{
+    std::vector<std::string> a = std::vector<std::string>(n);
+    for (int i = 0; i < n; i++)
+    {
+        int length = StdRandom::uniform_int(8, 17);
+        for (int c = 0; c < length; c++)
+            a[i] += (char) ('a' + StdRandom::uniform_int(26));
+    }
+    return a;
+}
+
+// n random transactions, ordered by amount
+static std::vector<Transaction> transactions(int n)
+{
+    std::vector<Transaction> a = std::vector<Transaction>(n);
+    for (int i = 0; i < n; i++)
+    {
+        Date when = Date(StdRandom::uniform_int(1, 13), StdRandom::uniform_int(1, 29), StdRandom::uniform_int(1990, 2030));
+        a[i] = Transaction(NAMES[StdRandom::uniform_int(NAMES.size())], when, StdRandom::uniform_int(100000) / 100.0);
+    }
+    return a;
+}
+
+// the record of one run, and the time to sort half as many keys
+struct Result
+{
+    std::string sort;
+    std::string input;
+    int n;
+    double ns_per_element;
+    long long compares;
+    long long swaps;
+    long long moves;
+    double ratio;       // 0 if not measured at half the size
+};
+
+// sort copies of the input repeats times for the best time, and once more as counted keys
+template <typename Key>
+static Result run(const std::string& name, const std::string& input, const std::vector<Key>& keys, int repeats)
+{
+    double best = std::numeric_limits<double>::infinity();
+    for (int r = 0; r < repeats; r++)
+    {
+        std::vector<Key> a = keys;
+        Stopwatch timer = Stopwatch();
+        sort(name, a);
+        best = std::min(best, timer.elapsed_time());
+    }
+
+    std::vector<Counted<Key>> counted = std::vector<Counted<Key>>(keys.begin(), keys.end());
+    Counted<Key>::reset();
+    sort(name, counted);
+    OperationCounts counts = Counted<Key>::counts();
+
+    int n = keys.size();
+    return Result { name, input, n, best * 1e9 / n, counts.compares, counts.swaps, counts.moves, 0 };
+}
+
+static void print(const std::vector<Result>& results, bool json)
+{
+    if (json) StdOut::println("[");
+    else      StdOut::println("sort,input,n,ns_per_element,compares,swaps,moves,doubling_ratio");
+    for (int i = 0; i < results.size(); i++)
+    {
+        const Result& r = results[i];
+        std::string ratio = r.ratio > 0 ? std::to_string(r.ratio) : (json ? "null" : "");
+        if (json)
+        {
+            StdOut::printf("  {\"sort\": \"%s\", \"input\": \"%s\", \"n\": %d, \"ns_per_element\": %.2f, "
+                "\"compares\": %lld, \"swaps\": %lld, \"moves\": %lld, \"doubling_ratio\": %s}%s\n",
+                r.sort.c_str(), r.input.c_str(), r.n, r.ns_per_element, r.compares, r.swaps, r.moves,
+                ratio.c_str(), i + 1 < results.size() ? "," : "");
+        }
+        else
+        {
+            StdOut::printf("%s,%s,%d,%.2f,%lld,%lld,%lld,%s\n",
+                r.sort.c_str(), r.input.c_str(), r.n, r.ns_per_element, r.compares, r.swaps, r.moves, ratio.c_str());
+        }
+    }
+    if (json) StdOut::println("]");
+}
+
+/**
+ *  Reads the options from the command line, times every chosen sort on every
+ *  chosen input at every size, and prints the results as CSV or JSON.
+ *
+ * @param args the command-line arguments
+ */
+int main(int argc, char** argv)
+{
+    int min = 1000, max = 64000, repeats = 3, quadratic = 64000;
+    std::vector<std::string> sorts = SORTS;
+    std::vector<std::string> inputs = INPUTS;
+    bool json = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string option = argv[i];
+        if (i + 1 == argc)
+        {
+            StdOut::println("usage: algs4cpp-sort-bench [-n min] [-N max] [-s sorts] [-i inputs] [-r repeats] [-q max] [-f csv|json]");
+            return 1;
+        }
+        std::string value = argv[++i];
+        if      (option == "-n") min = std::stoi(value);
+        else if (option == "-N") max = std::stoi(value);
+        else if (option == "-s") sorts = choose(value, SORTS);
+        else if (option == "-i") inputs = choose(value, INPUTS);
+        else if (option == "-r") repeats = std::stoi(value);
+        else if (option == "-q") quadratic = std::stoi(value);
+        else if (option == "-f") json = choose(value, { "csv", "json" })[0] == "json";
+        else error("unknown option: {}", option);
+    }
+    if (min < 1 || max < min || repeats < 1) error("sizes and repeats must be positive");
+
+    std::vector<Result> results = std::vector<Result>();
+    for (const std::string& name : sorts)
+    {
+        for (const std::string& input : inputs)
+        {
+            for (int n = min; n <= max && (name != "insertion" || n <= quadratic); n *= 2)
+            {
+                // the same keys for every sort
+                StdRandom::set_seed(n);
+                Result result;
+                if      (input == "strings")      result = run(name, input, strings(n), repeats);
+                else if (input == "transactions") result = run(name, input, transactions(n), repeats);
+                else                              result = run(name, input, integers(input, n), repeats);
+
+                if (n > min) result.ratio = (result.ns_per_element * n) / (results.back().ns_per_element * results.back().n);
+                results.push_back(result);
+            }
+        }
+    }
+    print(results, json);
+}
@@ -27,7 +27,8 @@
  *  The {@code TopM} class provides a client that reads a sequence of
  *  transactions from standard input and prints the <em>m</em> largest ones
  *  to standard output. This implementation uses a {@link MinPQ} of size
- *  at most <em>m</em> + 1 to identify the <em>M</em> largest transactions
+ *  at most <em>m</em> to identify the <em>M</em> largest transactions,
+ *  replacing its minimum with each larger transaction in a single sink,
  *  and a {@link Stack} to output them in the proper order.
  *  <p>
  *  For additional documentation, see <a href="https://algs4.cs.princeton.edu/24pq">Section 2.4</a>
@@ -49,7 +50,7 @@ int main(int argc, char** argv)
     if (argc < 3) return 1;
 
     int m = atoi(argv[1]);
-    MinPQ<Transaction> pq = MinPQ<Transaction>(m+1);
+    MinPQ<Transaction> pq = MinPQ<Transaction>(m);
 
     In file(argv[2]);
     std::vector<std::string> lines = file.read_all_lines();
@@ -57,11 +58,12 @@ int main(int argc, char** argv)
     {
         // Create an entry from the next line and put on the PQ.
         Transaction transaction = Transaction(line);
-        pq.insert(transaction);
+        if (pq.size() < m)
+            pq.insert(transaction);
 
-        // remove minimum if m+1 entries on the PQ
-        if (pq.size() > m)
-            pq.del_min();
+        // once m entries are on the PQ, a larger entry replaces the minimum
+        else if (m > 0 && pq.min() < transaction)
+            pq.replace_min(transaction);
     }   // top m entries are on the PQ
 
     // print entries on PQ in reverse order
@@ -0,0 +1,246 @@
+#include "MergeX.h"
+#include "QuickX.h"
+#include "QuickBentleyMcIlroy.h"
+#include "SortCutoffs.h"
+#include "SortingNetwork.h"
+#include "Stopwatch.h"
+#include "StdRandom.h"
+#include "StdOut.h"
+
+/******************************************************************************
+ *  Execution:    algs4cpp-tune-cutoffs [-n size] [-r rounds] [header]
+ *
+ *  Finds the fastest cutoffs of SortCutoffs on this machine, for each
+ *  category of key type: int keys stand for 4-byte keys, double keys for
+ *  8-byte keys and random strings for strings. Each cutoff is tuned on its
+ *  own, the others keeping their current values: merge on MergeX, insertion
+ *  on QuickX and median_of_3 on QuickBentleyMcIlroy. Every candidate sorts
+ *  the same random arrays of the given size, rounds times in turn with the
+ *  others, and keeps its best time.
+ *
+ *  The sorts hand small subarrays of int and double keys to SortingNetwork
+ *  where it is vectorized, whatever merge and insertion say, so those two
+ *  are not tuned for a category whose key goes to the network: they stay
+ *  the textbook's, for the other keys of the category.
+ *
+ *  Prints the times, and writes the cutoffs as SortCutoffsTuned.h to the
+ *  header file if one is given, as the tune-cutoffs target of the build does.
+ *  Build in Release: the assertions of Debug builds dwarf the differences.
+ *
+ *  % algs4cpp-tune-cutoffs build/generated/SortCutoffsTuned.h
+ *  category,cutoff,candidate,ns_per_element
+ *  ...
+ *  string,median_of_3,120,326.94
+ *  string,median_of_3,160,348.89
+ *  4-byte: { TEXTBOOK.merge, TEXTBOOK.insertion, 120 }
+ *  8-byte: { TEXTBOOK.merge, TEXTBOOK.insertion, 40 }
+ *  string: { 3, 4, 60 }
+ *
+ ******************************************************************************/
+
+// the candidates for each cutoff
+using MergeCandidates = std::integer_sequence<int, 3, 5, 7, 9, 11, 15, 19, 23, 31>;
+using InsertionCandidates = std::integer_sequence<int, 4, 6, 8, 10, 12, 16, 20, 24, 32>;
+using MedianOf3Candidates = std::integer_sequence<int, 10, 20, 30, 40, 60, 80, 120, 160>;
+
+static const int ARRAYS = 4;    // arrays sorted per timing
+
+// a key that sorts like Key, with the cutoffs given, so that each candidate is compiled as the sorts compile
+// keys that take the insertion sort path; probes never go to the sorting network
+template <typename Key, int Merge, int Insertion, int MedianOf3>
+struct Probe
+{
+    Key key;
+
+    bool operator<(const Probe& other) const
+    {
+        return key < other.key;
+    }
+
+    friend void swap(Probe& v, Probe& w)
+    {
+        using std::swap;
+        swap(v.key, w.key);
+    }
+};
+
+template <typename Key, int Merge, int Insertion, int MedianOf3>
+struct SortCutoffs::Of<Probe<Key, Merge, Insertion, MedianOf3>>
+{
+    static constexpr SortCutoffs::Cutoffs value = { Merge, Insertion, MedianOf3 };
+};
+
+enum class Cutoff { MERGE, INSERTION, MEDIAN_OF_3 };
+
+// the probe with cutoff C set to the candidate, and the others at the values the sorts use for Key:
+// the network's cutoff in place of merge and insertion if Key goes to the network
+template <typename Key, Cutoff C, int Candidate>
+using ProbeOf = Probe<Key,
+    C == Cutoff::MERGE ? Candidate : SortingNetwork::cutoff<Key, std::less<Key>>(SortCutoffs::of<Key>.merge),
+    C == Cutoff::INSERTION ? Candidate : SortingNetwork::cutoff<Key, std::less<Key>>(SortCutoffs::of<Key>.insertion),
+    C == Cutoff::MEDIAN_OF_3 ? Candidate : SortCutoffs::of<Key>.median_of_3>;
+
+// seconds to sort the arrays as probes with cutoff C at the candidate, by the sort that uses C
+template <typename Key, Cutoff C, int Candidate>
+static double time(const std::vector<std::vector<Key>>& arrays)
+{
+    using T = ProbeOf<Key, C, Candidate>;
+    std::vector<std::vector<T>> probes = std::vector<std::vector<T>>();
+    for (const std::vector<Key>& keys : arrays)
+    {
+        std::vector<T> a = std::vector<T>();
+        a.reserve(keys.size());
+        for (const Key& key : keys)
+            a.push_back(T { key });
+        probes.push_back(std::move(a));
+    }
+
+    Stopwatch timer = Stopwatch();
+    for (std::vector<T>& a : probes)
+    {
+        // block partitioning, as QuickX does for arithmetic keys
+        if constexpr (C == Cutoff::MERGE)
+            MergeX<T>::sort(a);
+        else if constexpr (C == Cutoff::INSERTION)
+            QuickX<T>::sort(a, std::is_arithmetic_v<Key> ? QuickX<T>::Partitioning::BLOCK : QuickX<T>::Partitioning::HOARE);
+        else
+            QuickBentleyMcIlroy<T>::sort(a);
+    }
+    return timer.elapsed_time();
+}
+
+// the candidate that sorts the arrays fastest, printing the time of each
+template <typename Key, Cutoff C, int... Candidates>
+static int tune(const std::string& category, const std::string& name, const std::vector<std::vector<Key>>& arrays, int rounds,
+    std::integer_sequence<int, Candidates...>)
+{
+    std::vector<int> candidates = { Candidates... };
+    std::vector<double> best = std::vector<double>(candidates.size(), std::numeric_limits<double>::infinity());
+
+    // rounds in turn, so that a slow moment of the machine does not favor any candidate
+    for (int r = 0; r < rounds; r++)
+    {
+        int i = 0;
+        ((best[i] = std::min(best[i], time<Key, C, Candidates>(arrays)), i++), ...);
+    }
+
+    long long n = (long long) ARRAYS * arrays[0].size();
+    int fastest = 0;
+    for (int i = 0; i < candidates.size(); i++)
+    {
+        StdOut::printf("%s,%s,%d,%.2f\n", category.c_str(), name.c_str(), candidates[i], best[i] * 1e9 / n);
+        if (best[i] < best[fastest]) fastest = i;
+    }
+    return candidates[fastest];
+}
+
+// the cutoffs tuned for a category, and the macro that sets them
+struct Tuned
+{
+    std::string macro;
+    SortCutoffs::Cutoffs cutoffs;
+    bool network;   // merge and insertion not tuned: the category's key goes to the sorting network
+};
+
+// the fastest cutoffs for random arrays of keys made by key()
+template <typename Key, typename F>
+static Tuned tune(const std::string& macro, const std::string& category, int n, int rounds, F key)
+{
+    std::vector<std::vector<Key>> arrays = std::vector<std::vector<Key>>(ARRAYS);
+    for (std::vector<Key>& a : arrays)
+        for (int i = 0; i < n; i++)
+            a.push_back(key());
+
+    Tuned tuned = { macro, SortCutoffs::TEXTBOOK, SortingNetwork::applies<Key, std::less<Key>> };
+    if (!tuned.network)
+    {
+        tuned.cutoffs.merge = tune<Key, Cutoff::MERGE>(category, "merge", arrays, rounds, MergeCandidates());
+        tuned.cutoffs.insertion = tune<Key, Cutoff::INSERTION>(category, "insertion", arrays, rounds, InsertionCandidates());
+    }
+    tuned.cutoffs.median_of_3 = tune<Key, Cutoff::MEDIAN_OF_3>(category, "median_of_3", arrays, rounds, MedianOf3Candidates());
+    return tuned;
+}
+
+// the initializer of the macro, which names the textbook's merge and insertion where they were not tuned
+static std::string to_string(const Tuned& tuned)
+{
+    std::string merge = tuned.network ? "TEXTBOOK.merge" : std::to_string(tuned.cutoffs.merge);
+    std::string insertion = tuned.network ? "TEXTBOOK.insertion" : std::to_string(tuned.cutoffs.insertion);
+    return "{ " + merge + ", " + insertion + ", " + std::to_string(tuned.cutoffs.median_of_3) + " }";
+}
+
+// write the cutoffs of each category as SortCutoffsTuned.h; definitions on the command line still win
+static void write(const std::string& file, const std::vector<Tuned>& tuned)
+{
+    std::ofstream out = std::ofstream(file);
+    if (!out) error("cannot write {}", file);
+
+    out << "// Generated by algs4cpp-tune-cutoffs for this machine: build the tune-cutoffs target to tune again.\n";
+    out << "// {merge, insertion, median of 3} for each category of key type; see SortCutoffs.h.\n\n";
+    out << "#ifndef SORTCUTOFFSTUNED_H\n#define SORTCUTOFFSTUNED_H\n";
+    for (const Tuned& t : tuned)
+    {
+        out << "\n#ifndef " << t.macro << "\n";
+        if (t.network) out << "// merge and insertion not tuned: these keys go to the sorting network\n";
+        out << "#define " << t.macro << " " << to_string(t) << "\n";
+        out << "#endif\n";
+    }
+    out << "\n#endif\n";
+}
+
+/**
+ *  Reads the options from the command line, tunes the cutoffs of every
+ *  category, prints them, and writes them to the header file if one is given.
+ *
+ * @param args the command-line arguments
+ */
+int main(int argc, char** argv)
+{
+    int n = 1 << 16, rounds = 5;
+    std::string header = "";
+    for (int i = 1; i < argc; i++)
+    {
+        std::string option = argv[i];
+        if      (option == "-n" && i + 1 < argc) n = std::stoi(argv[++i]);
+        else if (option == "-r" && i + 1 < argc) rounds = std::stoi(argv[++i]);
+        else if (option[0] != '-' && header.empty()) header = option;
+        else
+        {
+            StdOut::println("usage: algs4cpp-tune-cutoffs [-n size] [-r rounds] [header]");
+            return 1;
+        }
+    }
+    if (n < 2 || rounds < 1) error("size and rounds must be positive");
+
+#ifndef NDEBUG
+    StdOut::println("warning: tuning a Debug build, whose assertions dwarf the differences between cutoffs");
+#endif
+
+    // the same keys on every run
+    StdRandom::set_seed(n);
+    StdOut::println("category,cutoff,candidate,ns_per_element");
+    std::vector<Tuned> tuned = std::vector<Tuned>();
+    tuned.push_back(tune<int>("ALGS4CPP_CUTOFFS_4_BYTE", "4-byte", n, rounds, []
+    {
+        return StdRandom::uniform_int(std::numeric_limits<int>::max());
+    }));
+    tuned.push_back(tune<double>("ALGS4CPP_CUTOFFS_8_BYTE", "8-byte", n, rounds, []
+    {
+        return StdRandom::uniform_double();
+    }));
+
+    // strings cost more per key: a quarter as many
+    tuned.push_back(tune<std::string>("ALGS4CPP_CUTOFFS_STRING", "string", std::max(2, n / 4), rounds, []
+    {
+        std::string s = std::string();
+        int length = StdRandom::uniform_int(8, 17);
+        for (int c = 0; c < length; c++)
+            s += (char) ('a' + StdRandom::uniform_int(26));
+        return s;
+    }));
+
+    StdOut::println("4-byte: " + to_string(tuned[0]));
+    StdOut::println("8-byte: " + to_string(tuned[1]));
+    StdOut::println("string: " + to_string(tuned[2]));
+    if (!header.empty()) write(header, tuned);
+}
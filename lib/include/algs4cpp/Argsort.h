@@ -0,0 +1,206 @@
+#ifndef ARGSORT_H
+#define ARGSORT_H
+
+#include "LSD.h"
+#include "Parallel.h"
+#include "ParallelMerge.h"
+
+/**
+ *  The {@code Argsort} namespace computes sorting permutations: the
+ *  <em>argsort</em> of an array is the sequence of its indices in the order
+ *  of their elements, so that records stored as several parallel columns
+ *  can be sorted by one column, or by different keys in turn, without
+ *  moving the records until the end.
+ *  <p>
+ *  Every argsort is stable and parallel. Keys compared with a client
+ *  comparator sort the indices with the {@link ParallelMerge} engine, each
+ *  compare looking its two keys up. Keys that {@code LSD::radix_key()} maps to
+ *  unsigned integers, in their natural order, are radix sorted as
+ *  (key, index) pairs by {@code LSD::parallel_sort()} instead, which reads
+ *  every key once and never compares (so -0.0 sorts before 0.0).
+ *  {@code sort_by()} extracts each key once before either.
+ *  <p>
+ *  Indices are {@code uint32_t} unless another integral {@code Index} type is
+ *  given, which halves the memory of the permutation on 64-bit targets.
+ *  {@code gather()} and {@code apply()} then rearrange any number of columns
+ *  by the permutation, in parallel.
+ *  <p>
+ *  {@code Merge::index_sort()} is the serial, natural-order special case.
+ */
+namespace Argsort
+{
+    const int GRAIN = 1 << 16;     // elements per task of the linear passes
+
+    // calls f(lo, hi) for blocks [lo, hi) covering [0, n), in parallel
+    template <typename F>
+    void for_blocks(int n, F f)
+    {
+        Parallel::for_blocks(0, n, f, GRAIN);
+    }
+
+    // the identity permutation of n indices
+    template <typename Index>
+    std::vector<Index> identity(size_t n)
+    {
+        static_assert(std::is_integral_v<Index>, "indices are integers");
+        if (n > (size_t) std::numeric_limits<int>::max() || (n > 0 && n - 1 > (size_t) std::numeric_limits<Index>::max()))
+            error("{} elements do not fit the index type", n);
+
+        std::vector<Index> index = std::vector<Index>(n);
+        for_blocks(n, [&index](int lo, int hi)
+        {
+            for (int i = lo; i < hi; i++)
+                index[i] = (Index) i;
+        });
+        return index;
+    }
+
+    // can keys of type Key in the order given by Less be radix sorted?
+    // (only the exact key types of radix_key(): strings would convert to dates)
+    template <typename Key, typename Less>
+    constexpr bool radix_sortable = ((std::is_arithmetic_v<Key> && !std::is_same_v<Key, bool>) || std::is_same_v<Key, Date>)
+        && (std::is_same_v<Less, std::less<Key>> || std::is_same_v<Less, std::less<>>);
+
+    /**
+     * Returns the permutation {@code p[]} that stably orders the keys by {@code less}:
+     * {@code keys[p[0]]}, {@code keys[p[1]]}, ..., {@code keys[p[n-1]]} are in order,
+     * and equal keys keep the order of their indices.
+     *
+     * @param keys the keys
+     * @param less the strict weak ordering (a functor, lambda or function)
+     * @return the sorting permutation
+     */
+    template <typename Index = uint32_t, typename Key, typename Less>
+    std::vector<Index> sort(const std::vector<Key>& keys, Less less)
+    {
+        int n = keys.size();
+        std::vector<Index> index = identity<Index>(n);
+        if (n < 2) return index;
+
+        if constexpr (radix_sortable<Key, Less>)
+        {
+            using Radix = decltype(LSD::radix_key(keys[0]));
+            std::vector<std::pair<Radix, Index>> items = std::vector<std::pair<Radix, Index>>(n);
+            for_blocks(n, [&keys, &items](int lo, int hi)
+            {
+                for (int i = lo; i < hi; i++)
+                    items[i] = std::make_pair(LSD::radix_key(keys[i]), (Index) i);
+            });
+
+            std::vector<std::pair<Radix, Index>> aux = std::vector<std::pair<Radix, Index>>(n);
+            LSD::parallel_sort(items, aux, [](const std::pair<Radix, Index>& item) { return item.first; });
+
+            for_blocks(n, [&index, &items](int lo, int hi)
+            {
+                for (int i = lo; i < hi; i++)
+                    index[i] = items[i].second;
+            });
+        }
+        else
+        {
+            // indices start in order and the mergesort is stable
+            ParallelMerge::sort(index, [&keys, less](Index i, Index j) { return less(keys[i], keys[j]); });
+        }
+        return index;
+    }
+
+    /**
+     * Returns the permutation that stably orders the keys in their natural order.
+     *
+     * @param keys the keys
+     * @return the sorting permutation
+     */
+    template <typename Index = uint32_t, typename Key>
+    std::vector<Index> sort(const std::vector<Key>& keys)
+    {
+        return sort<Index>(keys, std::less<Key>());
+    }
+
+    /**
+     * Returns the permutation that stably orders the records by the keys
+     * {@code key(a[i])}, compared by {@code less}. Each key is extracted once.
+     * <p>
+     * For example, {@code Argsort::sort_by(transactions, [](const Transaction& t) { return t.amount(); })}.
+     *
+     * @param a the records
+     * @param key the function that extracts the key of a record
+     * @param less the strict weak ordering of the keys; their natural order by default
+     * @return the sorting permutation
+     */
+    template <typename Index = uint32_t, typename T, typename KeyOf, typename Less = std::less<>>
+    std::vector<Index> sort_by(const std::vector<T>& a, KeyOf key, Less less = Less())
+    {
+        using Key = std::decay_t<decltype(key(a[0]))>;
+        int n = a.size();
+
+        // vector<bool> packs its elements, so blocks of it cannot be written concurrently
+        std::vector<Key> keys = std::vector<Key>(n);
+        if constexpr (std::is_same_v<Key, bool>)
+        {
+            for (int i = 0; i < n; i++)
+                keys[i] = key(a[i]);
+        }
+        else
+        {
+            for_blocks(n, [&a, &keys, &key](int lo, int hi)
+            {
+                for (int i = lo; i < hi; i++)
+                    keys[i] = key(a[i]);
+            });
+        }
+
+        // the natural order of the key type is the radix order
+        if constexpr (std::is_same_v<Less, std::less<>>) return sort<Index>(keys, std::less<Key>());
+        else                                             return sort<Index>(keys, less);
+    }
+
+    /**
+     * Returns the column rearranged by the permutation:
+     * element {@code k} of the result is {@code column[index[k]]}.
+     *
+     * @param column the column
+     * @param index the permutation, as returned by {@code sort()}
+     * @return the rearranged column
+     * @throws IllegalArgumentException if the column and the permutation differ in length
+     */
+    template <typename T, typename Index>
+    std::vector<T> gather(const std::vector<T>& column, const std::vector<Index>& index)
+    {
+        if (column.size() != index.size()) error("column and permutation lengths disagree");
+
+        // vector<bool> packs its elements, so blocks of it cannot be written concurrently
+        std::vector<T> result = std::vector<T>(column.size());
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            for (size_t k = 0; k < index.size(); k++)
+                result[k] = column[index[k]];
+        }
+        else
+        {
+            for_blocks(index.size(), [&column, &index, &result](int lo, int hi)
+            {
+                for (int k = lo; k < hi; k++)
+                    result[k] = column[index[k]];
+            });
+        }
+        return result;
+    }
+
+    /**
+     * Rearranges every column by the permutation, in place:
+     * element {@code k} of each column becomes its old element {@code index[k]}.
+     * <p>
+     * For example, {@code Argsort::apply(Argsort::sort(scores), names, scores, ids)}.
+     *
+     * @param index the permutation, as returned by {@code sort()}
+     * @param columns the columns to rearrange, all as long as the permutation
+     * @throws IllegalArgumentException if a column and the permutation differ in length
+     */
+    template <typename Index, typename... Columns>
+    void apply(const std::vector<Index>& index, Columns&... columns)
+    {
+        ((columns = gather(columns, index)), ...);
+    }
+}
+
+#endif
@@ -460,7 +460,7 @@ private:
     // Precondition: rank is in legal range.
     Key select(TreeNode<Key, Value>* x, int rank) const
     {
-        if (x == nullptr) return nullptr;
+        assert(x != nullptr);
         int left_size = size(x->left.get());
         if      (left_size > rank) return select(x->left.get(), rank);
         else if (left_size < rank) return select(x->right.get(), rank - left_size - 1);
@@ -50,7 +50,7 @@
  *  @author Robert Sedgewick
  *  @author Kevin Wayne
  */
-template <typename T>
+template <typename T, typename Compare = std::less<T>>
 class BinaryInsertion
 {
 public:
@@ -59,27 +59,48 @@ public:
      * @param a the array to be sorted
      */
     static void sort(std::vector<T>& a)
+    {
+        sort(a, Compare());
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator.
+     * @param a the array to be sorted
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void sort(std::vector<T>& a, Less cmp)
     {
         int n = a.size();
         for (int i = 1; i < n; i++)
         {
             // binary search to determine index j at which to insert a[i]
-            T v = a[i];
+            T v = std::move(a[i]);
             int lo = 0, hi = i;
             while (lo < hi)
             {
                 int mid = lo + (hi - lo) / 2;
-                if (less(v, a[mid])) hi = mid;
-                else                 lo = mid + 1;
+                if (less(v, a[mid], cmp)) hi = mid;
+                else                      lo = mid + 1;
             }
 
             // insertion sort with "half exchanges"
             // (insert a[i] at index j and shift a[j], ..., a[i-1] to right)
             for (int j = i; j > lo; --j)
-                a[j] = a[j-1];
-            a[lo] = v;
+                a[j] = std::move(a[j-1]);
+            a[lo] = std::move(v);
         }
-        assert(is_sorted(a));
+        assert(is_sorted(a, 0, n - 1, cmp));
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator.
+     * @param a the array to be sorted
+     * @param comparator the comparator specifying the order
+     */
+    static void sort(std::vector<T>& a, cmp_func)
+    {
+        sort<bool(*)(T, T)>(a, cmp);
     }
     
     /***************************************************************************
@@ -93,9 +114,7 @@ public:
     // is the array sorted from a[lo] to a[hi]
     static bool is_sorted(std::vector<T>& a, int lo, int hi)
     {
-        for (int i = lo + 1; i <= hi; i++)
-            if (less(a[i], a[i-1])) return false;
-        return true;
+        return is_sorted(a, lo, hi, Compare());
     }
 
     // print array to standard output
@@ -114,9 +133,19 @@ private:
     ***************************************************************************/
 
     // is v < w ?
-    static bool less(T v, T w)
+    template <typename Less>
+    static bool less(const T& v, const T& w, Less cmp)
+    {
+        return cmp(v, w); 
+    }
+
+    // is the array sorted from a[lo] to a[hi]
+    template <typename Less>
+    static bool is_sorted(std::vector<T>& a, int lo, int hi, Less cmp)
     {
-        return v < w; 
+        for (int i = lo + 1; i <= hi; i++)
+            if (less(a[i], a[i-1], cmp)) return false;
+        return true;
     }
 };
 
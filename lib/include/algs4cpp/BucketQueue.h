@@ -0,0 +1,306 @@
+#ifndef BUCKETQUEUE_H
+#define BUCKETQUEUE_H
+
+/**
+ *  The {@code BucketQueue} class represents a monotone indexed priority
+ *  queue of integer keys within a bounded range of each other: the keys
+ *  inserted, or decreased to, are never less than the last minimum removed,
+ *  nor more than {@code range} above it, as the tentative distances of
+ *  Dijkstra's algorithm with integer edge weights of at most {@code range}.
+ *  It supports the <em>insert</em>, <em>delete-the-minimum</em>,
+ *  <em>decrease-key</em> and <em>delete</em> operations of
+ *  {@link IndexMinPQ}, with an integer between {@code 0} and
+ *  {@code maxN - 1} associated with each key.
+ *  <p>
+ *  This implementation uses Dial's <em>bucket queue</em>: a circular array
+ *  of {@code range + 1} buckets, one per key in the window from the last
+ *  minimum, each a doubly linked list of the indices with that key, threaded
+ *  through arrays indexed by the indices. The <em>insert</em>,
+ *  <em>decrease-key</em> and <em>delete</em> operations take &Theta;(1)
+ *  time, with no compares. <em>delete-the-minimum</em> scans forward to the
+ *  next bucket with keys, which takes &Theta;(1) amortized time for each
+ *  key removed plus &Theta;(<em>C</em>) time over a sequence of operations
+ *  whose minimum grows by <em>C</em>. Construction takes time proportional
+ *  to the specified capacity plus the range.
+ *  <p>
+ *  When the queue is empty, the window moves up to start at a larger key
+ *  inserted beyond it, as the source of Dijkstra's algorithm. Finding the
+ *  minimum moves the window to it, so {@code min_index()} and
+ *  {@code min_key()} are not {@code const}, and a key peeked at counts as
+ *  removed: the keys inserted afterwards must be at least that key.
+ *
+ *  @param <Key> the integral type of key on this priority queue
+ */
+template <typename Key = int>
+class BucketQueue
+{
+public:
+    /**
+     * Initializes an empty bucket queue with indices between {@code 0}
+     * and {@code max_n - 1}, for keys at most {@code range} above the minimum,
+     * and at first from {@code start} to {@code start + range}.
+     *
+     * @param  max_n the keys on this priority queue are index from {@code 0} to {@code max_n - 1}
+     * @param  range the largest difference between a key and the last minimum
+     * @param  start the least key, until a minimum is removed; 0 by default
+     * @throws IllegalArgumentException if {@code max_n < 0}, or unless
+     *         {@code 0 <= range < INT_MAX}
+     */
+    BucketQueue(int max_n, Key range, Key start = 0)
+    {
+        static_assert(std::is_integral_v<Key>, "a bucket queue orders integral keys");
+        if (max_n < 0) error("illegal argument exception");
+        if (range < 0 || (unsigned long long) range >= INT_MAX) error("illegal range: {}", range);
+        m_max_n = max_n;
+        m_n = 0;
+        m_range = range;
+        m_keys = std::vector<Key>(m_max_n);
+        m_next = std::vector<int>(m_max_n);
+        m_prev = std::vector<int>(m_max_n);
+        m_contains = std::vector<bool>(m_max_n);
+        m_head = std::vector<int>(range + 1, -1);
+        m_last = start;
+    }
+
+    /**
+     * Returns true if this priority queue is empty.
+     *
+     * @return {@code true} if this priority queue is empty;
+     *         {@code false} otherwise
+     */
+    bool is_empty() const
+    {
+        return m_n == 0;
+    }
+
+    /**
+     * Is {@code i} an index on this priority queue?
+     *
+     * @param  i an index
+     * @return {@code true} if {@code i} is an index on this priority queue;
+     *         {@code false} otherwise
+     * @throws IllegalArgumentException unless {@code 0 <= i < m_max_n}
+     */
+    bool contains(int i) const
+    {
+        validate_index(i);
+        return m_contains[i];
+    }
+
+    /**
+     * Returns the number of keys on this priority queue.
+     *
+     * @return the number of keys on this priority queue
+     */
+    int size() const
+    {
+        return m_n;
+    }
+
+    /**
+     * Associate key with index i.
+     *
+     * @param  i an index
+     * @param  key the key to associate with index {@code i}
+     * @throws IllegalArgumentException unless {@code 0 <= i < m_max_n}
+     * @throws IllegalArgumentException if there already is an item
+     *         associated with index {@code i}
+     * @throws IllegalArgumentException if {@code key} is less than the last
+     *         minimum, or more than {@code range} above it
+     */
+    void insert(int i, Key key)
+    {
+        validate_index(i);
+        if (m_contains[i]) error("index is already in the priority queue");
+
+        // an empty queue moves its window up to start at a larger key
+        if (is_empty() && key > m_last && distance(key) > Bits(m_range)) m_last = key;
+        validate_key(key);
+        m_keys[i] = key;
+        link(i);
+        m_n++;
+    }
+
+    /**
+     * Associates the key with index {@code i} if {@code i} is not on this
+     * priority queue, or decreases the key of {@code i} to it if it is smaller;
+     * does nothing otherwise.
+     *
+     * @param  i an index
+     * @param  key the new key of index {@code i}, if smaller
+     * @return {@code true} if the key was inserted or decreased;
+     *         {@code false} if {@code i} already had a key at most {@code key}
+     * @throws IllegalArgumentException unless {@code 0 <= i < m_max_n}
+     * @throws IllegalArgumentException if {@code key} is less than the last
+     *         minimum, or more than {@code range} above it
+     */
+    bool push_or_decrease(int i, Key key)
+    {
+        validate_index(i);
+        if (!m_contains[i])
+        {
+            insert(i, key);
+            return true;
+        }
+        if (key >= m_keys[i]) return false;
+        validate_key(key);
+        unlink(i);
+        m_keys[i] = key;
+        link(i);
+        return true;
+    }
+
+    /**
+     * Returns an index associated with a minimum key.
+     *
+     * @return an index associated with a minimum key
+     * @throws NoSuchElementException if this priority queue is empty
+     */
+    int min_index()
+    {
+        if (is_empty()) error("Priority queue underflow");
+        while (m_head[bucket(m_last)] == -1)
+            m_last++;
+        return m_head[bucket(m_last)];
+    }
+
+    /**
+     * Returns a minimum key.
+     *
+     * @return a minimum key
+     * @throws NoSuchElementException if this priority queue is empty
+     */
+    Key min_key()
+    {
+        return m_keys[min_index()];
+    }
+
+    /**
+     * Removes a minimum key and returns its associated index.
+     *
+     * @return an index associated with a minimum key
+     * @throws NoSuchElementException if this priority queue is empty
+     */
+    int del_min()
+    {
+        int min = min_index();
+        unlink(min);
+        m_n--;
+        return min;
+    }
+
+    /**
+     * Returns the key associated with index {@code i}.
+     *
+     * @param  i the index of the key to return
+     * @return the key associated with index {@code i}
+     * @throws IllegalArgumentException unless {@code 0 <= i < m_max_n}
+     * @throws NoSuchElementException no key is associated with index {@code i}
+     */
+    Key key_of(int i) const
+    {
+        validate_index(i);
+        if (!m_contains[i]) error("index is not in the priority queue");
+        return m_keys[i];
+    }
+
+    /**
+     * Decrease the key associated with index {@code i} to the specified value.
+     *
+     * @param  i the index of the key to decrease
+     * @param  key decrease the key associated with index {@code i} to this key
+     * @throws IllegalArgumentException unless {@code 0 <= i < m_max_n}
+     * @throws IllegalArgumentException if {@code key >= keyOf(i)}
+     * @throws IllegalArgumentException if {@code key} is less than the last minimum
+     * @throws NoSuchElementException no key is associated with index {@code i}
+     */
+    void decrease_key(int i, Key key)
+    {
+        validate_index(i);
+        if (!m_contains[i]) error("index is not in the priority queue");
+        if (m_keys[i] == key)
+            error("Calling decrease_key() with a key equal to the key in the priority queue");
+        if (m_keys[i] < key)
+            error("Calling decrease_key() with a key that is strictly greater than the key in the priority queue");
+        validate_key(key);
+        unlink(i);
+        m_keys[i] = key;
+        link(i);
+    }
+
+    /**
+     * Remove the key on the priority queue associated with index {@code i}.
+     *
+     * @param  i the index of the key to remove
+     * @throws IllegalArgumentException unless {@code 0 <= i < m_max_n}
+     * @throws NoSuchElementException no key is associated with index {@code i}
+     */
+    void delete_key(int i)
+    {
+        validate_index(i);
+        if (!m_contains[i]) error("index is not in the priority queue");
+        unlink(i);
+        m_n--;
+    }
+
+private:
+    using Bits = std::make_unsigned_t<Key>;
+    static constexpr Bits SIGN = std::is_signed_v<Key> ? Bits(1) << (std::numeric_limits<Bits>::digits - 1) : 0;
+
+    int m_max_n;                    // maximum number of elements on PQ
+    int m_n;                        // number of elements on PQ
+    Key m_range;                    // largest difference between a key and the last minimum
+    std::vector<Key> m_keys;        // keys[i] = priority of i
+    std::vector<int> m_next;        // next index in the bucket of i, or -1
+    std::vector<int> m_prev;        // previous index in the bucket of i, or -1
+    std::vector<bool> m_contains;   // is i on PQ?
+    std::vector<int> m_head;        // first index in each bucket, or -1
+    Key m_last;                     // the last minimum
+
+    // key - last, without overflow; key is at least last
+    Bits distance(Key key) const
+    {
+        return Bits(key) - Bits(m_last);
+    }
+
+    // the bucket of a key in the window, from the key as an unsigned integer in the same order
+    int bucket(Key key) const
+    {
+        return (Bits(key) ^ SIGN) % Bits(m_head.size());
+    }
+
+    // throw an IllegalArgumentException if i is an invalid index
+    void validate_index(int i) const
+    {
+        if (i < 0) error("index is negative: {}", i);
+        if (i >= m_max_n) error("index >= capacity: {}", i);
+    }
+
+    // throw an IllegalArgumentException if the key is outside the window
+    void validate_key(Key key) const
+    {
+        if (key < m_last) error("key is less than the last minimum: {}", key);
+        if (distance(key) > Bits(m_range)) error("key is more than the range above the last minimum: {}", key);
+    }
+
+    // push i at the front of the bucket of its key
+    void link(int i)
+    {
+        int b = bucket(m_keys[i]);
+        m_prev[i] = -1;
+        m_next[i] = m_head[b];
+        if (m_head[b] != -1) m_prev[m_head[b]] = i;
+        m_head[b] = i;
+        m_contains[i] = true;
+    }
+
+    void unlink(int i)
+    {
+        if (m_prev[i] != -1) m_next[m_prev[i]] = m_next[i];
+        else                 m_head[bucket(m_keys[i])] = m_next[i];
+        if (m_next[i] != -1) m_prev[m_next[i]] = m_prev[i];
+        m_contains[i] = false;
+    }
+};
+
+#endif
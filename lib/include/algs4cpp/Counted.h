@@ -0,0 +1,184 @@
+#ifndef COUNTED_H
+#define COUNTED_H
+
+#include <atomic>
+#include "SortCutoffs.h"
+
+/**
+ *  The {@code OperationCounts} struct holds the operations counted on the keys
+ *  of one {@link Counted} type.
+ */
+struct OperationCounts
+{
+    long long compares = 0;     // calls of <, >, <=, >=, == and !=: the compares of a sort or priority queue, the probes of a symbol table
+    long long swaps = 0;        // exchanges of two keys, or of handles to two keys reported through count_swap()
+    long long moves = 0;        // copies and moves of a key outside of swaps
+};
+
+/**
+ *  The {@code Counted} class wraps a key and counts the operations that
+ *  algorithms perform on it, to tell more compares from worse memory behaviour.
+ *  <p>
+ *  Instrumentation is opt-in and decided at compile time: sort a
+ *  {@code std::vector<Counted<double>>} instead of a {@code std::vector<double>},
+ *  or key a priority queue or symbol table on {@code Counted<std::string>},
+ *  and read the counts afterwards. Code that does not use the wrapper pays
+ *  nothing. The sorts exchange keys with an unqualified {@code swap()}; code
+ *  that exchanges handles to keys instead can report its exchanges through
+ *  {@code count_swap()}, which does nothing for other keys. The priority
+ *  queues move keys into a hole rather than exchange them.
+ *  <p>
+ *  The counts are kept per key type, and are exact under the parallel sorts.
+ *  For example,
+ *  <pre>
+ *      Counted<double>::reset();
+ *      Quick<Counted<double>>::sort(a);
+ *      OperationCounts counts = Counted<double>::counts();
+ *  </pre>
+ *  The wrapper is not an arithmetic type, so the sorts do not use their
+ *  special cases for primitive keys (sorting networks, block partitioning).
+ */
+template <typename Key>
+class Counted
+{
+public:
+    Counted() = default;
+
+    /**
+     * Wraps the key.
+     *
+     * @param key the key
+     */
+    Counted(const Key& key) : m_key(key)
+    {
+    }
+
+    Counted(const Counted& other) : m_key(other.m_key)
+    {
+        m_moves.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Counted(Counted&& other) : m_key(std::move(other.m_key))
+    {
+        m_moves.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Counted& operator=(const Counted& other)
+    {
+        m_key = other.m_key;
+        m_moves.fetch_add(1, std::memory_order_relaxed);
+        return *this;
+    }
+
+    Counted& operator=(Counted&& other)
+    {
+        m_key = std::move(other.m_key);
+        m_moves.fetch_add(1, std::memory_order_relaxed);
+        return *this;
+    }
+
+    /**
+     * Returns the wrapped key, without counting.
+     *
+     * @return the key
+     */
+    const Key& key() const
+    {
+        return m_key;
+    }
+
+    /**
+     * Returns the operations counted on keys of this type since the last reset.
+     *
+     * @return the counts
+     */
+    static OperationCounts counts()
+    {
+        OperationCounts counts;
+        counts.compares = m_compares.load(std::memory_order_relaxed);
+        counts.swaps = m_swaps.load(std::memory_order_relaxed);
+        counts.moves = m_moves.load(std::memory_order_relaxed);
+        return counts;
+    }
+
+    /**
+     * Sets the counts of this key type to zero.
+     */
+    static void reset()
+    {
+        m_compares.store(0, std::memory_order_relaxed);
+        m_swaps.store(0, std::memory_order_relaxed);
+        m_moves.store(0, std::memory_order_relaxed);
+    }
+
+    // counts an exchange that the caller made without swapping keys
+    static void count_swap()
+    {
+        m_swaps.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool operator<(const Counted& other) const  { return compared(m_key < other.m_key); }
+    bool operator>(const Counted& other) const  { return compared(m_key > other.m_key); }
+    bool operator<=(const Counted& other) const { return compared(m_key <= other.m_key); }
+    bool operator>=(const Counted& other) const { return compared(m_key >= other.m_key); }
+    bool operator==(const Counted& other) const { return compared(m_key == other.m_key); }
+    bool operator!=(const Counted& other) const { return compared(m_key != other.m_key); }
+
+    friend void swap(Counted& v, Counted& w)
+    {
+        std::swap(v.m_key, w.m_key);
+        count_swap();
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const Counted& v)
+    {
+        return os << v.m_key;
+    }
+
+private:
+    Key m_key;
+
+    inline static std::atomic<long long> m_compares = 0;
+    inline static std::atomic<long long> m_swaps = 0;
+    inline static std::atomic<long long> m_moves = 0;
+
+    static bool compared(bool result)
+    {
+        m_compares.fetch_add(1, std::memory_order_relaxed);
+        return result;
+    }
+};
+
+// hashes the wrapped key, so that hash tables can be keyed on counted keys
+template <typename Key>
+struct std::hash<Counted<Key>>
+{
+    size_t operator()(const Counted<Key>& v) const
+    {
+        return std::hash<Key>{}(v.key());
+    }
+};
+
+// counted keys sort with the cutoffs of the keys they wrap
+template <typename Key>
+struct SortCutoffs::Of<Counted<Key>> : SortCutoffs::Of<Key>
+{
+};
+
+template <typename T>
+constexpr bool is_counted = false;
+
+template <typename Key>
+constexpr bool is_counted<Counted<Key>> = true;
+
+/**
+ * Counts an exchange of two keys of type {@code T} made by swapping their
+ * handles, if {@code T} is a {@link Counted} key; compiles to nothing otherwise.
+ */
+template <typename T>
+void count_swap()
+{
+    if constexpr (is_counted<T>) T::count_swap();
+}
+
+#endif
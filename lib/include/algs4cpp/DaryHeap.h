@@ -0,0 +1,122 @@
+#ifndef DARYHEAP_H
+#define DARYHEAP_H
+
+/**
+ *  The {@code DaryHeap} namespace provides the sink shared by {@link Heap}
+ *  and the priority queues {@link MinPQ}, {@link MaxPQ}, {@link IndexMinPQ}
+ *  and {@link IndexMaxPQ}, over a <em>D</em>-ary heap in an array whose
+ *  node <em>k</em> has children <em>D k</em> + 1 through <em>D k</em> + <em>D</em>.
+ *  <p>
+ *  The sink is the one of bottom-up heapsort: the key that belongs on top
+ *  of each group of children moves up into the hole all the way down to a
+ *  leaf, and the sinking key then sifts back up the short distance to its
+ *  place, one compare per child instead of one more per level. The compares
+ *  that choose the path cannot be predicted, so the groups a few levels
+ *  below are prefetched while the current group is compared.
+ *  <p>
+ *  The order is given by {@code below(v, w)}, true if {@code v} belongs
+ *  below {@code w}: {@code less} for the max heap of heapsort and
+ *  {@link MaxPQ}, {@code greater} for {@link MinPQ}. Keys are put in the
+ *  heap by {@code place(k, x)}, so that an indexed heap can record where
+ *  each key goes.
+ */
+namespace DaryHeap
+{
+    /**
+     * Returns the number of levels below a group of children to prefetch: as
+     * many as span at most two cache lines. If the groups are not aligned to
+     * cache lines, none once a group fills half a line, when most of the lines
+     * fetched would be off the path.
+     */
+    template <typename T, int D, bool ALIGNED>
+    constexpr int prefetch_levels()
+    {
+        if (!ALIGNED && D * sizeof(T) >= 32) return 0;
+        int levels = 1;
+        for (size_t span = D * D * sizeof(T); span <= 128; span *= D)
+            levels++;
+        return levels;
+    }
+
+    template <typename T>
+    inline void prefetch(const T* p)
+    {
+#if defined(__GNUC__)
+        __builtin_prefetch(p);
+#endif
+    }
+
+    /**
+     * Puts x in the hole at a[k] of the heap a[0 .. n-1]: moves the child
+     * that belongs on top up into the hole all the way down to a leaf, then
+     * sifts x up from there, no higher than k. {@code ALIGNED} tells that
+     * every group of children starts a block of D keys aligned to its size.
+     *
+     * @param a the heap
+     * @param k the index of the hole
+     * @param n the number of keys in the heap
+     * @param x the key to put in the hole
+     * @param below {@code below(v, w)} is true if {@code v} belongs below {@code w}
+     * @param place {@code place(i, std::move(v))} puts {@code v} at {@code a[i]}
+     */
+    template <int D, bool ALIGNED = false, typename T, typename Below, typename Place>
+    inline void sink(T* a, int k, int n, T x, Below below, Place place)
+    {
+        static_assert(D >= 2, "a heap node has at least two children");
+        int top = k;
+        while (true)
+        {
+            int first = D * k + 1;
+            if (first >= n) break;
+            int last = std::min(first + D, n);
+
+            // the compares below cannot be predicted, so fetch the next few levels of the path now;
+            // the descendants are counted in long long, as they overflow an int in a large heap
+            if constexpr (prefetch_levels<T, D, ALIGNED>() > 0)
+            {
+                long long lo = first, hi = last;
+                for (int t = 0; t < prefetch_levels<T, D, ALIGNED>(); t++)
+                {
+                    lo = D * lo + 1;
+                    hi = D * hi + 1;
+                }
+                int end = (int) std::min<long long>(hi, n);
+                for (long long g = lo; g < end; g += std::max<size_t>(1, 64 / sizeof(T)))
+                    prefetch(a + g);
+            }
+
+            int j = first;
+            for (int c = first + 1; c < last; c++)
+                if (below(a[j], a[c])) j = c;
+            place(k, std::move(a[j]));
+            k = j;
+        }
+
+        while (k > top)
+        {
+            int parent = (k - 1) / D;
+            if (!below(a[parent], x)) break;
+            place(k, std::move(a[parent]));
+            k = parent;
+        }
+        place(k, std::move(x));
+    }
+
+    /**
+     * Puts x in the hole at a[k] of the heap a[0 .. n-1], as above, moving
+     * each key straight into its place.
+     *
+     * @param a the heap
+     * @param k the index of the hole
+     * @param n the number of keys in the heap
+     * @param x the key to put in the hole
+     * @param below {@code below(v, w)} is true if {@code v} belongs below {@code w}
+     */
+    template <int D, bool ALIGNED = false, typename T, typename Below>
+    inline void sink(T* a, int k, int n, T x, Below below)
+    {
+        sink<D, ALIGNED>(a, k, n, std::move(x), below, [a](int i, T&& v) { a[i] = std::move(v); });
+    }
+}
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef EXTERNALSORT_H
+#define EXTERNALSORT_H
+
+#include <filesystem>
+
+/**
+ *  The {@code ExternalSort} class sorts files that do not fit in memory.
+ *  <p>
+ *  The input is read in chunks that fit in the memory budget. Each chunk is
+ *  sorted in parallel and written to a temporary file as a sorted
+ *  <em>run</em>. The runs are then merged, at most {@code fan_in} at a time,
+ *  by a multiway merge through an {@link IndexMinPQ}, as in {@code Multiway}.
+ *  When there are more runs than the fan-in, runs are merged into longer
+ *  runs in extra passes. Every run being merged is read through its own
+ *  buffer, and the buffers together stay within the memory budget.
+ *  <p>
+ *  Lines are sorted by their bytes ({@link Merge#parallel_sort}), and each
+ *  output line ends with a newline. Integers are signed 64-bit decimal
+ *  numbers separated by whitespace ({@link LSD#parallel_sort}). They are
+ *  kept in binary in the runs and written one per line.
+ *  <p>
+ *  With a budget of <em>M</em> bytes, each run holds about <em>M</em>/2 bytes
+ *  of lines or 3<em>M</em>/64 integers, and sorting takes
+ *  1 + log<sub><em>k</em></sub>(runs) passes over the data for a fan-in of
+ *  <em>k</em>: 50 GB of text with a 3 GB budget is about 34 runs, merged in a
+ *  single pass with the default fan-in of 64. The runs need as much temporary
+ *  disk space as the input (8 bytes per integer), and are removed when the
+ *  sort is done. A line longer than the budget is read in one piece anyway.
+ *  <p>
+ *  A sort that fails throws rather than exiting, after removing its runs:
+ *  {@code std::invalid_argument} for bad input, {@code std::runtime_error}
+ *  if a file cannot be read or written.
+ */
+class ExternalSort
+{
+public:
+    /**
+     * Initializes an external sort that holds at most about {@code memory}
+     * bytes of data and merges at most {@code fan_in} runs at a time.
+     *
+     * @param memory the memory budget in bytes, at least 64 KiB
+     * @param fan_in the number of runs merged at a time, at least 2
+     * @param temp_dir the directory for the runs; the system temporary directory if empty
+     * @throws IllegalArgumentException if {@code memory} or {@code fan_in} is too small
+     */
+    ExternalSort(long long memory = 1LL << 30, int fan_in = 64, std::string temp_dir = "");
+
+    /**
+     * Sorts the lines of {@code input} into {@code output}.
+     *
+     * @param input the file to sort
+     * @param output the file to write; may not be {@code input}
+     * @throws std::invalid_argument if {@code input} does not exist or is {@code output}
+     * @throws std::runtime_error if a file cannot be read or written
+     */
+    void sort_lines(const std::string& input, const std::string& output);
+
+    /**
+     * Sorts the whitespace-separated integers of {@code input} into
+     * {@code output}, one per line.
+     *
+     * @param input the file to sort
+     * @param output the file to write; may not be {@code input}
+     * @throws std::invalid_argument if {@code input} does not exist or is {@code output},
+     *         or if a token is not a 64-bit integer
+     * @throws std::runtime_error if a file cannot be read or written
+     */
+    void sort_integers(const std::string& input, const std::string& output);
+
+    /**
+     * Returns the number of sorted runs the last sort produced.
+     *
+     * @return the number of runs written before merging
+     */
+    int runs() const;
+
+    /**
+     * Returns the number of merge passes the last sort made, the final one included.
+     *
+     * @return the number of merge passes
+     */
+    int merge_passes() const;
+
+private:
+    long long m_memory;                 // bytes of data held at a time
+    int m_fan_in;                       // runs merged at a time
+    std::filesystem::path m_temp_dir;   // where the runs go
+    int m_runs;                         // runs written by the last sort
+    int m_merge_passes;                 // merge passes made by the last sort
+    int m_next_run;                     // number of the next run file
+
+    enum class Format { LINES, INTEGERS };
+
+    void sort(const std::string& input, const std::string& output, Format format);
+
+    // the path of a new run file in dir
+    std::filesystem::path next_run(const std::filesystem::path& dir);
+
+    // write the sorted runs of input into dir and return their paths
+    std::vector<std::filesystem::path> make_line_runs(const std::string& input, const std::filesystem::path& dir);
+    std::vector<std::filesystem::path> make_integer_runs(const std::string& input, const std::filesystem::path& dir);
+
+    // merge the runs, fan_in at a time, until one merge writes the output
+    void merge_runs(std::vector<std::filesystem::path> runs, const std::string& output,
+        const std::filesystem::path& dir, Format format);
+
+    // merge the runs into output; integers are written as text if final
+    void merge(const std::vector<std::filesystem::path>& runs, const std::filesystem::path& output,
+        Format format, bool final);
+};
+
+#endif
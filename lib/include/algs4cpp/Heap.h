@@ -1,6 +1,7 @@
 #ifndef HEAP_H
 #define HEAP_H
 
+#include "DaryHeap.h"
 #include "Heap.h"
 #include "StdOut.h"
 
@@ -33,8 +34,21 @@
  *  <p>
  *  This implementation takes &Theta;(<em>n</em> log <em>n</em>) time
  *  to sort any array of length <em>n</em> (assuming comparisons
- *  take constant time). It makes at most
- *  2 <em>n</em> log<sub>2</sub> <em>n</em> compares.
+ *  take constant time).
+ *  <p>
+ *  It is a <em>bottom-up</em> heapsort: a key sinks by moving the larger
+ *  child up into the hole all the way to a leaf, and then sifting back up
+ *  the short distance to its place. A sink costs one compare per level,
+ *  not two, so the sort makes about <em>n</em> log<sub>2</sub> <em>n</em>
+ *  compares instead of 2 <em>n</em> log<sub>2</sub> <em>n</em>.
+ *  <p>
+ *  The heap is <em>D</em>-ary, binary by default: {@code sort<4>()} or
+ *  {@code sort<8>()} make the heap two or three times shallower, and each
+ *  level reads one group of sibling keys. The root is placed so that every
+ *  group starts at a multiple of its own size (a cache line for 8 doubles),
+ *  and the at most <em>D</em> - 1 keys before the root are merged with the
+ *  sorted keys at the end, which moves each key at most once more. Heaps
+ *  that fit in a page are not worth aligning, and start at their first key.
  *  <p>
  *  This sorting algorithm is not stable.
  *  It uses &Theta;(1) extra memory (not including the input array).
@@ -46,7 +60,7 @@
  *  @author Robert Sedgewick
  *  @author Kevin Wayne
  */
-template <typename T>
+template <typename T, typename Compare = std::less<T>>
 class Heap
 {
 public:
@@ -54,20 +68,80 @@ public:
      * Rearranges the array in ascending order, using the natural order.
      * @param pq the array to be sorted
      */
+    template <int D = 2>
     static void sort(std::vector<T>& pq)
     {
-        int n = pq.size();
+        sort<D>(pq, Compare());
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator.
+     * @param pq the array to be sorted
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <int D = 2, typename Less>
+    static void sort(std::vector<T>& pq, Less cmp)
+    {
+        sort<D>(pq, 0, pq.size() - 1, cmp);
+    }
+
+    /**
+     * Rearranges the subarray a[lo .. hi] in ascending order, using the natural order.
+     * @param a the array
+     * @param lo the index of the first key to sort
+     * @param hi the index of the last key to sort
+     */
+    template <int D = 2>
+    static void sort(std::vector<T>& a, int lo, int hi)
+    {
+        sort<D>(a, lo, hi, Compare());
+    }
+
+    /**
+     * Rearranges the subarray a[lo .. hi] in ascending order, using a comparator.
+     * The introsorts fall back on it for subarrays that quicksort partitions badly.
+     * @param a the array
+     * @param lo the index of the first key to sort
+     * @param hi the index of the last key to sort
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <int D = 2, typename Less>
+    static void sort(std::vector<T>& a, int lo, int hi, Less cmp)
+    {
+        static_assert(D >= 2, "a heap node has at least two children");
+        int n = hi - lo + 1;
+        if (n < 2) return;
+
+        // the heap starts at the root offset, the keys before it wait
+        T* base = a.data() + lo;
+        int r = std::min(root_offset<D>(base, n), n - 1);
+        T* pq = base + r;
+        int m = n - r;
 
         // heapify phase
-        for (int k = n/2; k >= 1; k--)
-            sink(pq, k, n);
+        for (int k = (m - 2) / D; k >= 0; k--)
+            DaryHeap::sink<D, true>(pq, k, m, std::move(pq[k]), cmp);
 
         // sortdown phase
-        int k = n;
-        while (k > 1)
+        for (int k = m - 1; k > 0; k--)
+        {
+            T v = std::move(pq[k]);
+            pq[k] = std::move(pq[0]);
+            DaryHeap::sink<D, true>(pq, 0, k, std::move(v), cmp);
+        }
+
+        // sort the waiting keys aside and merge them with the sorted keys from the front,
+        // which stops as soon as the largest waiting key is placed
+        if (r == 0) return;
+        std::vector<T> waiting = std::vector<T>(std::make_move_iterator(base), std::make_move_iterator(base + r));
+        std::sort(waiting.begin(), waiting.end(), cmp);
+        T* out = base;
+        T* next = base + r;
+        for (T& v : waiting)
         {
-            exch(pq, 1, k--);
-            sink(pq, 1, k);
+            while (next < base + n && cmp(*next, v))
+                *out++ = std::move(*next++);
+            *out++ = std::move(v);
         }
     }
 
@@ -82,35 +156,21 @@ public:
 
 private:
    /***************************************************************************
-    * Helper functions to restore the heap invariant.
-    ***************************************************************************/
-
-    static void sink(std::vector<T>& pq, int k, int n)
-    {
-        while (2 * k <= n)
-        {
-            int j = 2 * k;
-            if (j < n && less(pq, j, j+1)) j++;
-            if (!less(pq, k, j)) break;
-            exch(pq, k, j);
-            k = j;
-        }
-    }
-
-   /***************************************************************************
-    * Helper functions for comparisons and swaps.
-    * Indices are "off-by-one" to support 1-based indexing.
+    * Heap layout. The sinks are those of DaryHeap.
+    * Indices are 0-based: the children of node k are D*k + 1 through D*k + D.
     ***************************************************************************/
-    static bool less(std::vector<T>& pq, int i, int j)
-    {
-        return pq[i-1] < pq[j-1];
-    }
 
-    static void exch(std::vector<T>& pq, int i, int j)
+    // the index at which to put the root of a heap of n keys so that every group of D siblings
+    // starts a block of D keys aligned to its size, if that is a power of two and the heap outgrows a page
+    template <int D>
+    static int root_offset(const T* a, int n)
     {
-        T swap = pq[i-1];
-        pq[i-1] = pq[j-1];
-        pq[j-1] = swap;
+        size_t group = D * sizeof(T);
+        uintptr_t address = (uintptr_t) a;
+        if ((group & (group - 1)) != 0 || address % sizeof(T) != 0) return 0;
+        if ((size_t) n * sizeof(T) <= 4096) return 0;
+        int aligned = (group - address % group) % group / sizeof(T);
+        return (aligned + D - 1) % D;
     }
 };
 
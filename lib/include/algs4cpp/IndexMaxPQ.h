@@ -1,12 +1,14 @@
 #ifndef INDEXMAXPQ_H
 #define INDEXMAXPQ_H
 
+#include "DaryHeap.h"
+
 /******************************************************************************
  *  Compilation:  javac IndexMaxPQ.java
  *  Execution:    java IndexMaxPQ
  *  Dependencies: StdOut.java
  *
- *  Maximum-oriented indexed PQ implementation using a binary heap.
+ *  Maximum-oriented indexed PQ implementation using a d-ary heap.
  *
  ******************************************************************************/
 
@@ -14,22 +16,32 @@
  *  The {@code IndexMaxPQ} class represents an indexed priority queue of generic keys.
  *  It supports the usual <em>insert</em> and <em>delete-the-maximum</em>
  *  operations, along with <em>delete</em> and <em>change-the-key</em>
- *  methods. In order to let the client refer to items on the priority queue,
- *  an integer between {@code 0} and {@code m_max_n - 1}
- *  is associated with each key—the client
- *  uses this integer to specify which key to delete or change.
+ *  methods. In order to let the client refer to keys on the priority queue,
+ *  an integer between {@code 0} and {@code maxN - 1}
+ *  is associated with each key—the client uses this integer to specify
+ *  which key to delete or change.
  *  It also supports methods for peeking at a maximum key,
  *  testing if the priority queue is empty, and iterating through
  *  the keys.
  *  <p>
- *  This implementation uses a <em>binary heap</em> along with an
- *  array to associate keys with integers in the given range.
+ *  This implementation uses a <em>d-ary heap</em>, binary by default,
+ *  along with an array to associate keys with integers in the given range.
  *  The <em>insert</em>, <em>delete-the-maximum</em>, <em>delete</em>,
  *  <em>change-key</em>, <em>decrease-key</em>, and <em>increase-key</em>
  *  operations take &Theta;(log <em>n</em>) time in the worst case,
  *  where <em>n</em> is the number of elements in the priority queue.
  *  Construction takes time proportional to the specified capacity.
  *  <p>
+ *  Each node of the heap holds its key together with its index, by value,
+ *  so the compares of a swim or a sink read the heap array alone, and a
+ *  change of key allocates nothing. The only other array maps each index to
+ *  its node, and is written once per level a node moves. Nodes are moved
+ *  into a hole rather than exchanged. With a branching factor {@code D}
+ *  of 4 the heap is half as deep: an <em>increase-key</em> swims half as
+ *  many levels, while a <em>delete-the-maximum</em> compares four children
+ *  per level. {@code push_or_increase()} inserts an index or raises its key
+ *  with a single check of the index.
+ *  <p>
  *  For additional documentation, see
  *  <a href="https://algs4.cs.princeton.edu/24pq">Section 2.4</a> of
  *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
@@ -38,21 +50,18 @@
  *  @author Kevin Wayne
  *
  *  @param <Key> the generic type of key on this priority queue
+ *  @param <Compare> the type of the functor ordering the keys, {@code std::less<Key>} by default
+ *  @param <D> the number of children of a node, 2 by default
  */
-template <typename Key>
+template <typename Key, typename Compare = std::less<Key>, int D = 2>
 class IndexMaxPQ
 {
 public:
     /**
      * Default Constructor
      */
-    IndexMaxPQ()
+    IndexMaxPQ() : IndexMaxPQ(0)
     {
-        m_max_n = 0;
-        m_n = 0;
-        m_keys = std::vector<ptr<Key>>();
-        m_pq   = std::vector<int>();
-        m_qp   = std::vector<int>();
     }
 
     /**
@@ -64,40 +73,25 @@ public:
      */
     IndexMaxPQ(int max_n)
     {
+        static_assert(D >= 2, "a heap node has at least two children");
         if (max_n < 0) error("illegal argument exception");
         m_max_n = max_n;
-        m_n = 0;
-        m_keys = std::vector<ptr<Key>>(m_max_n + 1);    // make this of length m_max_n??
-        m_pq   = std::vector<int>(m_max_n + 1);
-        m_qp   = std::vector<int>(m_max_n + 1, -1);     // make this of length m_max_n??
+        m_pq = std::vector<Node>();
+        m_pq.reserve(m_max_n);
+        m_qp = std::vector<int>(m_max_n, -1);
     }
-    
-    /**
-     * Copy constructor.
-     * 
-     * @param other the IndexMaxPQ to copy from
-     */
-    IndexMaxPQ(const IndexMaxPQ<Key>& other) : 
-        m_n(other.m_n), m_max_n(other.m_max_n), m_pq(other.m_pq), m_qp(other.m_qp)
-    {
-        m_keys = std::vector<ptr<Key>>();
-        copy_ptrs<Key>(m_keys, other.m_keys);
-    }
-        
+
     /**
-     * Assigment operator.
-     * 
-     * @param other the IndexMaxPQ to assign from
+     * Initializes an empty indexed priority queue with indices between {@code 0}
+     * and {@code m_max_n - 1}, ordering the keys with the given functor.
+     *
+     * @param  max_n the keys on this priority queue are index from {@code 0} to {@code max_n - 1}
+     * @param  compare the functor ordering the keys
+     * @throws IllegalArgumentException if {@code max_n < 0}
      */
-    IndexMaxPQ& operator=(const IndexMaxPQ<Key>& other)
+    IndexMaxPQ(int max_n, Compare compare) : IndexMaxPQ(max_n)
     {
-        m_n = other.m_n;
-        m_max_n = other.m_max_n;
-        m_pq = other.m_pq;
-        m_qp = other.m_qp;
-        m_keys = std::vector<ptr<Key>>();
-        copy_ptrs<Key>(m_keys, other.m_keys);
-        return *this;
+        m_compare = compare;
     }
 
     /**
@@ -108,7 +102,7 @@ public:
      */
     bool is_empty() const
     {
-        return m_n == 0;
+        return m_pq.empty();
     }
 
     /**
@@ -132,7 +126,7 @@ public:
      */
     int size() const
     {
-        return m_n;
+        return m_pq.size();
     }
 
    /**
@@ -147,12 +141,34 @@ public:
     void insert(int i, Key key)
     {
         validate_index(i);
-        if (contains(i)) error("index is already in the priority queue");
-        m_n++;
-        m_qp[i] = m_n;
-        m_pq[m_n] = i;
-        m_keys[i] = alloc<Key>(key);
-        swim(m_n);
+        if (m_qp[i] != -1) error("index is already in the priority queue");
+        push(i, std::move(key));
+    }
+
+    /**
+     * Associates the key with index {@code i} if {@code i} is not on this
+     * priority queue, or increases the key of {@code i} to it if it is larger;
+     * does nothing otherwise. Checks the index once, instead of
+     * {@code contains()} followed by {@code insert()} or {@code increase_key()}.
+     *
+     * @param  i an index
+     * @param  key the new key of index {@code i}, if larger
+     * @return {@code true} if the key was inserted or increased;
+     *         {@code false} if {@code i} already had a key at least {@code key}
+     * @throws IllegalArgumentException unless {@code 0 <= i < m_max_n}
+     */
+    bool push_or_increase(int i, Key key)
+    {
+        validate_index(i);
+        int k = m_qp[i];
+        if (k == -1)
+        {
+            push(i, std::move(key));
+            return true;
+        }
+        if (!less(m_pq[k].key, key)) return false;
+        swim(k, Node { std::move(key), i });
+        return true;
     }
 
     /**
@@ -163,8 +179,8 @@ public:
      */
     int max_index() const
     {
-        if (m_n == 0) error("Priority queue underflow");
-        return m_pq[1];
+        if (is_empty()) error("Priority queue underflow");
+        return m_pq[0].index;
     }
 
     /**
@@ -173,10 +189,10 @@ public:
      * @return a maximum key
      * @throws NoSuchElementException if this priority queue is empty
      */
-    Key max_key() const
+    const Key& max_key() const
     {
-        if (m_n == 0) error("Priority queue underflow");
-        return *(m_keys[m_pq[1]]);
+        if (is_empty()) error("Priority queue underflow");
+        return m_pq[0].key;
     }
 
     /**
@@ -187,15 +203,9 @@ public:
      */
     int del_max()
     {
-        if (m_n == 0) error("Priority queue underflow");
-        int max = m_pq[1];
-        exch(1, m_n--);
-        sink(1);
-
-        assert(m_pq[m_n+1] == max);
-        m_qp[max] = -1;             // delete
-        m_keys[max] = nullptr;      // to help with garbage collection
-        m_pq[m_n+1] = -1;           // not needed
+        if (is_empty()) error("Priority queue underflow");
+        int max = m_pq[0].index;
+        remove(0);
         return max;
     }
 
@@ -207,15 +217,11 @@ public:
      * @throws IllegalArgumentException unless {@code 0 <= i < m_max_n}
      * @throws NoSuchElementException no key is associated with index {@code i}
      */
-    Key key_of(int i) const
+    const Key& key_of(int i) const
     {
         validate_index(i);
-        if (!contains(i))
-        {
-            error("index is not in the priority queue");
-            return nullptr;
-        }
-        else return *(m_keys[i]);
+        if (m_qp[i] == -1) error("index is not in the priority queue");
+        return m_pq[m_qp[i]].key;
     }
 
     /**
@@ -228,10 +234,10 @@ public:
     void change_key(int i, Key key)
     {
         validate_index(i);
-        if (!contains(i)) error("index is not in the priority queue");
-        m_keys[i] = alloc<Key>(key);
-        swim(m_qp[i]);
-        sink(m_qp[i]);
+        int k = m_qp[i];
+        if (k == -1) error("index is not in the priority queue");
+        if (less(m_pq[k].key, key)) swim(k, Node { std::move(key), i });
+        else                        sink(k, Node { std::move(key), i });
     }
 
     /**
@@ -245,14 +251,14 @@ public:
      */
     void increase_key(int i, Key key)
     {
-        validate_index(i); if (!contains(i)) error("index is not in the priority queue");
-        if (*(m_keys[i]) == key)
+        validate_index(i);
+        int k = m_qp[i];
+        if (k == -1) error("index is not in the priority queue");
+        if (!less(m_pq[k].key, key) && !less(key, m_pq[k].key))
             error("Calling increaseKey() with a key equal to the key in the priority queue");
-        if (*(m_keys[i]) > key)
+        if (less(key, m_pq[k].key))
             error("Calling increaseKey() with a key that is strictly less than the key in the priority queue");
-
-        m_keys[i] = alloc<Key>(key);
-        swim(m_qp[i]);
+        swim(k, Node { std::move(key), i });
     }
 
     /**
@@ -267,13 +273,13 @@ public:
     void decrease_key(int i, Key key)
     {
         validate_index(i);
-        if (!contains(i)) error("index is not in the priority queue");
-        if (*(m_keys[i]) == key)
+        int k = m_qp[i];
+        if (k == -1) error("index is not in the priority queue");
+        if (!less(m_pq[k].key, key) && !less(key, m_pq[k].key))
             error("Calling decrease_key() with a key equal to the key in the priority queue");
-        if (*(m_keys[i]) < key)
+        if (less(m_pq[k].key, key))
             error("Calling decrease_key() with a key that is strictly greater than the key in the priority queue");
-        m_keys[i] = alloc<Key>(key);
-        sink(m_qp[i]);
+        sink(k, Node { std::move(key), i });
     }
 
     /**
@@ -286,21 +292,22 @@ public:
     void delete_key(int i)
     {
         validate_index(i);
-        if (!contains(i)) error("index is not in the priority queue");
-        int index = m_qp[i];
-        exch(index, m_n--);
-        swim(index);
-        sink(index);
-        m_keys[i] = nullptr;
-        m_qp[i] = -1;
+        if (m_qp[i] == -1) error("index is not in the priority queue");
+        remove(m_qp[i]);
     }
 
 private:
-    int m_max_n;                    // maximum number of elements on PQ
-    int m_n;                        // number of elements on PQ
-    std::vector<int> m_pq;          // binary heap using 1-based indexing
-    std::vector<int> m_qp;          // inverse of pq - qp[pq[i]] = pq[qp[i]] = i
-    std::vector<ptr<Key>> m_keys;   // keys[i] = priority of i
+    // a key and its index, side by side in the heap
+    struct Node
+    {
+        Key key;
+        int index;
+    };
+
+    int m_max_n;                // maximum number of elements on PQ
+    std::vector<Node> m_pq;     // d-ary heap using 0-based indexing
+    std::vector<int> m_qp;      // position of each index in pq: pq[qp[i]].index = i, or -1
+    Compare m_compare;          // order of the keys
 
     // throw an IllegalArgumentException if i is an invalid index
     void validate_index(int i) const
@@ -312,44 +319,65 @@ private:
    /***************************************************************************
     * General helper functions.
     ***************************************************************************/
-    bool less(int i, int j) const
+    bool less(const Key& v, const Key& w) const
     {
-        return *(m_keys[m_pq[i]]) < *(m_keys[m_pq[j]]);
+        return m_compare(v, w);
     }
 
-    void exch(int i, int j)
+    // put node x at position k of the heap
+    void place(int k, Node&& x)
     {
-        std::swap(m_pq[i], m_pq[j]);
-        m_qp[m_pq[i]] = i;
-        m_qp[m_pq[j]] = j;
+        m_qp[x.index] = k;
+        m_pq[k] = std::move(x);
+    }
+
+    // add index i with its key at the bottom of the heap, then swim it up
+    void push(int i, Key&& key)
+    {
+        m_pq.push_back(Node { std::move(key), i });
+        int k = size() - 1;
+        swim(k, std::move(m_pq[k]));
+    }
+
+    // remove the node at position k, filling its hole with the last node
+    void remove(int k)
+    {
+        m_qp[m_pq[k].index] = -1;
+        Node last = std::move(m_pq.back());
+        m_pq.pop_back();
+        if (k == size()) return;
+        if (k > 0 && less(m_pq[(k - 1) / D].key, last.key)) swim(k, std::move(last));
+        else                                                  sink(k, std::move(last));
     }
 
 
    /***************************************************************************
     * Heap helper functions.
+    * The children of node k are D*k + 1 through D*k + D.
     ***************************************************************************/
-    void swim(int k)
+
+    // put x in the hole at k, moving each smaller parent down into the hole
+    void swim(int k, Node x)
     {
-        while (k > 1 && less(k/2, k))
+        while (k > 0)
         {
-            exch(k, k/2);
-            k = k/2;
+            int parent = (k - 1) / D;
+            if (!less(m_pq[parent].key, x.key)) break;
+            place(k, std::move(m_pq[parent]));
+            k = parent;
         }
+        place(k, std::move(x));
     }
 
-    void sink(int k)
+    // put x in the hole at k: move the largest child up into the hole all
+    // the way down to a leaf, then sift x up from there
+    void sink(int k, Node x)
     {
-        while (2*k <= m_n)
-        {
-            int j = 2*k;
-            if (j < m_n && less(j, j+1)) j++;
-            if (!less(k, j)) break;
-            exch(k, j);
-            k = j;
-        }
+        DaryHeap::sink<D>(m_pq.data(), k, size(), std::move(x),
+            [this](const Node& v, const Node& w) { return less(v.key, w.key); },
+            [this](int i, Node&& v) { place(i, std::move(v)); });
     }
 
-
     /***************************************************************************
     * Iterator.
     ***************************************************************************/
@@ -361,10 +389,10 @@ private:
         using pointer           = int*;  // or also value_type*
         using reference         = int&;  // or also value_type&
 
-        HeapIterator(IndexMaxPQ<Key>& max_pq)
+        HeapIterator(IndexMaxPQ& max_pq)
         {
             m_copy = max_pq;
-            m_ptr = &m_copy.m_pq[1];
+            m_ptr = m_copy.is_empty() ? nullptr : &m_copy.m_pq[0].index;
         }
 
         HeapIterator(pointer ptr) : m_ptr(ptr) {}
@@ -381,7 +409,7 @@ private:
             if (m_copy.is_empty())
                 m_ptr = nullptr;
             else
-                m_ptr = &m_copy.m_pq[1];
+                m_ptr = &m_copy.m_pq[0].index;
 
             return *this;
         }  
@@ -406,16 +434,16 @@ private:
         
     private:
         pointer m_ptr;
-        IndexMaxPQ<Key> m_copy;
+        IndexMaxPQ m_copy;
     };
     
 public:
-    HeapIterator begin() 
+    HeapIterator begin()
     {
         return HeapIterator(*this);
     }
 
-    HeapIterator end() const
+    HeapIterator end()
     {
         return HeapIterator(nullptr);
     }
@@ -49,7 +49,7 @@
  *  @author Kevin Wayne
  */
 
-template <typename T>
+template <typename T, typename Compare = std::less<T>>
 class Insertion
 {
 public:
@@ -59,16 +59,7 @@ public:
      */
     static void sort(std::vector<T>& a)
     {
-        int n = a.size();
-        for (int i = 1; i < n; i++)
-        {
-            for (int j = i; j > 0 && less(a[j], a[j-1]); j--)
-            {
-                exch(a, j, j-1);
-            }
-            assert(is_sorted(a, 0, i));
-        }
-        assert(is_sorted(a));
+        sort(a, Compare());
     }
 
     /**
@@ -79,22 +70,16 @@ public:
      */
     static void sort(std::vector<T>& a, int lo, int hi)
     {
-        for (int i = lo + 1; i < hi; i++)
-        {
-            for (int j = i; j > lo && less(a[j], a[j-1]); j--)
-            {
-                exch(a, j, j-1);
-            }
-        }
-        assert(is_sorted(a, lo, hi));
+        sort(a, lo, hi, Compare());
     }
 
     /**
      * Rearranges the array in ascending order, using a comparator.
      * @param a the array
-     * @param comparator the comparator specifying the order
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
      */
-    static void sort(std::vector<T>& a, cmp_func)
+    template <typename Less>
+    static void sort(std::vector<T>& a, Less cmp)
     {
         int n = a.size();
         for (int i = 1; i < n; i++)
@@ -113,9 +98,10 @@ public:
      * @param a the array
      * @param lo left endpoint (inclusive)
      * @param hi right endpoint (exclusive)
-     * @param comparator the comparator specifying the order
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
      */
-    static void sort(std::vector<T>& a, int lo, int hi, cmp_func)
+    template <typename Less>
+    static void sort(std::vector<T>& a, int lo, int hi, Less cmp)
     {
         for (int i = lo + 1; i < hi; i++)
         {
@@ -127,6 +113,28 @@ public:
         assert(is_sorted(a, lo, hi, cmp));
     }
 
+    /**
+     * Rearranges the array in ascending order, using a comparator.
+     * @param a the array
+     * @param comparator the comparator specifying the order
+     */
+    static void sort(std::vector<T>& a, cmp_func)
+    {
+        sort<bool(*)(T, T)>(a, cmp);
+    }
+
+    /**
+     * Rearranges the subarray a[lo..hi) in ascending order, using a comparator.
+     * @param a the array
+     * @param lo left endpoint (inclusive)
+     * @param hi right endpoint (exclusive)
+     * @param comparator the comparator specifying the order
+     */
+    static void sort(std::vector<T>& a, int lo, int hi, cmp_func)
+    {
+        sort<bool(*)(T, T)>(a, lo, hi, cmp);
+    }
+
     // return a permutation that gives the elements in a[] in ascending order
     // do not change the original array a[]
     /**
@@ -135,7 +143,7 @@ public:
      * @return a permutation {@code p[]} such that {@code a[p[0]]}, {@code a[p[1]]},
      *    ..., {@code a[p[n-1]]} are in ascending order
      */
-    static std::vector<int> index_sort(std::vector<T> a)
+    static std::vector<int> index_sort(const std::vector<T>& a)
     {
         int n = a.size();
         std::vector<int> index = std::vector<int>(n);
@@ -143,8 +151,8 @@ public:
             index[i] = i;
 
         for (int i = 1; i < n; i++)
-            for (int j = i; j > 0 && less(a[index[j]], a[index[j-1]]); j--)
-                exch(index, j, j-1);
+            for (int j = i; j > 0 && less(a[index[j]], a[index[j-1]], Compare()); j--)
+                std::swap(index[j], index[j-1]);
 
         return index;
     }
@@ -164,49 +172,32 @@ private:
     ***************************************************************************/
 
     // is v < w ?
-    static bool less(T v, T w)
+    template <typename Less>
+    static bool less(const T& v, const T& w, Less cmp)
     {
-        return v < w;
-    }
-
-    // is v < w ?
-    static bool less(T v, T w, cmp_func)
-    {
-        return (*cmp)(v, w);
+        return cmp(v, w);
     }
 
     // exchange a[i] and a[j]
     static void exch(std::vector<T>& a, int i, int j)
     {
-        T swap = a[i];
-        a[i] = a[j];
-        a[j] = swap;
+        using std::swap;
+        swap(a[i], a[j]);
     }
 
     /***************************************************************************
     *  Check if array is sorted - useful for debugging.
     ***************************************************************************/
 
-    static bool is_sorted(std::vector<T>& a)
-    {
-        return is_sorted(a, 0, a.size());
-    }
-
-    // is the array a[lo..hi) sorted
-    static bool is_sorted(std::vector<T>& a, int lo, int hi)
-    {
-        for (int i = lo + 1; i < hi; i++)
-            if (less(a[i], a[i-1])) return false;
-        return true;
-    }
-
-    static bool is_sorted(std::vector<T>& a, cmp_func)
+    template <typename Less>
+    static bool is_sorted(std::vector<T>& a, Less cmp)
     {
         return is_sorted(a, 0, a.size(), cmp);
     }
     
     // is the array a[lo..hi) sorted
-    static bool is_sorted(std::vector<T>& a, int lo, int hi, cmp_func)
+    template <typename Less>
+    static bool is_sorted(std::vector<T>& a, int lo, int hi, Less cmp)
     {
         for (int i = lo + 1; i < hi; i++)
             if (less(a[i], a[i-1], cmp)) return false;
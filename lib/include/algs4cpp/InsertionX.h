@@ -48,7 +48,7 @@
  *  @author Robert Sedgewick
  *  @author Kevin Wayne
  */
-template <typename T>
+template <typename T, typename Compare = std::less<T>>
 class InsertionX
 {
 public:
@@ -57,6 +57,17 @@ public:
      * @param a the array to be sorted
      */
     static void sort(std::vector<T>& a)
+    {
+        sort(a, Compare());
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator.
+     * @param a the array to be sorted
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void sort(std::vector<T>& a, Less cmp)
     {
         int n = a.size();
 
@@ -64,7 +75,7 @@ public:
         int exchanges = 0;
         for (int i = n-1; i > 0; i--)
         {
-            if (less(a[i], a[i-1]))
+            if (less(a[i], a[i-1], cmp))
             {
                 exch(a, i, i - 1);
                 exchanges++;
@@ -76,17 +87,27 @@ public:
         // insertion sort with half-exchanges
         for (int i = 2; i < n; i++)
         {
-            T v = a[i];
+            T v = std::move(a[i]);
             int j = i;
-            while (less(v, a[j-1]))
+            while (less(v, a[j-1], cmp))
             {
-                a[j] = a[j-1];
+                a[j] = std::move(a[j-1]);
                 j--;
             }
-            a[j] = v;
+            a[j] = std::move(v);
         }
 
-        assert(is_sorted(a));
+        assert(is_sorted(a, cmp));
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator.
+     * @param a the array to be sorted
+     * @param comparator the comparator specifying the order
+     */
+    static void sort(std::vector<T>& a, cmp_func)
+    {
+        sort<bool(*)(T, T)>(a, cmp);
     }
 
     // print array to standard output
@@ -104,27 +125,28 @@ private:
     ***************************************************************************/
 
     // is v < w ?
-    static bool less(T v, T w)
+    template <typename Less>
+    static bool less(const T& v, const T& w, Less cmp)
     {
-        return v < w;
+        return cmp(v, w);
     }
 
     // exchange a[i] and a[j]
     static void exch(std::vector<T>& a, int i, int j)
     {
-        T swap = a[i];
-        a[i] = a[j];
-        a[j] = swap;
+        using std::swap;
+        swap(a[i], a[j]);
     }
 
 
    /***************************************************************************
     *  Check if array is sorted - useful for debugging.
     ***************************************************************************/
-    static bool is_sorted(std::vector<T>& a)
+    template <typename Less>
+    static bool is_sorted(std::vector<T>& a, Less cmp)
     {
         for (int i = 1; i < a.size(); i++)
-            if (less(a[i], a[i-1])) return false;
+            if (less(a[i], a[i-1], cmp)) return false;
         return true;
     }
 };
@@ -1,6 +1,8 @@
 #ifndef INVERSIONS_H
 #define INVERSIONS_H
 
+#include "ParallelMerge.h"
+
 /******************************************************************************
  *  Compilation:  javac Inversions.java
  *  Execution:    java Inversions < input.txt
@@ -21,6 +23,13 @@
  *  number of inversions in any array of length <em>n</em> (assuming
  *  comparisons take constant time).
  *  <p>
+ *  The <em>parallel_count</em> operation counts while it runs the parallel
+ *  mergesort of {@link ParallelMerge}: the halves are counted concurrently,
+ *  and each piece of a split merge counts the inversions between the keys of
+ *  the right run it places and the rest of the left run.
+ *  The <em>kendall_tau</em> operation uses it to count the pairs on which two
+ *  rankings disagree.
+ *  <p>
  *  For additional documentation, see
  *  <a href="https://algs4.cs.princeton.edu/22mergesort">Section 2.2</a>
  *  of <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
@@ -55,7 +64,7 @@ namespace Inversions
         long inversions = 0;
 
         // copy to aux[]
-        std::copy(a.begin(), a.end(), aux.begin());
+        std::copy(a.begin() + lo, a.begin() + hi + 1, aux.begin() + lo);
 
         // merge back to a[]
         int i = lo, j = mid+1;
@@ -101,6 +110,133 @@ namespace Inversions
         long inversions = count(a, b, aux, 0, a.size() - 1);
         return inversions;
     }
+
+    // insertion sort a[lo..hi], returning the number of exchanges: its inversions
+    template <typename Key, typename Less>
+    long insertion_count(std::vector<Key>& a, int lo, int hi, Less less)
+    {
+        long inversions = 0;
+        for (int i = lo + 1; i <= hi; i++)
+        {
+            for (int j = i; j > lo && less(a[j], a[j-1]); j--)
+            {
+                using std::swap;
+                swap(a[j], a[j-1]);
+                inversions++;
+            }
+        }
+        return inversions;
+    }
+
+    // stably merge src[i .. mid] with src[j .. hi] into dst[k ..], where src[i .. mid] is
+    // the part of a left run src[.. run_mid] that merges with src[j .. hi]; return the
+    // number of keys of the left run that each key of src[j .. hi] passes over
+    template <typename Key, typename Less>
+    long merge_count(std::vector<Key>& src, std::vector<Key>& dst,
+        int i, int mid, int j, int hi, int k, int run_mid, Less less)
+    {
+        long inversions = 0;
+        while (i <= mid && j <= hi)
+        {
+            if (less(src[j], src[i])) { dst[k++] = src[j++]; inversions += run_mid - i + 1; }
+            else                        dst[k++] = src[i++];
+        }
+        while (i <= mid) dst[k++] = src[i++];
+        inversions += (long) (hi - j + 1) * (run_mid - i + 1);
+        while (j <= hi)  dst[k++] = src[j++];
+        return inversions;
+    }
+
+    // merge and count src[lo .. mid] with src[mid+1 .. hi] into dst[lo .. hi] in independent pieces
+    template <typename Key, typename Less>
+    long parallel_merge_count(std::vector<Key>& src, std::vector<Key>& dst, int lo, int mid, int hi, Less less)
+    {
+        int n = hi - lo + 1;
+        int grain = Parallel::task_grain(n, ParallelMerge::MERGE_GRAIN);
+        std::vector<long> counts = std::vector<long>(Parallel::blocks(n, grain));
+        Parallel::for_each_block(0, n, grain, [&src, &dst, &counts, lo, mid, hi, less](int p, int k1, int k2)
+        {
+            int i1 = ParallelMerge::co_rank(src, lo, mid, hi, k1, less);
+            int i2 = ParallelMerge::co_rank(src, lo, mid, hi, k2, less);
+            counts[p] = merge_count(src, dst, lo + i1, lo + i2 - 1, mid + 1 + k1 - i1, mid + k2 - i2, lo + k1, mid, less);
+        });
+        return Parallel::reduce(counts, 0L, std::plus<long>());
+    }
+
+    // sort src[lo .. hi] into dst[lo .. hi], both holding the same keys on entry,
+    // and return the number of inversions in it
+    template <typename Key, typename Less>
+    long parallel_count(std::vector<Key>& src, std::vector<Key>& dst, int lo, int hi, Less less)
+    {
+        if (hi <= lo + ParallelMerge::CUTOFF) return insertion_count(dst, lo, hi, less);
+        int mid = lo + (hi - lo) / 2;
+
+        long inversions;
+        if (hi - lo + 1 < ParallelMerge::SORT_GRAIN)
+        {
+            inversions = parallel_count(dst, src, lo, mid, less);
+            inversions += parallel_count(dst, src, mid+1, hi, less);
+        }
+        else
+        {
+            long left;
+            TaskGroup group;
+            group.run([&src, &dst, &left, lo, mid, less] { left = parallel_count(dst, src, lo, mid, less); });
+            inversions = parallel_count(dst, src, mid+1, hi, less);
+            group.wait();
+            inversions += left;
+        }
+
+        if (!less(src[mid+1], src[mid]))
+        {
+            std::copy(src.begin() + lo, src.begin() + hi + 1, dst.begin() + lo);
+            return inversions;
+        }
+
+        if (hi - lo + 1 < ParallelMerge::MERGE_GRAIN) return inversions + merge_count(src, dst, lo, mid, mid + 1, hi, lo, mid, less);
+        else                                          return inversions + parallel_merge_count(src, dst, lo, mid, hi, less);
+    }
+
+    /**
+     * Returns the number of inversions in the array in the order given by
+     * {@code less}, counting subarrays concurrently on the shared {@link ThreadPool}.
+     * The argument array is not modified.
+     * @param  a the array
+     * @param  less the strict weak ordering (a functor, lambda or function)
+     * @return the number of pairs of indices {@code i < j} with {@code less(a[j], a[i])}
+     */
+    template <typename Key, typename Less>
+    long parallel_count(const std::vector<Key>& a, Less less)
+    {
+        if (a.size() < 2) return 0;
+        std::vector<Key> aux = std::vector<Key>(a.begin(), a.end());
+        std::vector<Key> b = std::vector<Key>(a.begin(), a.end());
+        return parallel_count(aux, b, 0, a.size() - 1, less);
+    }
+
+    /**
+     * Returns the number of inversions in the array, counting subarrays
+     * concurrently on the shared {@link ThreadPool}.
+     * The argument array is not modified.
+     * @param  a the array
+     * @return the number of pairs of indices {@code i < j} with {@code a[i] > a[j]}
+     */
+    template <typename Key>
+    long parallel_count(const std::vector<Key>& a)
+    {
+        return parallel_count(a, std::less<Key>());
+    }
+
+    /**
+     * Returns the Kendall tau distance between two permutations of 0 to n-1:
+     * the number of pairs of elements that they put in opposite orders.
+     * @param  a the first permutation
+     * @param  b the second permutation
+     * @return the number of pairs on which {@code a} and {@code b} disagree
+     * @throws IllegalArgumentException if {@code a} and {@code b} differ in length
+     *         or either is not a permutation of 0 to n-1
+     */
+    long kendall_tau(const std::vector<int>& a, const std::vector<int>& b);
 }
 
 /******************************************************************************
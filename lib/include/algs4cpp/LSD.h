@@ -0,0 +1,389 @@
+#ifndef LSD_H
+#define LSD_H
+
+#include <array>
+#include <bit>
+#include <concepts>
+
+#include "Date.h"
+#include "Parallel.h"
+
+/******************************************************************************
+ *  Compilation:  javac LSD.java
+ *  Execution:    java LSD < input.txt
+ *  Dependencies: StdIn.java StdOut.java
+ *  Data files:   https://algs4.cs.princeton.edu/51radix/words3.txt
+ *
+ *  LSD radix sort
+ *
+ *    - Sort a String[] array of n extended ASCII strings (R = 256), each of length w.
+ *
+ *    - Sort an int[] array of n 32-bit integers, treating each integer as
+ *      a sequence of w = 4 bytes (R = 256).
+ *
+ *  Rank-based sort on unsigned keys. Stable.
+ *
+ *  % java LSD < words3.txt
+ *  all
+ *  bad
+ *  bed
+ *  bug
+ *  dad
+ *  ...
+ *  yes
+ *  yet
+ *  zoo
+ *
+ ******************************************************************************/
+
+/**
+ *  The {@code LSD} class provides static methods for sorting an
+ *  array of <em>w</em>-character strings or 32-bit integers using LSD radix sort.
+ *  <p>
+ *  This port extends the integer sort to every fixed-width key. Signed
+ *  integers have their sign bit flipped and doubles are mapped to an unsigned
+ *  integer of the same order (see {@code radix_key()}), so {@code int},
+ *  {@code long}, {@code double}, {@link Date} and any key returned by a
+ *  client key extractor sort as unsigned bytes.
+ *  <p>
+ *  The histograms of every byte are gathered in a single pass over the
+ *  keys; each one has R = 256 counters, so they stay in L1 cache. A byte that
+ *  is the same in every key is <em>trivial</em> and its distribution pass
+ *  is skipped, so small integers or dates from a narrow range of years take
+ *  only two or three linear passes.
+ *  <p>
+ *  The {@code parallel_sort} methods distribute the keys on their most
+ *  significant non-trivial byte with concurrent block histograms and
+ *  scatters, then sort every bucket on its remaining bytes in parallel.
+ *  <p>
+ *  Every sort is stable. Sorting records by a key extractor sorts
+ *  (key, index) pairs and then moves each record once into place.
+ *  <p>
+ *  For additional documentation,
+ *  see <a href="https://algs4.cs.princeton.edu/51radix">Section 5.1</a> of
+ *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
+ *
+ *  @author Robert Sedgewick
+ *  @author Kevin Wayne
+ */
+namespace LSD
+{
+    const int BITS_PER_BYTE = 8;
+    const int R = 1 << BITS_PER_BYTE;       // extended ASCII alphabet size / radix
+    const int MASK = R - 1;
+    const int PARALLEL_CUTOFF = 1 << 16;    // sort smaller arrays serially
+
+   /***************************************************************************
+    *  Order-preserving maps from keys to unsigned integers.
+    ***************************************************************************/
+
+    /**
+     * Returns the unsigned integer with the same order as the integer {@code x}.
+     * The sign bit is flipped, so negative keys precede non-negative ones.
+     */
+    template <std::integral Key>
+    constexpr std::make_unsigned_t<Key> radix_key(Key x)
+    {
+        using Unsigned = std::make_unsigned_t<Key>;
+        if constexpr (std::is_signed_v<Key>)
+            return (Unsigned) x ^ ((Unsigned) 1 << (sizeof(Key) * BITS_PER_BYTE - 1));
+        else
+            return x;
+    }
+
+    /**
+     * Returns the unsigned integer with the same order as the double {@code x}.
+     * Negative doubles have every bit flipped, the others only their sign bit.
+     */
+    inline uint64_t radix_key(double x)
+    {
+        uint64_t bits = std::bit_cast<uint64_t>(x);
+        uint64_t sign = (uint64_t) 1 << 63;
+        return (bits & sign) ? ~bits : bits ^ sign;
+    }
+
+    /**
+     * Returns the unsigned integer with the same order as the float {@code x}.
+     */
+    inline uint32_t radix_key(float x)
+    {
+        uint32_t bits = std::bit_cast<uint32_t>(x);
+        uint32_t sign = (uint32_t) 1 << 31;
+        return (bits & sign) ? ~bits : bits ^ sign;
+    }
+
+    /**
+     * Returns the unsigned integer with the same chronological order as {@code date}.
+     */
+    inline uint32_t radix_key(const Date& date)
+    {
+        return radix_key(date.year() * 512 + date.month() * 32 + date.day());
+    }
+
+   /***************************************************************************
+    *  Serial engine.
+    ***************************************************************************/
+
+    /**
+     * Stably sorts a[lo .. hi) by the unsigned keys {@code key(a[i])}, using aux[lo .. hi).
+     */
+    template <typename T, typename KeyOf>
+    void sort(std::vector<T>& a, std::vector<T>& aux, int lo, int hi, KeyOf key)
+    {
+        using Key = decltype(key(a[lo]));
+        const int w = sizeof(Key);
+        int n = hi - lo;
+        if (n < 2) return;
+
+        // histograms of every byte in one pass
+        std::array<std::array<int, R + 1>, sizeof(Key)> count = {};
+        for (int i = lo; i < hi; i++)
+        {
+            Key k = key(a[i]);
+            for (int d = 0; d < w; d++)
+                count[d][((k >> (BITS_PER_BYTE * d)) & MASK) + 1]++;
+        }
+
+        Key first = key(a[lo]);
+        std::vector<T>* src = &a;
+        std::vector<T>* dst = &aux;
+        for (int d = 0; d < w; d++)
+        {
+            // skip bytes that are the same in every key
+            int shift = BITS_PER_BYTE * d;
+            if (count[d][((first >> shift) & MASK) + 1] == n) continue;
+
+            // compute cumulates
+            for (int r = 0; r < R; r++)
+                count[d][r+1] += count[d][r];
+
+            // distribute
+            for (int i = lo; i < hi; i++)
+            {
+                int c = (key((*src)[i]) >> shift) & MASK;
+                (*dst)[lo + count[d][c]++] = std::move((*src)[i]);
+            }
+            std::swap(src, dst);
+        }
+
+        // an odd number of passes leaves the keys in aux[]
+        if (src != &a)
+            std::move(aux.begin() + lo, aux.begin() + hi, a.begin() + lo);
+    }
+
+   /***************************************************************************
+    *  Parallel engine.
+    ***************************************************************************/
+
+    /**
+     * Stably sorts {@code a} by the unsigned keys {@code key(a[i])}, distributing on the
+     * most significant non-trivial byte in parallel and then sorting every bucket in parallel.
+     */
+    template <typename T, typename KeyOf>
+    void parallel_sort(std::vector<T>& a, std::vector<T>& aux, KeyOf key)
+    {
+        using Key = decltype(key(a[0]));
+        int n = a.size();
+        int grain = Parallel::task_grain(n, PARALLEL_CUTOFF);
+        int blocks = Parallel::blocks(n, grain);
+        if (blocks < 2)
+        {
+            sort(a, aux, 0, n, key);
+            return;
+        }
+
+        // bits in which some key differs from the first
+        Key first = key(a[0]);
+        Key bits = Parallel::map_reduce(0, n, (Key) 0, [&a, &key, first](int i) { return (Key) (key(a[i]) ^ first); },
+            std::bit_or<Key>(), grain);
+        if (bits == 0) return;
+        int shift = (std::bit_width(bits) - 1) / BITS_PER_BYTE * BITS_PER_BYTE;
+
+        // block histograms of the leading byte
+        std::vector<std::array<int, R>> count = std::vector<std::array<int, R>>(blocks);
+        Parallel::for_each_block(0, n, grain, [&a, &count, &key, shift](int b, int lo, int hi)
+        {
+            count[b].fill(0);
+            for (int i = lo; i < hi; i++)
+                count[b][(key(a[i]) >> shift) & MASK]++;
+        });
+
+        // bucket by bucket, then block by block, so the distribution is stable
+        std::vector<int> bucket = std::vector<int>(R + 1);
+        int offset = 0;
+        for (int r = 0; r < R; r++)
+        {
+            bucket[r] = offset;
+            for (int b = 0; b < blocks; b++)
+            {
+                int c = count[b][r];
+                count[b][r] = offset;
+                offset += c;
+            }
+        }
+        bucket[R] = n;
+
+        // distribute into aux[]
+        Parallel::for_each_block(0, n, grain, [&a, &aux, &count, &key, shift](int b, int lo, int hi)
+        {
+            for (int i = lo; i < hi; i++)
+            {
+                int c = (key(a[i]) >> shift) & MASK;
+                aux[count[b][c]++] = std::move(a[i]);
+            }
+        });
+
+        // sort each bucket on its remaining bytes; the leading bytes are now trivial
+        TaskGroup group;
+        for (int r = 0; r < R; r++)
+        {
+            if (bucket[r+1] - bucket[r] < 2) continue;
+            group.run([&a, &aux, &bucket, &key, r]
+            {
+                sort(aux, a, bucket[r], bucket[r+1], key);
+            });
+        }
+        group.wait();
+
+        Parallel::for_blocks(0, n, [&a, &aux](int lo, int hi)
+        {
+            std::move(aux.begin() + lo, aux.begin() + hi, a.begin() + lo);
+        }, grain);
+    }
+
+   /***************************************************************************
+    *  Client methods.
+    ***************************************************************************/
+
+    /**
+     * Rearranges the array of w-character strings in ascending order.
+     *
+     * @param a the array to be sorted
+     * @param w the number of characters per string
+     */
+    void sort(std::vector<std::string>& a, int w);
+
+    /**
+     * Rearranges the array of integers in ascending order.
+     *
+     * @param a the array to be sorted
+     */
+    void sort(std::vector<int>& a);
+
+    /**
+     * Rearranges the array of long integers in ascending order.
+     *
+     * @param a the array to be sorted
+     */
+    void sort(std::vector<long>& a);
+
+    /**
+     * Rearranges the array of doubles in ascending order.
+     *
+     * @param a the array to be sorted
+     */
+    void sort(std::vector<double>& a);
+
+    /**
+     * Rearranges the array of integers in ascending order, in parallel.
+     *
+     * @param a the array to be sorted
+     */
+    void parallel_sort(std::vector<int>& a);
+
+    /**
+     * Rearranges the array of long integers in ascending order, in parallel.
+     *
+     * @param a the array to be sorted
+     */
+    void parallel_sort(std::vector<long>& a);
+
+    /**
+     * Rearranges the array of doubles in ascending order, in parallel.
+     *
+     * @param a the array to be sorted
+     */
+    void parallel_sort(std::vector<double>& a);
+
+    // sort (key, index) pairs of the records and move each record to its place
+    template <typename T, typename KeyOf, typename Sorter>
+    void sort_records(std::vector<T>& a, KeyOf key, Sorter sorter)
+    {
+        using Key = decltype(radix_key(key(a[0])));
+        int n = a.size();
+
+        std::vector<std::pair<Key, int>> items = std::vector<std::pair<Key, int>>(n);
+        for (int i = 0; i < n; i++)
+            items[i] = std::make_pair(radix_key(key(a[i])), i);
+        sorter(items);
+
+        std::vector<T> sorted = std::vector<T>();
+        sorted.reserve(n);
+        for (int i = 0; i < n; i++)
+            sorted.push_back(std::move(a[items[i].second]));
+        a.swap(sorted);
+    }
+
+    /**
+     * Rearranges the array in ascending order of the keys given by {@code key}.
+     * The keys may be of any type accepted by {@code radix_key()}.
+     * <p>
+     * For example, {@code LSD::sort(transactions, [](const Transaction& t) { return t.when(); })}.
+     *
+     * @param a the array to be sorted
+     * @param key the function that extracts the key of an element
+     */
+    template <typename T, typename KeyOf>
+    void sort(std::vector<T>& a, KeyOf key)
+    {
+        if (a.size() < 2) return;
+        sort_records(a, key, [](auto& items)
+        {
+            auto aux = items;
+            sort(items, aux, 0, items.size(), [](const auto& item) { return item.first; });
+        });
+    }
+
+    /**
+     * Rearranges the array in ascending order of the keys given by {@code key}, in parallel.
+     *
+     * @param a the array to be sorted
+     * @param key the function that extracts the key of an element
+     */
+    template <typename T, typename KeyOf>
+    void parallel_sort(std::vector<T>& a, KeyOf key)
+    {
+        if (a.size() < 2) return;
+        sort_records(a, key, [](auto& items)
+        {
+            auto aux = items;
+            parallel_sort(items, aux, [](const auto& item) { return item.first; });
+        });
+    }
+}
+
+/******************************************************************************
+ *  Copyright 2002-2022, Robert Sedgewick and Kevin Wayne.
+ *
+ *  This file is part of algs4.jar, which accompanies the textbook
+ *
+ *      Algorithms, 4th edition by Robert Sedgewick and Kevin Wayne,
+ *      Addison-Wesley Professional, 2011, ISBN 0-321-57351-X.
+ *      http://algs4.cs.princeton.edu
+ *
+ *
+ *  algs4.jar is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  algs4.jar is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with algs4.jar.  If not, see http://www.gnu.org/licenses.
+ ******************************************************************************/
+
+#endif
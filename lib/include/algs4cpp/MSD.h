@@ -0,0 +1,195 @@
+#ifndef MSD_H
+#define MSD_H
+
+#include <array>
+
+#include "StdOut.h"
+
+/******************************************************************************
+ *  Compilation: javac MSD.java
+ *  Execution:   java MSD < input.txt
+ *  Dependencies: StdIn.java StdOut.java
+ *  Data files:   https://algs4.cs.princeton.edu/51radix/words3.txt
+ *                https://algs4.cs.princeton.edu/51radix/shells.txt
+ *
+ *  Sort an array of strings or integers using MSD radix sort.
+ *
+ *  % java MSD < shells.txt
+ *  are
+ *  by
+ *  sea
+ *  seashells
+ *  seashells
+ *  sells
+ *  sells
+ *  she
+ *  she
+ *  shells
+ *  shore
+ *  surely
+ *  the
+ *  the
+ *
+ ******************************************************************************/
+
+/**
+ *  The {@code MSD} class provides static methods for sorting an
+ *  array of extended ASCII strings using MSD radix sort.
+ *  <p>
+ *  The auxiliary array is allocated once per sort, and the count array of
+ *  each character position is allocated the first time a subarray reaches
+ *  that depth and reused by every later subarray at the same depth. When
+ *  every string of a subarray has the same character at the current
+ *  position, the distribution pass is skipped. Strings are moved, never
+ *  copied, and subarrays of at most {@code CUTOFF} strings are insertion
+ *  sorted comparing only from the current character on.
+ *  <p>
+ *  {@code T} is a string type with {@code size()}, {@code operator[]} and
+ *  {@code compare()}, such as {@code std::string} or {@code std::string_view}.
+ *  <p>
+ *  For additional documentation,
+ *  see <a href="https://algs4.cs.princeton.edu/51radix">Section 5.1</a> of
+ *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
+ *
+ *  @author Robert Sedgewick
+ *  @author Kevin Wayne
+ */
+template <typename T>
+class MSD
+{
+public:
+    /**
+     * Rearranges the array of extended ASCII strings in ascending order.
+     *
+     * @param a the array to be sorted
+     */
+    static void sort(std::vector<T>& a)
+    {
+        int n = a.size();
+        std::vector<T> aux = std::vector<T>(n);
+        std::vector<std::array<int, R + 2>> counts = std::vector<std::array<int, R + 2>>();
+        sort(a, 0, n-1, 0, aux, counts);
+        assert(is_sorted(a));
+    }
+
+    // print array to standard output
+    static void show(std::vector<T>& a)
+    {
+        for (int i = 0; i < a.size(); i++)
+        {
+            StdOut::println(a[i]);
+        }
+    }
+
+private:
+    static const int R      = 256;   // extended ASCII alphabet size
+    static const int CUTOFF =  15;   // cutoff to insertion sort
+
+    // return dth character of s, -1 if d = length of string
+    static int char_at(const T& s, int d)
+    {
+        assert(d >= 0 && d <= s.size());
+        if (d == s.size()) return -1;
+        return (uint8_t) s[d];
+    }
+
+    // sort from a[lo] to a[hi], starting at the dth character
+    static void sort(std::vector<T>& a, int lo, int hi, int d,
+        std::vector<T>& aux, std::vector<std::array<int, R + 2>>& counts)
+    {
+        // cutoff to insertion sort for small subarrays
+        if (hi <= lo + CUTOFF)
+        {
+            insertion(a, lo, hi, d);
+            return;
+        }
+
+        // reuse the count array of this depth
+        if (counts.size() <= d) counts.resize(d + 1);
+        std::array<int, R + 2>& count = counts[d];
+        count.fill(0);
+
+        // compute frequency counts
+        for (int i = lo; i <= hi; i++)
+        {
+            int c = char_at(a[i], d);
+            count[c+2]++;
+        }
+
+        // every string has the same dth character: nothing to distribute
+        int c = char_at(a[lo], d);
+        if (count[c+2] == hi - lo + 1)
+        {
+            if (c >= 0) sort(a, lo, hi, d+1, aux, counts);
+            return;
+        }
+
+        // transform counts to indices
+        for (int r = 0; r < R+1; r++)
+            count[r+1] += count[r];
+
+        // distribute
+        for (int i = lo; i <= hi; i++)
+        {
+            int c = char_at(a[i], d);
+            aux[count[c+1]++] = std::move(a[i]);
+        }
+
+        // copy back
+        for (int i = lo; i <= hi; i++)
+            a[i] = std::move(aux[i - lo]);
+
+        // recursively sort for each character (excludes sentinel -1)
+        // counts[] may grow during the recursion, so index it afresh each time
+        for (int r = 0; r < R; r++)
+            sort(a, lo + counts[d][r], lo + counts[d][r+1] - 1, d+1, aux, counts);
+    }
+
+    // insertion sort a[lo..hi], starting at dth character
+    static void insertion(std::vector<T>& a, int lo, int hi, int d)
+    {
+        for (int i = lo; i <= hi; i++)
+            for (int j = i; j > lo && less(a[j], a[j-1], d); j--)
+                std::swap(a[j], a[j-1]);
+    }
+
+    // is v less than w, starting at character d
+    static bool less(const T& v, const T& w, int d)
+    {
+        assert(d <= v.size() && d <= w.size());
+        return v.compare(d, T::npos, w, d, T::npos) < 0;
+    }
+
+    static bool is_sorted(std::vector<T>& a)
+    {
+        for (int i = 1; i < a.size(); i++)
+            if (less(a[i], a[i-1], 0)) return false;
+        return true;
+    }
+};
+
+/******************************************************************************
+ *  Copyright 2002-2022, Robert Sedgewick and Kevin Wayne.
+ *
+ *  This file is part of algs4.jar, which accompanies the textbook
+ *
+ *      Algorithms, 4th edition by Robert Sedgewick and Kevin Wayne,
+ *      Addison-Wesley Professional, 2011, ISBN 0-321-57351-X.
+ *      http://algs4.cs.princeton.edu
+ *
+ *
+ *  algs4.jar is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  algs4.jar is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with algs4.jar.  If not, see http://www.gnu.org/licenses.
+ ******************************************************************************/
+
+#endif
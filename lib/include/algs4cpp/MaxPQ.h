@@ -1,23 +1,23 @@
 #ifndef MAXPQ_H
 #define MAXPQ_H
 
+#include "DaryHeap.h"
+
 /******************************************************************************
  *  Compilation:  javac MaxPQ.java
  *  Execution:    java MaxPQ < input.txt
  *  Dependencies: StdIn.java StdOut.java
  *  Data files:   https://algs4.cs.princeton.edu/24pq/tinyPQ.txt
  *
- *  Generic max priority queue implementation with a binary heap.
+ *  Generic max priority queue implementation with a d-ary heap.
  *  Can be used with a comparator instead of the natural order,
  *  but the generic Key type must still be Comparable.
  *
  *  % java MaxPQ < tinyPQ.txt
  *  Q X P (6 left on pq)
  *
- *  We use a one-based array to simplify parent and child calculations.
- *
- *  Can be optimized by replacing full exchanges with half exchanges
- *  (ala insertion sort).
+ *  We store the keys by value in a zero-based array, and move them
+ *  into a hole instead of exchanging them (ala insertion sort).
  *
  ******************************************************************************/
 
@@ -28,16 +28,28 @@
  *  testing if the priority queue is empty, and iterating through
  *  the keys.
  *  <p>
- *  This implementation uses a <em>binary heap</em>.
+ *  This implementation uses a <em>d-ary heap</em>, binary by default.
  *  The <em>insert</em> and <em>delete-the-maximum</em> operations take
  *  &Theta;(log <em>n</em>) amortized time, where <em>n</em> is the number
  *  of elements in the priority queue. This is an amortized bound
  *  (and not a worst-case bound) because of array resizing operations.
- *  The <em>min</em>, <em>size</em>, and <em>is-empty</em> operations take
+ *  The <em>max</em>, <em>size</em>, and <em>is-empty</em> operations take
  *  &Theta;(1) time in the worst case.
  *  Construction takes time proportional to the specified capacity or the
  *  number of items used to initialize the data structure.
  *  <p>
+ *  The keys are stored by value in one contiguous array, so inserting a key
+ *  allocates nothing but the occasional doubling of the array, and a compare
+ *  reads two neighbouring keys rather than two keys anywhere in memory.
+ *  Keys are moved into place, never copied, and {@code emplace()} constructs
+ *  a key in the array. With a branching factor {@code D} of 4 or 8 the
+ *  heap is two or three times shallower, and the <em>D</em> children of a
+ *  node are adjacent: swims take fewer steps, and each level of a sink reads
+ *  one group of children. Removing the maximum sinks the last key by moving
+ *  the largest child up into the hole all the way to a leaf, then sifting
+ *  the key back up the short distance to its place (bottom-up heapsort's
+ *  sink), one compare per child instead of one more per level.
+ *  <p>
  *  For additional documentation, see
  *  <a href="https://algs4.cs.princeton.edu/24pq">Section 2.4</a> of
  *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
@@ -46,9 +58,10 @@
  *  @author Kevin Wayne
  *
  *  @param <Key> the generic type of key on this priority queue
+ *  @param <Compare> the type of the functor ordering the keys, {@code std::less<Key>} by default
+ *  @param <D> the number of children of a node, 2 by default
  */
-
-template <typename Key>
+template <typename Key, typename Compare = std::less<Key>, int D = 2>
 class MaxPQ
 {
 public:
@@ -59,8 +72,8 @@ public:
      */
     MaxPQ(int init_capacity)
     {
-        m_pq = std::vector<ptr<Key>>(init_capacity + 1);
-        m_n = 0;
+        static_assert(D >= 2, "a heap node has at least two children");
+        m_pq.reserve(init_capacity);
         m_cmp = nullptr;
     }
 
@@ -78,11 +91,9 @@ public:
      * @param  init_capacity the initial capacity of this priority queue
      * @param  cmp the order in which to compare the keys
      */
-    MaxPQ(int init_capacity, bool(*cmp)(Key*, Key*))
+    MaxPQ(int init_capacity, bool (*cmp)(Key*, Key*)) : MaxPQ(init_capacity)
     {
         m_cmp = cmp;
-        m_pq = std::vector<ptr<Key>>(init_capacity + 1);
-        m_n = 0;
     }
 
     /**
@@ -90,52 +101,57 @@ public:
      *
      * @param  cmp the order in which to compare the keys
      */
-    MaxPQ(bool(*cmp)(Key*, Key*)) : MaxPQ(1, cmp)
+    MaxPQ(bool (*cmp)(Key*, Key*)) : MaxPQ(1, cmp)
     {
     }
 
     /**
-     * Initializes a priority queue from the array of keys.
-     * Takes time proportional to the number of keys, using sink-based heap construction.
+     * Initializes an empty priority queue with the given initial capacity,
+     * ordering the keys with the given functor.
      *
-     * @param  keys the array of keys
+     * @param  init_capacity the initial capacity of this priority queue
+     * @param  compare the functor ordering the keys
      */
-    MaxPQ(std::vector<ptr<Key>> keys)
+    MaxPQ(int init_capacity, Compare compare) : MaxPQ(init_capacity)
     {
-        m_n = keys.size();
-        m_cmp = nullptr;
-        m_pq = std::vector<ptr<Key>>(keys.size() + 1);
-        std::copy(keys.begin(), keys.end(), m_pq.begin() + 1);
+        m_compare = compare;
+    }
 
-        for (int k = m_n/2; k >= 1; k--)
-            sink(k);
-        assert(is_max_heap());
+    /**
+     * Initializes an empty priority queue, ordering the keys with the given functor.
+     *
+     * @param  compare the functor ordering the keys
+     */
+    MaxPQ(Compare compare) : MaxPQ(1, compare)
+    {
     }
 
     /**
-     * Copy constructor.
-     * 
-     * @param other the MaxPQ to copy from
+     * Initializes a priority queue from the array of keys, taking over its storage.
+     * <p>
+     * Takes time proportional to the number of keys, using sink-based heap construction.
+     *
+     * @param  keys the array of keys
      */
-    MaxPQ(const MaxPQ<Key>& other) : 
-        m_n(other.m_n), m_cmp(other.m_cmp) 
+    MaxPQ(std::vector<Key> keys) : m_pq(std::move(keys)), m_cmp(nullptr)
     {
-        m_pq = std::vector<ptr<Key>>();
-        copy_ptrs<Key>(m_pq, other.m_pq);
+        heapify();
     }
-        
+
     /**
-     * Assigment operator.
-     * 
-     * @param other the MaxPQ to assign from
+     * Initializes a priority queue from the array of keys, copying each key
+     * out of its allocation.
+     * <p>
+     * Takes time proportional to the number of keys, using sink-based heap construction.
+     *
+     * @param  keys the array of keys
      */
-    MaxPQ& operator=(const MaxPQ<Key>& other)
+    MaxPQ(const std::vector<ptr<Key>>& keys) : m_cmp(nullptr)
     {
-        m_n = other.m_n;
-        m_cmp = other.m_cmp;
-        m_pq = std::vector<ptr<Key>>();
-        copy_ptrs<Key>(m_pq, other.m_pq);
-        return *this;
+        m_pq.reserve(keys.size());
+        for (const ptr<Key>& key : keys)
+            m_pq.push_back(*key);
+        heapify();
     }
 
     /**
@@ -146,7 +162,7 @@ public:
      */
     bool is_empty() const
     {
-        return m_n == 0;
+        return m_pq.empty();
     }
 
     /**
@@ -156,7 +172,7 @@ public:
      */
     int size() const
     {
-        return m_n;
+        return m_pq.size();
     }
 
     /**
@@ -165,25 +181,43 @@ public:
      * @return a largest key on this priority queue
      * @throws NoSuchElementException if this priority queue is empty
      */
-    Key max() const
+    const Key& max() const
     {
         if (is_empty()) error("Priority queue underflow");
-        return *(m_pq[1]);
+        return m_pq[0];
     }
 
     /**
      * Adds a new key to this priority queue.
      *
-     * @param  x the new key to add to this priority queue
+     * @param  x the key to add to this priority queue
      */
-    void insert(Key x)
+    void insert(const Key& x)
     {
-        // double size of array if necessary
-        if (m_n == m_pq.size() - 1) resize(2 * m_pq.size());
+        emplace(x);
+    }
 
-        // add x, and percolate it up to maintain heap invariant
-        m_pq[++m_n] = alloc<Key>(x);
-        swim(m_n);
+    /**
+     * Adds a new key to this priority queue, moving it in.
+     *
+     * @param  x the key to add to this priority queue
+     */
+    void insert(Key&& x)
+    {
+        emplace(std::move(x));
+    }
+
+    /**
+     * Adds a new key, constructed in place from the arguments, to this priority queue.
+     *
+     * @param  args the arguments of a constructor of the key
+     */
+    template <typename... Args>
+    void emplace(Args&&... args)
+    {
+        // add the key, and percolate it up to maintain heap invariant
+        m_pq.emplace_back(std::forward<Args>(args)...);
+        swim(m_pq.size() - 1);
         assert(is_max_heap());
     }
 
@@ -196,99 +230,194 @@ public:
     Key del_max()
     {
         if (is_empty()) error("Priority queue underflow");
-        Key max = *(m_pq[1]);
-        exch(1, m_n--);
-        sink(1);
-        m_pq[m_n+1].reset();     // to avoid loitering and help with garbage collection
-        if ((m_n > 0) && (m_n == (m_pq.size() - 1) / 4)) resize(m_pq.size() / 2);
+        Key max = std::move(m_pq[0]);
+        Key last = std::move(m_pq.back());
+        m_pq.pop_back();
+        if (!is_empty()) sink(0, std::move(last));
         assert(is_max_heap());
         return max;
     }
 
-private:
-    std::vector<ptr<Key>> m_pq; // store items at indices 1 to n
-    int m_n;                    // number of items on priority queue
-    bool(*m_cmp)(Key*, Key*);   // optional comparator
-
-    // resize the underlying array to have the given capacity
-    void resize(int capacity)
+    /**
+     * Removes and returns a largest key on this priority queue, putting
+     * {@code x} in its place with a single sink: an insert and a
+     * delete-the-maximum for the price of one, as a stream that keeps
+     * its m smallest keys needs.
+     *
+     * @param  x the key to add to this priority queue
+     * @return a largest key on this priority queue before {@code x} was added
+     * @throws NoSuchElementException if this priority queue is empty
+     */
+    Key replace_max(Key x)
     {
-        assert(capacity > m_n);
-        m_pq.resize(capacity);
+        if (is_empty()) error("Priority queue underflow");
+        Key max = std::move(m_pq[0]);
+        sink(0, std::move(x));
+        assert(is_max_heap());
+        return max;
     }
 
-    /***************************************************************************
-    * Helper functions to restore the heap invariant.
-    ***************************************************************************/
-
-    void swim(int k)
+    /**
+     * Adds the keys in [first, last) to this priority queue. The keys are
+     * swum up one by one as long as they climb little, as random keys do.
+     * Once they climb more than {@code SWIM_LEVELS} levels each on average,
+     * the heap order is restored bottom-up over the ancestors of the rest of
+     * the batch only, as heap construction does: in time linear in the size
+     * of the batch, plus the square of the height.
+     *
+     * @param  first an iterator to the first key to add
+     * @param  last an iterator past the last key to add
+     */
+    template <typename It>
+    void insert_range(It first, It last)
     {
-        while (k > 1 && less(k/2, k))
+        int n = size();
+        for (; first != last; ++first)
+            m_pq.emplace_back(*first);
+
+        if (n == 0)
         {
-            exch(k/2, k);
-            k = k/2;
+            heapify();
+            assert(is_max_heap());
+            return;
         }
+
+        // swim the new keys while they climb at most SWIM_LEVELS levels each on average
+        long long budget = height();
+        int i = n;
+        for (; i < size() && budget >= 0; i++)
+            budget += SWIM_LEVELS - swim(i);
+        if (i < size())
+        {
+            // the parents of the rest, then their parents, up to the root
+            int lo = (i - 1) / D, hi = (size() - 2) / D;
+            while (true)
+            {
+                for (int j = hi; j >= lo; j--)
+                    sink(j, std::move(m_pq[j]));
+                if (lo == 0) break;
+                lo = (lo - 1) / D;
+                hi = (hi - 1) / D;
+            }
+        }
+        assert(is_max_heap());
     }
 
-    void sink(int k)
+    /**
+     * Removes the {@code k} largest keys on this priority queue, appending
+     * them to {@code keys} in descending order. Few keys are removed one at a
+     * time. When {@code k} delete-the-maximums would cost more than a pass
+     * over the heap, the {@code k} largest keys are selected in one pass,
+     * sorted, and the heap rebuilt from the rest, in time linear in the size
+     * of the heap plus <em>k</em> log <em>k</em>.
+     *
+     * @param  k the number of keys to remove
+     * @param  keys the array to append the keys removed to
+     * @throws IllegalArgumentException unless {@code 0 <= k <= size()}
+     */
+    void pop_k(int k, std::vector<Key>& keys)
     {
-        while (2*k <= m_n)
+        if (k < 0 || k > size()) error("cannot remove {} keys of {}", k, size());
+        if ((long long) k * height() < size())
         {
-            int j = 2*k;
-            if (j < m_n && less(j, j+1)) j++;
-            if (!less(k, j)) break;
-            exch(k, j);
-            k = j;
+            for (int i = 0; i < k; i++)
+                keys.push_back(del_max());
+            return;
         }
+
+        auto before = [this](const Key& v, const Key& w) { return less(w, v); };
+        std::nth_element(m_pq.begin(), m_pq.begin() + k, m_pq.end(), before);
+        std::sort(m_pq.begin(), m_pq.begin() + k, before);
+        std::move(m_pq.begin(), m_pq.begin() + k, std::back_inserter(keys));
+        m_pq.erase(m_pq.begin(), m_pq.begin() + k);
+        heapify();
     }
 
+private:
+    static const int SWIM_LEVELS = 2;  // levels a key of a batch may climb on average before the rest is heapified
 
-    /***************************************************************************
-    * Helper functions for compares and swaps.
+    std::vector<Key> m_pq;          // store items at indices 0 to n-1
+    bool(*m_cmp)(Key*, Key*);       // optional comparator
+    Compare m_compare;              // order of the keys when m_cmp is not given
+
+   /***************************************************************************
+    * Helper functions to restore the heap invariant.
+    * The children of node k are D*k + 1 through D*k + D.
     ***************************************************************************/
-    bool less(int i, int j) const
+
+    // levels of the heap
+    int height() const
     {
-        if (m_cmp == nullptr)
+        int levels = 0;
+        for (long long nodes = 0, level = 1; nodes < size(); level *= D)
         {
-            return *(m_pq[i]) < *(m_pq[j]);
+            nodes += level;
+            levels++;
         }
-        else
+        return levels;
+    }
+
+    void heapify()
+    {
+        for (int k = (size() - 2) / D; k >= 0; k--)
+            sink(k, std::move(m_pq[k]));
+        assert(is_max_heap());
+    }
+
+    // move the key at k up into the hole left by each smaller parent; returns the levels it climbed
+    int swim(int k)
+    {
+        if (k == 0 || !less(m_pq[(k - 1) / D], m_pq[k])) return 0;
+        Key x = std::move(m_pq[k]);
+        int levels = 0;
+        do
         {
-            return (*m_cmp)(m_pq[i].get(), m_pq[j].get());
-        }
+            int parent = (k - 1) / D;
+            m_pq[k] = std::move(m_pq[parent]);
+            k = parent;
+            levels++;
+        } while (k > 0 && less(m_pq[(k - 1) / D], x));
+        m_pq[k] = std::move(x);
+        return levels;
     }
 
-    void exch(int i, int j)
+    // put x in the hole at k: move the largest child up into the hole all
+    // the way down to a leaf, then sift x up from there
+    void sink(int k, Key x)
     {
-        std::swap(m_pq[i], m_pq[j]);
+        // the choice of comparator is made once, not at every compare
+        if (m_cmp == nullptr)
+            DaryHeap::sink<D>(m_pq.data(), k, size(), std::move(x),
+                [cmp = m_compare](const Key& v, const Key& w) { return cmp(v, w); });
+        else
+            DaryHeap::sink<D>(m_pq.data(), k, size(), std::move(x),
+                [this](const Key& v, const Key& w) { return less(v, w); });
     }
 
-    // is pq[1..n] a max heap?
-    bool is_max_heap() const
+   /***************************************************************************
+    * Helper functions for compares.
+    ***************************************************************************/
+    bool less(const Key& v, const Key& w) const
     {
-        for (int i = 1; i <= m_n; i++)
+        if (m_cmp == nullptr)
         {
-            if (m_pq[i] == nullptr) return false;
+            return m_compare(v, w);
         }
-        for (int i = m_n+1; i < m_pq.size(); i++)
+        else
         {
-            if (m_pq[i] != nullptr) return false;
+            return (*m_cmp)(const_cast<Key*>(&v), const_cast<Key*>(&w));
         }
-        if (m_pq[0] != nullptr) return false;
-        return is_max_heap_ordered(1);
     }
 
-    // is subtree of pq[1..n] rooted at k a max heap?
-    bool is_max_heap_ordered(int k) const
+    // is pq[0..n-1] a max heap?
+    bool is_max_heap() const
     {
-        if (k > m_n) return true;
-        int left = 2*k;
-        int right = 2*k + 1;
-        if (left  <= m_n && less(k, left))  return false;
-        if (right <= m_n && less(k, right)) return false;
-        return is_max_heap_ordered(left) && is_max_heap_ordered(right);
+        for (int k = 1; k < size(); k++)
+            if (less(m_pq[(k - 1) / D], m_pq[k])) return false;
+        return true;
     }
 
+
     /***************************************************************************
     * Iterator.
     ***************************************************************************/
@@ -300,10 +429,10 @@ private:
         using pointer           = Key*;  // or also value_type*
         using reference         = Key&;  // or also value_type&
 
-        HeapIterator(MaxPQ<Key>& max_pq)
+        HeapIterator(MaxPQ& max_pq)
         {
             m_copy = max_pq;
-            m_ptr = m_copy.m_pq[1].get();
+            m_ptr = m_copy.is_empty() ? nullptr : &m_copy.m_pq[0];
         }
 
         HeapIterator(pointer ptr) : m_ptr(ptr) {}
@@ -320,7 +449,7 @@ private:
             if (m_copy.is_empty())
                 m_ptr = nullptr;
             else
-                m_ptr = m_copy.m_pq[1].get();
+                m_ptr = &m_copy.m_pq[0];
 
             return *this;
         }  
@@ -345,16 +474,16 @@ private:
         
     private:
         pointer m_ptr;
-        MaxPQ<Key> m_copy;
+        MaxPQ m_copy;
     };
-    
+
 public:
     HeapIterator begin()
     {
         return HeapIterator(*this);
     }
 
-    HeapIterator end() const
+    HeapIterator end()
     {
         return HeapIterator(nullptr);
     }
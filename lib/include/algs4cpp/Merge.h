@@ -1,7 +1,8 @@
 #ifndef MERGE_H
 #define MERGE_H
 
-#include "Merge.h"
+#include "ParallelMerge.h"
+#include "SortingNetwork.h"
 #include "StdOut.h"
 
 /******************************************************************************
@@ -40,6 +41,9 @@
  *  This sorting algorithm is stable.
  *  It uses &Theta;(<em>n</em>) extra memory (not including the input array).
  *  <p>
+ *  The {@code parallel_sort} method sorts subarrays and splits merges
+ *  across the shared {@link ThreadPool}; see {@link ParallelMerge}.
+ *  <p>
  *  For additional documentation, see
  *  <a href="https://algs4.cs.princeton.edu/22mergesort">Section 2.2</a> of
  *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
@@ -48,7 +52,7 @@
  *  @author Robert Sedgewick
  *  @author Kevin Wayne
  */
-template <typename T>
+template <typename T, typename Compare = std::less<T>>
 class Merge
 {
 public:
@@ -57,10 +61,44 @@ public:
      * @param a the array to be sorted
      */
     static void sort(std::vector<T>& a)
+    {
+        sort(a, Compare());
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator.
+     * @param a the array to be sorted
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void sort(std::vector<T>& a, Less cmp)
     {
         std::vector<T> aux = std::vector<T>(a.size());
-        sort(a, aux, 0, a.size()-1);
-        assert(is_sorted(a));
+        sort(a, aux, 0, a.size()-1, cmp);
+        assert(is_sorted(a, 0, a.size() - 1, cmp));
+    }
+
+    /**
+     * Rearranges the array in ascending order, using the natural order,
+     * sorting independent subarrays and merge pieces in parallel.
+     * @param a the array to be sorted
+     */
+    static void parallel_sort(std::vector<T>& a)
+    {
+        parallel_sort(a, Compare());
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator,
+     * sorting independent subarrays and merge pieces in parallel.
+     * @param a the array to be sorted
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void parallel_sort(std::vector<T>& a, Less cmp)
+    {
+        ParallelMerge::sort(a, cmp);
+        assert(is_sorted(a, 0, a.size() - 1, cmp));
     }
 
     /**
@@ -69,15 +107,16 @@ public:
      * @return a permutation {@code p[]} such that {@code a[p[0]]}, {@code a[p[1]]},
      *    ..., {@code a[p[n-1]]} are in ascending order
      */
-    static std::vector<int> index_sort(std::vector<T>& a)
+    static std::vector<int> index_sort(const std::vector<T>& a)
     {
+        Compare cmp = Compare();
         int n = a.size();
         std::vector<int> index = std::vector<int>(n);
         for (int i = 0; i < n; i++)
             index[i] = i;
 
         std::vector<int> aux = std::vector<int>(n);
-        sort(a, index, aux, 0, n-1);
+        sort(a, index, aux, 0, n-1, cmp);
         return index;
     }
 
@@ -92,11 +131,12 @@ public:
 
 private:
     // stably merge a[lo .. mid] with a[mid+1 ..hi] using aux[lo .. hi]
-    static void merge(std::vector<T>& a, std::vector<T>& aux, int lo, int mid, int hi)
+    template <typename Less>
+    static void merge(std::vector<T>& a, std::vector<T>& aux, int lo, int mid, int hi, Less cmp)
     {
         // precondition: a[lo .. mid] and a[mid+1 .. hi] are sorted subarrays
-        assert(is_sorted(a, lo, mid));
-        assert(is_sorted(a, mid+1, hi));
+        assert(is_sorted(a, lo, mid, cmp));
+        assert(is_sorted(a, mid+1, hi, cmp));
 
         // copy to aux[]
         for (int k = lo; k <= hi; k++)
@@ -108,24 +148,36 @@ private:
         int i = lo, j = mid+1;
         for (int k = lo; k <= hi; k++)
         {
-            if      (i > mid)              a[k] = aux[j++];
-            else if (j > hi)               a[k] = aux[i++];
-            else if (less(aux[j], aux[i])) a[k] = aux[j++];
-            else                           a[k] = aux[i++];
+            if      (i > mid)                   a[k] = aux[j++];
+            else if (j > hi)                    a[k] = aux[i++];
+            else if (less(aux[j], aux[i], cmp)) a[k] = aux[j++];
+            else                                a[k] = aux[i++];
         }
 
         // postcondition: a[lo .. hi] is sorted
-        assert(is_sorted(a, lo, hi));
+        assert(is_sorted(a, lo, hi, cmp));
     }
 
     // mergesort a[lo..hi] using auxiliary array aux[lo..hi]
-    static void sort(std::vector<T>& a, std::vector<T>& aux, int lo, int hi)
+    template <typename Less>
+    static void sort(std::vector<T>& a, std::vector<T>& aux, int lo, int hi, Less cmp)
     {
         if (hi <= lo) return;
+
+        // small subarrays of primitive keys go to a sorting network
+        if constexpr (SortingNetwork::applies<T, Less>)
+        {
+            if (hi <= lo + SortingNetwork::CUTOFF)
+            {
+                SortingNetwork::sort(a, lo, hi);
+                return;
+            }
+        }
+
         int mid = lo + (hi - lo) / 2;
-        sort(a, aux, lo, mid);
-        sort(a, aux, mid + 1, hi);
-        merge(a, aux, lo, mid, hi);
+        sort(a, aux, lo, mid, cmp);
+        sort(a, aux, mid + 1, hi, cmp);
+        merge(a, aux, lo, mid, hi, cmp);
     }
 
 
@@ -133,24 +185,22 @@ private:
     *  Helper sorting function.
     ***************************************************************************/
 
-    static bool less(T v, T w)
+    // is v < w ?
+    template <typename Less>
+    static bool less(const T& v, const T& w, Less cmp)
     {
-        return v < w;
+        return cmp(v, w);
     }
 
     /***************************************************************************
     *  Check if array is sorted - useful for debugging.
     ***************************************************************************/
 
-    static bool is_sorted(std::vector<T>& a)
-    {
-        return is_sorted(a, 0, a.size() - 1);
-    }
-
-    static bool is_sorted(std::vector<T>& a, int lo, int hi)
+    template <typename Less>
+    static bool is_sorted(std::vector<T>& a, int lo, int hi, Less cmp)
     {
         for (int i = lo + 1; i <= hi; i++)
-            if (less(a[i], a[i-1])) return false;
+            if (less(a[i], a[i-1], cmp)) return false;
         return true;
     }
 
@@ -158,8 +208,9 @@ private:
     /***************************************************************************
     *  Index mergesort.
     ***************************************************************************/
-    static void merge(std::vector<T>& a, 
-        std::vector<int>& index, std::vector<int>& aux, int lo, int mid, int hi)
+    template <typename Less>
+    static void merge(const std::vector<T>& a, 
+        std::vector<int>& index, std::vector<int>& aux, int lo, int mid, int hi, Less cmp)
     {
 
         // copy to aux[]
@@ -172,21 +223,22 @@ private:
         int i = lo, j = mid+1;
         for (int k = lo; k <= hi; k++)
         {
-            if      (i > mid)                    index[k] = aux[j++];
-            else if (j > hi)                     index[k] = aux[i++];
-            else if (less(a[aux[j]], a[aux[i]])) index[k] = aux[j++];
-            else                                 index[k] = aux[i++];
+            if      (i > mid)                         index[k] = aux[j++];
+            else if (j > hi)                          index[k] = aux[i++];
+            else if (less(a[aux[j]], a[aux[i]], cmp)) index[k] = aux[j++];
+            else                                      index[k] = aux[i++];
         }
     }
 
-    static void sort(std::vector<T>& a, 
-        std::vector<int>& index, std::vector<int>& aux, int lo, int hi)
+    template <typename Less>
+    static void sort(const std::vector<T>& a, 
+        std::vector<int>& index, std::vector<int>& aux, int lo, int hi, Less cmp)
     {
         if (hi <= lo) return;
         int mid = lo + (hi - lo) / 2;
-        sort(a, index, aux, lo, mid);
-        sort(a, index, aux, mid + 1, hi);
-        merge(a, index, aux, lo, mid, hi);
+        sort(a, index, aux, lo, mid, cmp);
+        sort(a, index, aux, mid + 1, hi, cmp);
+        merge(a, index, aux, lo, mid, hi, cmp);
     }
 };
 
@@ -31,14 +31,23 @@
  *  The {@code MergeBU} class provides static methods for sorting an
  *  array using <em>bottom-up mergesort</em>. It is non-recursive.
  *  <p>
+ *  This implementation is a <em>natural</em> mergesort in the style of
+ *  TimSort. It scans the array once for runs that are already ascending
+ *  (or strictly descending, which it reverses), extends runs shorter than
+ *  a minimum length of 16 to 32 keys by binary insertion, and merges the runs
+ *  from a stack whose lengths are kept decreasing faster than the Fibonacci
+ *  numbers, so merges stay balanced. A merge skips the keys already in
+ *  place at either end, and when one run keeps winning it <em>gallops</em>:
+ *  it finds how many keys to take with an exponential search instead of
+ *  one compare per key.
+ *  <p>
  *  This implementation takes &Theta;(<em>n</em> log <em>n</em>) time
- *  to sort any array of length <em>n</em> (assuming comparisons
- *  take constant time). It makes between
- *  ~ &frac12; <em>n</em> log<sub>2</sub> <em>n</em> and
- *  ~ 1 <em>n</em> log<sub>2</sub> <em>n</em> compares.
+ *  to sort an array of length <em>n</em> in the worst case (assuming
+ *  comparisons take constant time), and &Theta;(<em>n</em>) time when the
+ *  array is sorted, reverse sorted or made of a few runs.
  *  <p>
  *  This sorting algorithm is stable.
- *  It uses &Theta;(<em>n</em>) extra memory (not including the input array).
+ *  It uses at most <em>n</em>/2 extra memory (not including the input array).
  *  <p>
  *  For additional documentation, see
  *  <a href="https://algs4.cs.princeton.edu/21elementary">Section 2.1</a> of
@@ -47,7 +56,7 @@
  *  @author Robert Sedgewick
  *  @author Kevin Wayne
  */
-template <typename T>
+template <typename T, typename Compare = std::less<T>>
 class MergeBU
 {
 public:
@@ -56,19 +65,50 @@ public:
      * @param a the array to be sorted
      */
     static void sort(std::vector<T>& a)
+    {
+        sort(a, Compare());
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator.
+     * @param a the array to be sorted
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void sort(std::vector<T>& a, Less cmp)
     {
         int n = a.size();
-        std::vector<T> aux = std::vector<T>(n);
-        for (int len = 1; len < n; len *= 2)
+        if (n < 2) return;
+
+        // too short to bother merging: extend the first run by binary insertion
+        if (n < MIN_MERGE)
         {
-            for (int lo = 0; lo < n-len; lo += len+len)
+            int run = count_run(a, 0, n, cmp);
+            binary_insertion(a, 0, n, run, cmp);
+            assert(is_sorted(a, cmp));
+            return;
+        }
+
+        MergeState state = MergeState();
+        int min_run = min_run_length(n);
+        for (int lo = 0; lo < n; )
+        {
+            // find the next run, extending it to min_run keys if it is shorter
+            int run = count_run(a, lo, n, cmp);
+            if (run < min_run)
             {
-                int mid  = lo+len-1;
-                int hi = std::min(mid + len, n-1);
-                merge(a, aux, lo, mid, hi);
+                int forced = std::min(n - lo, min_run);
+                binary_insertion(a, lo, lo + forced, lo + run, cmp);
+                run = forced;
             }
+
+            state.run_base.push_back(lo);
+            state.run_length.push_back(run);
+            merge_collapse(a, state, cmp);
+            lo += run;
         }
-        assert(is_sorted(a));
+        merge_force_collapse(a, state, cmp);
+        assert(is_sorted(a, cmp));
     }
 
     // print array to standard output
@@ -81,45 +121,453 @@ public:
     }
 
 private:
-    // stably merge a[lo..mid] with a[mid+1..hi] using aux[lo..hi]
-    static void merge(std::vector<T>& a, std::vector<T>& aux, int lo, int mid, int hi) {
+    static const int MIN_MERGE = 32;    // arrays shorter than this are insertion sorted
+    static const int MIN_GALLOP = 7;    // initial number of consecutive wins that starts galloping
+
+    // the pending runs, from the bottom of the stack to the top, and the merge buffer
+    struct MergeState
+    {
+        std::vector<int> run_base;
+        std::vector<int> run_length;
+        std::vector<T> aux;
+        int min_gallop = MIN_GALLOP;
+    };
+
+   /***************************************************************************
+    *  Runs.
+    ***************************************************************************/
+
+    // length of the run starting at a[lo] (before a[hi]); a strictly descending run is reversed
+    template <typename Less>
+    static int count_run(std::vector<T>& a, int lo, int hi, Less cmp)
+    {
+        int run_hi = lo + 1;
+        if (run_hi == hi) return 1;
+
+        if (less(a[run_hi++], a[lo], cmp))
+        {
+            while (run_hi < hi && less(a[run_hi], a[run_hi - 1], cmp))
+                run_hi++;
+            std::reverse(a.begin() + lo, a.begin() + run_hi);
+        }
+        else
+        {
+            while (run_hi < hi && !less(a[run_hi], a[run_hi - 1], cmp))
+                run_hi++;
+        }
+        return run_hi - lo;
+    }
+
+    // sort a[lo .. hi-1], of which a[lo .. start-1] is already sorted, by stable binary insertion
+    template <typename Less>
+    static void binary_insertion(std::vector<T>& a, int lo, int hi, int start, Less cmp)
+    {
+        for (int i = start; i < hi; i++)
+        {
+            T v = std::move(a[i]);
+            int left = lo, right = i;
+            while (left < right)
+            {
+                int mid = left + (right - left) / 2;
+                if (less(v, a[mid], cmp)) right = mid;
+                else                      left = mid + 1;
+            }
+            std::move_backward(a.begin() + left, a.begin() + i, a.begin() + i + 1);
+            a[left] = std::move(v);
+        }
+    }
+
+    // minimum run length: n / 2^k for some k, between MIN_MERGE / 2 and MIN_MERGE,
+    // so that the runs split n into (nearly) a power of two of equal pieces
+    static int min_run_length(int n)
+    {
+        int r = 0;
+        while (n >= MIN_MERGE)
+        {
+            r |= n & 1;
+            n >>= 1;
+        }
+        return n + r;
+    }
+
+   /***************************************************************************
+    *  Merge policy. The stack of run lengths is kept so that each run is
+    *  longer than the next two combined, which keeps merges balanced and
+    *  the stack O(log n) deep.
+    ***************************************************************************/
+
+    template <typename Less>
+    static void merge_collapse(std::vector<T>& a, MergeState& state, Less cmp)
+    {
+        std::vector<int>& len = state.run_length;
+        while (len.size() > 1)
+        {
+            int n = len.size() - 2;
+            if ((n > 0 && len[n-1] <= len[n] + len[n+1]) || (n > 1 && len[n-2] <= len[n-1] + len[n]))
+            {
+                if (len[n-1] < len[n+1]) n--;
+            }
+            else if (len[n] > len[n+1])
+            {
+                break;
+            }
+            merge_at(a, state, n, cmp);
+        }
+    }
+
+    template <typename Less>
+    static void merge_force_collapse(std::vector<T>& a, MergeState& state, Less cmp)
+    {
+        std::vector<int>& len = state.run_length;
+        while (len.size() > 1)
+        {
+            int n = len.size() - 2;
+            if (n > 0 && len[n-1] < len[n+1]) n--;
+            merge_at(a, state, n, cmp);
+        }
+    }
+
+    // merge the runs at stack positions i and i+1
+    template <typename Less>
+    static void merge_at(std::vector<T>& a, MergeState& state, int i, Less cmp)
+    {
+        int base1 = state.run_base[i], len1 = state.run_length[i];
+        int base2 = state.run_base[i+1], len2 = state.run_length[i+1];
+        state.run_length[i] = len1 + len2;
+        state.run_base.erase(state.run_base.begin() + i + 1);
+        state.run_length.erase(state.run_length.begin() + i + 1);
+
+        // keys of the first run not greater than the first key of the second are already in place
+        int k = gallop_right(a[base2], a, base1, len1, 0, cmp);
+        base1 += k;
+        len1 -= k;
+        if (len1 == 0) return;
+
+        // and so are keys of the second run not less than the last key of the first
+        len2 = gallop_left(a[base1 + len1 - 1], a, base2, len2, len2 - 1, cmp);
+        if (len2 == 0) return;
+
+        if (len1 <= len2) merge_lo(a, state, base1, len1, base2, len2, cmp);
+        else              merge_hi(a, state, base1, len1, base2, len2, cmp);
+    }
+
+   /***************************************************************************
+    *  Galloping: exponential search from a hint, then binary search.
+    ***************************************************************************/
+
+    // number of keys of s[base .. base+len-1] that are less than key
+    template <typename Less>
+    static int gallop_left(const T& key, const std::vector<T>& s, int base, int len, int hint, Less cmp)
+    {
+        int last = 0, ofs = 1;
+        if (less(s[base + hint], key, cmp))
+        {
+            int max_ofs = len - hint;
+            while (ofs < max_ofs && less(s[base + hint + ofs], key, cmp))
+            {
+                last = ofs;
+                ofs = (ofs << 1) + 1;
+                if (ofs <= 0) ofs = max_ofs;
+            }
+            if (ofs > max_ofs) ofs = max_ofs;
+            last += hint;
+            ofs += hint;
+        }
+        else
+        {
+            int max_ofs = hint + 1;
+            while (ofs < max_ofs && !less(s[base + hint - ofs], key, cmp))
+            {
+                last = ofs;
+                ofs = (ofs << 1) + 1;
+                if (ofs <= 0) ofs = max_ofs;
+            }
+            if (ofs > max_ofs) ofs = max_ofs;
+            int tmp = last;
+            last = hint - ofs;
+            ofs = hint - tmp;
+        }
+
+        // s[base + last] < key <= s[base + ofs]
+        last++;
+        while (last < ofs)
+        {
+            int mid = last + (ofs - last) / 2;
+            if (less(s[base + mid], key, cmp)) last = mid + 1;
+            else                               ofs = mid;
+        }
+        return ofs;
+    }
+
+    // number of keys of s[base .. base+len-1] that are not greater than key
+    template <typename Less>
+    static int gallop_right(const T& key, const std::vector<T>& s, int base, int len, int hint, Less cmp)
+    {
+        int last = 0, ofs = 1;
+        if (less(key, s[base + hint], cmp))
+        {
+            int max_ofs = hint + 1;
+            while (ofs < max_ofs && less(key, s[base + hint - ofs], cmp))
+            {
+                last = ofs;
+                ofs = (ofs << 1) + 1;
+                if (ofs <= 0) ofs = max_ofs;
+            }
+            if (ofs > max_ofs) ofs = max_ofs;
+            int tmp = last;
+            last = hint - ofs;
+            ofs = hint - tmp;
+        }
+        else
+        {
+            int max_ofs = len - hint;
+            while (ofs < max_ofs && !less(key, s[base + hint + ofs], cmp))
+            {
+                last = ofs;
+                ofs = (ofs << 1) + 1;
+                if (ofs <= 0) ofs = max_ofs;
+            }
+            if (ofs > max_ofs) ofs = max_ofs;
+            last += hint;
+            ofs += hint;
+        }
 
-        // copy to aux[]
-        for (int k = lo; k <= hi; k++)
+        // s[base + last] <= key < s[base + ofs]
+        last++;
+        while (last < ofs)
         {
-            aux[k] = a[k];
+            int mid = last + (ofs - last) / 2;
+            if (less(key, s[base + mid], cmp)) ofs = mid;
+            else                               last = mid + 1;
         }
+        return ofs;
+    }
+
+   /***************************************************************************
+    *  Merges. The shorter run is moved to aux[] and merged with the other in
+    *  place, one key at a time until one run wins MIN_GALLOP times in a row,
+    *  then by galloping until the wins become short again.
+    ***************************************************************************/
+
+    // stably merge a[base1 .. base1+len1-1] with the following run, len1 <= len2,
+    // where a[base2] < a[base1] and a[base1+len1-1] > a[base2+len2-1]
+    template <typename Less>
+    static void merge_lo(std::vector<T>& a, MergeState& state, int base1, int len1, int base2, int len2, Less cmp)
+    {
+        std::vector<T>& aux = state.aux;
+        if (aux.size() < len1) aux.resize(len1);
+        std::move(a.begin() + base1, a.begin() + base1 + len1, aux.begin());
 
-        // merge back to a[]
-        int i = lo, j = mid+1;
-        for (int k = lo; k <= hi; k++)
+        int cursor1 = 0, cursor2 = base2, dest = base1;
+        a[dest++] = std::move(a[cursor2++]);
+        if (--len2 == 0)
         {
-            if      (i > mid)              a[k] = aux[j++];  // this copying is unnecessary
-            else if (j > hi)               a[k] = aux[i++];
-            else if (less(aux[j], aux[i])) a[k] = aux[j++];
-            else                           a[k] = aux[i++];
+            std::move(aux.begin() + cursor1, aux.begin() + cursor1 + len1, a.begin() + dest);
+            return;
         }
+        if (len1 == 1)
+        {
+            std::move(a.begin() + cursor2, a.begin() + cursor2 + len2, a.begin() + dest);
+            a[dest + len2] = std::move(aux[cursor1]);
+            return;
+        }
+
+        int min_gallop = state.min_gallop;
+        while (true)
+        {
+            int count1 = 0, count2 = 0;     // times in a row each run won
+
+            // one key at a time
+            do
+            {
+                if (less(a[cursor2], aux[cursor1], cmp))
+                {
+                    a[dest++] = std::move(a[cursor2++]);
+                    count2++;
+                    count1 = 0;
+                    if (--len2 == 0) goto done;
+                }
+                else
+                {
+                    a[dest++] = std::move(aux[cursor1++]);
+                    count1++;
+                    count2 = 0;
+                    if (--len1 == 1) goto done;
+                }
+            } while ((count1 | count2) < min_gallop);
+
+            // galloping
+            do
+            {
+                count1 = gallop_right(a[cursor2], aux, cursor1, len1, 0, cmp);
+                if (count1 != 0)
+                {
+                    std::move(aux.begin() + cursor1, aux.begin() + cursor1 + count1, a.begin() + dest);
+                    dest += count1;
+                    cursor1 += count1;
+                    len1 -= count1;
+                    if (len1 <= 1) goto done;
+                }
+                a[dest++] = std::move(a[cursor2++]);
+                if (--len2 == 0) goto done;
 
+                count2 = gallop_left(aux[cursor1], a, cursor2, len2, 0, cmp);
+                if (count2 != 0)
+                {
+                    std::move(a.begin() + cursor2, a.begin() + cursor2 + count2, a.begin() + dest);
+                    dest += count2;
+                    cursor2 += count2;
+                    len2 -= count2;
+                    if (len2 == 0) goto done;
+                }
+                a[dest++] = std::move(aux[cursor1++]);
+                if (--len1 == 1) goto done;
+                min_gallop--;
+            } while (count1 >= MIN_GALLOP || count2 >= MIN_GALLOP);
+
+            // penalize leaving gallop mode
+            if (min_gallop < 0) min_gallop = 0;
+            min_gallop += 2;
+        }
+
+    done:
+        state.min_gallop = std::max(1, min_gallop);
+        if (len1 == 1)
+        {
+            std::move(a.begin() + cursor2, a.begin() + cursor2 + len2, a.begin() + dest);
+            a[dest + len2] = std::move(aux[cursor1]);
+        }
+        else if (len1 == 0)
+        {
+            error("Comparison method violates its general contract");
+        }
+        else
+        {
+            std::move(aux.begin() + cursor1, aux.begin() + cursor1 + len1, a.begin() + dest);
+        }
+    }
+
+    // like merge_lo(), but moves the second run to aux[] and merges from the right, len1 >= len2
+    template <typename Less>
+    static void merge_hi(std::vector<T>& a, MergeState& state, int base1, int len1, int base2, int len2, Less cmp)
+    {
+        std::vector<T>& aux = state.aux;
+        if (aux.size() < len2) aux.resize(len2);
+        std::move(a.begin() + base2, a.begin() + base2 + len2, aux.begin());
+
+        int cursor1 = base1 + len1 - 1, cursor2 = len2 - 1, dest = base2 + len2 - 1;
+        a[dest--] = std::move(a[cursor1--]);
+        if (--len1 == 0)
+        {
+            std::move(aux.begin(), aux.begin() + len2, a.begin() + dest - (len2 - 1));
+            return;
+        }
+        if (len2 == 1)
+        {
+            dest -= len1;
+            cursor1 -= len1;
+            std::move_backward(a.begin() + cursor1 + 1, a.begin() + cursor1 + 1 + len1, a.begin() + dest + 1 + len1);
+            a[dest] = std::move(aux[cursor2]);
+            return;
+        }
+
+        int min_gallop = state.min_gallop;
+        while (true)
+        {
+            int count1 = 0, count2 = 0;     // times in a row each run won
+
+            // one key at a time
+            do
+            {
+                if (less(aux[cursor2], a[cursor1], cmp))
+                {
+                    a[dest--] = std::move(a[cursor1--]);
+                    count1++;
+                    count2 = 0;
+                    if (--len1 == 0) goto done;
+                }
+                else
+                {
+                    a[dest--] = std::move(aux[cursor2--]);
+                    count2++;
+                    count1 = 0;
+                    if (--len2 == 1) goto done;
+                }
+            } while ((count1 | count2) < min_gallop);
+
+            // galloping
+            do
+            {
+                count1 = len1 - gallop_right(aux[cursor2], a, base1, len1, len1 - 1, cmp);
+                if (count1 != 0)
+                {
+                    dest -= count1;
+                    cursor1 -= count1;
+                    len1 -= count1;
+                    std::move_backward(a.begin() + cursor1 + 1, a.begin() + cursor1 + 1 + count1, a.begin() + dest + 1 + count1);
+                    if (len1 == 0) goto done;
+                }
+                a[dest--] = std::move(aux[cursor2--]);
+                if (--len2 == 1) goto done;
+
+                count2 = len2 - gallop_left(a[cursor1], aux, 0, len2, len2 - 1, cmp);
+                if (count2 != 0)
+                {
+                    dest -= count2;
+                    cursor2 -= count2;
+                    len2 -= count2;
+                    std::move(aux.begin() + cursor2 + 1, aux.begin() + cursor2 + 1 + count2, a.begin() + dest + 1);
+                    if (len2 <= 1) goto done;
+                }
+                a[dest--] = std::move(a[cursor1--]);
+                if (--len1 == 0) goto done;
+                min_gallop--;
+            } while (count1 >= MIN_GALLOP || count2 >= MIN_GALLOP);
+
+            // penalize leaving gallop mode
+            if (min_gallop < 0) min_gallop = 0;
+            min_gallop += 2;
+        }
+
+    done:
+        state.min_gallop = std::max(1, min_gallop);
+        if (len2 == 1)
+        {
+            dest -= len1;
+            cursor1 -= len1;
+            std::move_backward(a.begin() + cursor1 + 1, a.begin() + cursor1 + 1 + len1, a.begin() + dest + 1 + len1);
+            a[dest] = std::move(aux[cursor2]);
+        }
+        else if (len2 == 0)
+        {
+            error("Comparison method violates its general contract");
+        }
+        else
+        {
+            std::move(aux.begin(), aux.begin() + len2, a.begin() + dest - (len2 - 1));
+        }
     }
 
-    /***********************************************************************
+   /***********************************************************************
     *  Helper sorting functions.
     ***************************************************************************/
 
     // is v < w ?
-    static bool less(T v, T w)
+    template <typename Less>
+    static bool less(const T& v, const T& w, Less cmp)
     {
-        return v < w;
+        return cmp(v, w);
     }
 
 
    /***************************************************************************
     *  Check if array is sorted - useful for debugging.
     ***************************************************************************/
-    static bool is_sorted(std::vector<T>& a)
+    template <typename Less>
+    static bool is_sorted(std::vector<T>& a, Less cmp)
     {
         for (int i = 1; i < a.size(); i++)
-            if (less(a[i], a[i-1])) return false;
+            if (less(a[i], a[i-1], cmp)) return false;
         return true;
     }
 };
@@ -1,6 +1,9 @@
 #ifndef MERGEX_H
 #define MERGEX_H
 
+#include "ParallelMerge.h"
+#include "SortCutoffs.h"
+#include "SortingNetwork.h"
 #include "StdOut.h"
 
 /******************************************************************************
@@ -38,6 +41,9 @@
  *  This sorting algorithm is stable.
  *  It uses &Theta;(<em>n</em>) extra memory (not including the input array).
  *  <p>
+ *  The {@code parallel_sort} methods sort subarrays and split merges
+ *  across the shared {@link ThreadPool}; see {@link ParallelMerge}.
+ *  <p>
  *  For additional documentation, see
  *  <a href="https://algs4.cs.princeton.edu/22mergesort">Section 2.2</a> of
  *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
@@ -45,7 +51,7 @@
  *  @author Robert Sedgewick
  *  @author Kevin Wayne
  */
-template <typename T>
+template <typename T, typename Compare = std::less<T>>
 class MergeX
 {
 public: 
@@ -55,67 +61,23 @@ public:
      */
     static void sort(std::vector<T>& a)
     {
-        std::vector<T> aux = std::vector<T>(a.begin(), a.end());
-        sort(aux, a, 0, a.size()-1);
-        assert(is_sorted(a));
-    }
-
-    // print array to standard output
-    static void show(std::vector<T>& a)
-    {
-        for (int i = 0; i < a.size(); i++)
-        {
-            StdOut::println(a[i]);
-        }
-    }
-
-private:
-    static const int CUTOFF = 7;  // cutoff to insertion sort
-
-    static void merge(std::vector<T>& src, std::vector<T>& dst, int lo, int mid, int hi) {
-
-        // precondition: src[lo .. mid] and src[mid+1 .. hi] are sorted subarrays
-        assert(is_sorted(src, lo, mid));
-        assert(is_sorted(src, mid+1, hi));
-
-        int i = lo, j = mid+1;
-        for (int k = lo; k <= hi; k++)
-        {
-            if      (i > mid)              dst[k] = src[j++];
-            else if (j > hi)               dst[k] = src[i++];
-            else if (less(src[j], src[i])) dst[k] = src[j++];   // to ensure stability
-            else                           dst[k] = src[i++];
-        }
-
-        // postcondition: dst[lo .. hi] is sorted subarray
-        assert(is_sorted(dst, lo, hi));
+        sort(a, Compare());
     }
 
-    static void sort(std::vector<T>& src, std::vector<T>& dst, int lo, int hi)
+    /**
+     * Rearranges the array in ascending order, using the provided order.
+     *
+     * @param a the array to be sorted
+     * @param cmp the comparator that defines the total order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void sort(std::vector<T>& a, Less cmp)
     {
-        // if (hi <= lo) return;
-        if (hi <= lo + CUTOFF)
-        {
-            insertion_sort(dst, lo, hi);
-            return;
-        }
-        int mid = lo + (hi - lo) / 2;
-        sort(dst, src, lo, mid);
-        sort(dst, src, mid+1, hi);
-
-        if (!less(src[mid+1], src[mid]))
-        {
-            std::copy(src.begin() + lo, src.begin() + hi + 1, dst.begin() + lo);
-            return;
-        }
-
-        merge(src, dst, lo, mid, hi);
+        std::vector<T> aux = std::vector<T>(a.begin(), a.end());
+        sort(aux, a, 0, a.size()-1, cmp);
+        assert(is_sorted(a, cmp));
     }
 
-    /*******************************************************************
-     *  Version that takes Comparator as argument.
-     *******************************************************************/
-
     /**
      * Rearranges the array in ascending order, using the provided order.
      *
@@ -124,51 +86,59 @@ private:
      */
     static void sort(std::vector<T>& a, cmp_func)
     {
-        std::vector<T> aux = a.clone();
-        sort(aux, a, 0, a.size()-1, cmp);
-        assert(is_sorted(a, cmp));
+        sort<bool(*)(T, T)>(a, cmp);
     }
 
-private:
-    // sort from a[lo] to a[hi] using insertion sort
-    static void insertion_sort(std::vector<T>& a, int lo, int hi)
+    /**
+     * Rearranges the array in ascending order, using the natural order,
+     * sorting independent subarrays and merge pieces in parallel.
+     * @param a the array to be sorted
+     */
+    static void parallel_sort(std::vector<T>& a)
     {
-        for (int i = lo; i <= hi; i++)
-            for (int j = i; j > lo && less(a[j], a[j-1]); j--)
-                exch(a, j, j-1);
+        parallel_sort(a, Compare());
     }
 
-
-    /*******************************************************************
-     *  Utility methods.
-     *******************************************************************/
-
-    // exchange a[i] and a[j]
-    static void exch(std::vector<T>& a, int i, int j)
+    /**
+     * Rearranges the array in ascending order, using the provided order,
+     * sorting independent subarrays and merge pieces in parallel.
+     *
+     * @param a the array to be sorted
+     * @param cmp the comparator that defines the total order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void parallel_sort(std::vector<T>& a, Less cmp)
     {
-        T swap = a[i];
-        a[i] = a[j];
-        a[j] = swap;
+        ParallelMerge::sort(a, cmp);
+        assert(is_sorted(a, cmp));
     }
 
-    // is a[i] < a[j]?
-    static bool less(T a, T b)
+    /**
+     * Rearranges the array in ascending order, using the provided order,
+     * sorting independent subarrays and merge pieces in parallel.
+     *
+     * @param a the array to be sorted
+     * @param comparator the comparator that defines the total order
+     */
+    static void parallel_sort(std::vector<T>& a, cmp_func)
     {
-        return a < b;
+        parallel_sort<bool(*)(T, T)>(a, cmp);
     }
 
-    // is a[i] < a[j]?
-    static bool less(T a, T b, cmp_func)
+    // print array to standard output
+    static void show(std::vector<T>& a)
     {
-        return (*cmp)(a, b);
+        for (int i = 0; i < a.size(); i++)
+        {
+            StdOut::println(a[i]);
+        }
     }
 
+private:
+    static const int CUTOFF = SortCutoffs::of<T>.merge;  // cutoff to insertion sort
 
-    /*******************************************************************
-     *  Version that takes Comparator as argument.
-     *******************************************************************/
-
-    static void merge(std::vector<T>& src, std::vector<T>& dst, int lo, int mid, int hi, cmp_func)
+    template <typename Less>
+    static void merge(std::vector<T>& src, std::vector<T>& dst, int lo, int mid, int hi, Less cmp)
     {
 
         // precondition: src[lo .. mid] and src[mid+1 .. hi] are sorted subarrays
@@ -178,21 +148,24 @@ private:
         int i = lo, j = mid+1;
         for (int k = lo; k <= hi; k++)
         {
-            if      (i > mid)                          dst[k] = src[j++];
-            else if (j > hi)                           dst[k] = src[i++];
-            else if (less(src[j], src[i], cmp)) dst[k] = src[j++];
-            else                                       dst[k] = src[i++];
+            if      (i > mid)                   dst[k] = src[j++];
+            else if (j > hi)                    dst[k] = src[i++];
+            else if (less(src[j], src[i], cmp)) dst[k] = src[j++];   // to ensure stability
+            else                                dst[k] = src[i++];
         }
 
         // postcondition: dst[lo .. hi] is sorted subarray
         assert(is_sorted(dst, lo, hi, cmp));
     }
 
-    static void sort(std::vector<T>& src, std::vector<T>& dst, int lo, int hi, cmp_func)
+    template <typename Less>
+    static void sort(std::vector<T>& src, std::vector<T>& dst, int lo, int hi, Less cmp)
     {
-        if (hi <= lo + CUTOFF)
+        // if (hi <= lo) return;
+        if (hi <= lo + SortingNetwork::cutoff<T, Less>(CUTOFF))
         {
-            insertion_sort(dst, lo, hi, cmp);
+            if constexpr (SortingNetwork::applies<T, Less>) SortingNetwork::sort(dst, lo, hi);
+            else                                            insertion_sort(dst, lo, hi, cmp);
             return;
         }
         int mid = lo + (hi - lo) / 2;
@@ -202,14 +175,16 @@ private:
         // using System.arraycopy() is a bit faster than the above loop
         if (!less(src[mid+1], src[mid], cmp))
         {
-            std::copy(src.begin() + lo, src.begin() + hi + 1, dst.begin() + lo);            return;
+            std::copy(src.begin() + lo, src.begin() + hi + 1, dst.begin() + lo);
+            return;
         }
 
         merge(src, dst, lo, mid, hi, cmp);
     }
 
     // sort from a[lo] to a[hi] using insertion sort
-    static void insertion_sort(std::vector<T>& a, int lo, int hi, cmp_func)
+    template <typename Less>
+    static void insertion_sort(std::vector<T>& a, int lo, int hi, Less cmp)
     {
         for (int i = lo; i <= hi; i++)
             for (int j = i; j > lo && less(a[j], a[j-1], cmp); j--)
@@ -217,27 +192,36 @@ private:
     }
 
 
-   /***************************************************************************
-    *  Check if array is sorted - useful for debugging.
-    ***************************************************************************/
-    static bool is_sorted(std::vector<T>& a)
+    /*******************************************************************
+     *  Utility methods.
+     *******************************************************************/
+
+    // exchange a[i] and a[j]
+    static void exch(std::vector<T>& a, int i, int j)
     {
-        return is_sorted(a, 0, a.size() - 1);
+        using std::swap;
+        swap(a[i], a[j]);
     }
 
-    static bool is_sorted(std::vector<T>& a, int lo, int hi)
+    // is a[i] < a[j]?
+    template <typename Less>
+    static bool less(const T& a, const T& b, Less cmp)
     {
-        for (int i = lo + 1; i <= hi; i++)
-            if (less(a[i], a[i-1])) return false;
-        return true;
+        return cmp(a, b);
     }
 
-    static bool is_sorted(std::vector<T>& a, cmp_func)
+
+   /***************************************************************************
+    *  Check if array is sorted - useful for debugging.
+    ***************************************************************************/
+    template <typename Less>
+    static bool is_sorted(std::vector<T>& a, Less cmp)
     {
         return is_sorted(a, 0, a.size() - 1, cmp);
     }
 
-    static bool is_sorted(std::vector<T>& a, int lo, int hi, cmp_func)
+    template <typename Less>
+    static bool is_sorted(std::vector<T>& a, int lo, int hi, Less cmp)
     {
         for (int i = lo + 1; i <= hi; i++)
             if (less(a[i], a[i-1], cmp)) return false;
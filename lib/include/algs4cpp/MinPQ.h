@@ -1,22 +1,22 @@
 #ifndef MINPQ_H
 #define MINPQ_H
 
+#include "DaryHeap.h"
+
 /******************************************************************************
  *  Compilation:  javac MinPQ.java
  *  Execution:    java MinPQ < input.txt
  *  Dependencies: StdIn.java StdOut.java
  *  Data files:   https://algs4.cs.princeton.edu/24pq/tinyPQ.txt
  *
- *  Generic min priority queue implementation with a binary heap.
+ *  Generic min priority queue implementation with a d-ary heap.
  *  Can be used with a comparator instead of the natural order.
  *
  *  % java MinPQ < tinyPQ.txt
  *  E A E (6 left on pq)
  *
- *  We use a one-based array to simplify parent and child calculations.
- *
- *  Can be optimized by replacing full exchanges with half exchanges
- *  (ala insertion sort).
+ *  We store the keys by value in a zero-based array, and move them
+ *  into a hole instead of exchanging them (ala insertion sort).
  *
  ******************************************************************************/
 
@@ -27,7 +27,7 @@
  *  testing if the priority queue is empty, and iterating through
  *  the keys.
  *  <p>
- *  This implementation uses a <em>binary heap</em>.
+ *  This implementation uses a <em>d-ary heap</em>, binary by default.
  *  The <em>insert</em> and <em>delete-the-minimum</em> operations take
  *  &Theta;(log <em>n</em>) amortized time, where <em>n</em> is the number
  *  of elements in the priority queue. This is an amortized bound
@@ -37,6 +37,18 @@
  *  Construction takes time proportional to the specified capacity or the
  *  number of items used to initialize the data structure.
  *  <p>
+ *  The keys are stored by value in one contiguous array, so inserting a key
+ *  allocates nothing but the occasional doubling of the array, and a compare
+ *  reads two neighbouring keys rather than two keys anywhere in memory.
+ *  Keys are moved into place, never copied, and {@code emplace()} constructs
+ *  a key in the array. With a branching factor {@code D} of 4 or 8 the
+ *  heap is two or three times shallower, and the <em>D</em> children of a
+ *  node are adjacent: swims take fewer steps, and each level of a sink reads
+ *  one group of children. Removing the minimum sinks the last key by moving
+ *  the smallest child up into the hole all the way to a leaf, then sifting
+ *  the key back up the short distance to its place (bottom-up heapsort's
+ *  sink), one compare per child instead of one more per level.
+ *  <p>
  *  For additional documentation, see
  *  <a href="https://algs4.cs.princeton.edu/24pq">Section 2.4</a> of
  *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
@@ -45,8 +57,10 @@
  *  @author Kevin Wayne
  *
  *  @param <Key> the generic type of key on this priority queue
+ *  @param <Compare> the type of the functor ordering the keys, {@code std::less<Key>} by default
+ *  @param <D> the number of children of a node, 2 by default
  */
-template <typename Key>
+template <typename Key, typename Compare = std::less<Key>, int D = 2>
 class MinPQ
 {
 public:
@@ -57,8 +71,8 @@ public:
      */
     MinPQ(int init_capacity)
     {
-        m_pq = std::vector<ptr<Key>>(init_capacity + 1);
-        m_n = 0;
+        static_assert(D >= 2, "a heap node has at least two children");
+        m_pq.reserve(init_capacity);
         m_cmp = nullptr;
     }
 
@@ -76,11 +90,9 @@ public:
      * @param  init_capacity the initial capacity of this priority queue
      * @param  cmp the order in which to compare the keys
      */
-    MinPQ(int init_capacity, bool (*cmp)(Key*, Key*))
+    MinPQ(int init_capacity, bool (*cmp)(Key*, Key*)) : MinPQ(init_capacity)
     {
         m_cmp = cmp;
-        m_pq = std::vector<ptr<Key>>(init_capacity + 1);
-        m_n = 0;
     }
 
     /**
@@ -93,48 +105,52 @@ public:
     }
 
     /**
-     * Initializes a priority queue from the array of keys.
-     * <p>
-     * Takes time proportional to the number of keys, using sink-based heap construction.
+     * Initializes an empty priority queue with the given initial capacity,
+     * ordering the keys with the given functor.
      *
-     * @param  keys the array of keys
+     * @param  init_capacity the initial capacity of this priority queue
+     * @param  compare the functor ordering the keys
      */
-    MinPQ(std::vector<ptr<Key>> keys)
+    MinPQ(int init_capacity, Compare compare) : MinPQ(init_capacity)
     {
-        m_n = keys.size();
-        m_cmp = nullptr;
-        m_pq = std::vector<ptr<Key>>(keys.size() + 1);
-        std::copy(keys.begin(), keys.end(), m_pq.begin() + 1);
+        m_compare = compare;
+    }
 
-        for (int k = m_n/2; k >= 1; k--)
-            sink(k);
-        assert(is_min_heap());
+    /**
+     * Initializes an empty priority queue, ordering the keys with the given functor.
+     *
+     * @param  compare the functor ordering the keys
+     */
+    MinPQ(Compare compare) : MinPQ(1, compare)
+    {
     }
 
     /**
-     * Copy constructor.
-     * 
-     * @param other the MaxPQ to copy from
+     * Initializes a priority queue from the array of keys, taking over its storage.
+     * <p>
+     * Takes time proportional to the number of keys, using sink-based heap construction.
+     *
+     * @param  keys the array of keys
      */
-    MinPQ(const MinPQ<Key>& other) : 
-        m_n(other.m_n), m_cmp(other.m_cmp) 
+    MinPQ(std::vector<Key> keys) : m_pq(std::move(keys)), m_cmp(nullptr)
     {
-        m_pq = std::vector<ptr<Key>>();
-        copy_ptrs<Key>(m_pq, other.m_pq);
+        heapify();
     }
-        
+
     /**
-     * Assigment operator.
-     * 
-     * @param other the MaxPQ to assign from
+     * Initializes a priority queue from the array of keys, copying each key
+     * out of its allocation.
+     * <p>
+     * Takes time proportional to the number of keys, using sink-based heap construction.
+     *
+     * @param  keys the array of keys
      */
-    MinPQ& operator=(const MinPQ<Key>& other)
+    MinPQ(const std::vector<ptr<Key>>& keys) : m_cmp(nullptr)
     {
-        m_n = other.m_n;
-        m_cmp = other.m_cmp;
-        m_pq = std::vector<ptr<Key>>();
-        copy_ptrs<Key>(m_pq, other.m_pq);
-        return *this;
+        m_pq.reserve(keys.size());
+        for (const ptr<Key>& key : keys)
+            m_pq.push_back(*key);
+        heapify();
     }
 
     /**
@@ -145,7 +161,7 @@ public:
      */
     bool is_empty() const
     {
-        return m_n == 0;
+        return m_pq.empty();
     }
 
     /**
@@ -155,7 +171,7 @@ public:
      */
     int size() const
     {
-        return m_n;
+        return m_pq.size();
     }
 
     /**
@@ -164,10 +180,10 @@ public:
      * @return a smallest key on this priority queue
      * @throws NoSuchElementException if this priority queue is empty
      */
-    Key min() const
+    const Key& min() const
     {
         if (is_empty()) error("Priority queue underflow");
-        return m_pq[1];
+        return m_pq[0];
     }
 
     /**
@@ -175,14 +191,32 @@ public:
      *
      * @param  x the key to add to this priority queue
      */
-    void insert(Key x)
+    void insert(const Key& x)
+    {
+        emplace(x);
+    }
+
+    /**
+     * Adds a new key to this priority queue, moving it in.
+     *
+     * @param  x the key to add to this priority queue
+     */
+    void insert(Key&& x)
     {
-        // double size of array if necessary
-        if (m_n == m_pq.size() - 1) resize(2 * m_pq.size());
+        emplace(std::move(x));
+    }
 
-        // add x, and percolate it up to maintain heap invariant
-        m_pq[++m_n] = alloc<Key>(x);
-        swim(m_n);
+    /**
+     * Adds a new key, constructed in place from the arguments, to this priority queue.
+     *
+     * @param  args the arguments of a constructor of the key
+     */
+    template <typename... Args>
+    void emplace(Args&&... args)
+    {
+        // add the key, and percolate it up to maintain heap invariant
+        m_pq.emplace_back(std::forward<Args>(args)...);
+        swim(m_pq.size() - 1);
         assert(is_min_heap());
     }
 
@@ -195,96 +229,216 @@ public:
     Key del_min()
     {
         if (is_empty()) error("Priority queue underflow");
-        Key min = *(m_pq[1]);
-        exch(1, m_n--);
-        sink(1);
-        m_pq[m_n+1].reset();     // to avoid loitering and help with garbage collection
-        if ((m_n > 0) && (m_n == (m_pq.size() - 1) / 4)) resize(m_pq.size() / 2);
+        Key min = std::move(m_pq[0]);
+        Key last = std::move(m_pq.back());
+        m_pq.pop_back();
+        if (!is_empty()) sink(0, std::move(last));
         assert(is_min_heap());
         return min;
     }
 
-private:
-    std::vector<ptr<Key>> m_pq;       // store items at indices 1 to n
-    int m_n;                     // number of items on priority queue
-    bool(*m_cmp)(Key*, Key*);      // optional comparator
-
-    // resize the underlying array to have the given capacity
-    void resize(int capacity)
+    /**
+     * Removes and returns a smallest key on this priority queue, putting
+     * {@code x} in its place with a single sink: an insert and a
+     * delete-the-minimum for the price of one, as a stream that keeps
+     * its m largest keys needs.
+     *
+     * @param  x the key to add to this priority queue
+     * @return a smallest key on this priority queue before {@code x} was added
+     * @throws NoSuchElementException if this priority queue is empty
+     */
+    Key replace_min(Key x)
     {
-        assert(capacity > m_n);
-        m_pq.resize(capacity);
+        if (is_empty()) error("Priority queue underflow");
+        Key min = std::move(m_pq[0]);
+        sink(0, std::move(x));
+        assert(is_min_heap());
+        return min;
     }
 
-   /***************************************************************************
-    * Helper functions to restore the heap invariant.
-    ***************************************************************************/
+    /**
+     * Adds the keys in [first, last) to this priority queue. The keys are
+     * swum up one by one as long as they climb little, as random keys do.
+     * Once they climb more than {@code SWIM_LEVELS} levels each on average,
+     * the heap order is restored bottom-up over the ancestors of the rest of
+     * the batch only, as heap construction does: in time linear in the size
+     * of the batch, plus the square of the height.
+     *
+     * @param  first an iterator to the first key to add
+     * @param  last an iterator past the last key to add
+     */
+    template <typename It>
+    void insert_range(It first, It last)
+    {
+        int n = size();
+        for (; first != last; ++first)
+            m_pq.emplace_back(*first);
+
+        if (n == 0)
+        {
+            heapify();
+            assert(is_min_heap());
+            return;
+        }
 
-    void swim(int k)
+        // swim the new keys while they climb at most SWIM_LEVELS levels each on average
+        long long budget = height();
+        int i = n;
+        for (; i < size() && budget >= 0; i++)
+            budget += SWIM_LEVELS - swim(i);
+        if (i < size())
+        {
+            // the parents of the rest, then their parents, up to the root
+            int lo = (i - 1) / D, hi = (size() - 2) / D;
+            while (true)
+            {
+                for (int j = hi; j >= lo; j--)
+                    sink(j, std::move(m_pq[j]));
+                if (lo == 0) break;
+                lo = (lo - 1) / D;
+                hi = (hi - 1) / D;
+            }
+        }
+        assert(is_min_heap());
+    }
+
+    /**
+     * Removes the {@code k} smallest keys on this priority queue, appending
+     * them to {@code keys} in ascending order. Few keys are removed one at a
+     * time. When {@code k} delete-the-minimums would cost more than a pass
+     * over the heap, the {@code k} smallest keys are selected in one pass,
+     * sorted, and the heap rebuilt from the rest, in time linear in the size
+     * of the heap plus <em>k</em> log <em>k</em>.
+     *
+     * @param  k the number of keys to remove
+     * @param  keys the array to append the keys removed to
+     * @throws IllegalArgumentException unless {@code 0 <= k <= size()}
+     */
+    void pop_k(int k, std::vector<Key>& keys)
     {
-        while (k > 1 && greater(k/2, k))
+        if (k < 0 || k > size()) error("cannot remove {} keys of {}", k, size());
+        if ((long long) k * height() < size())
         {
-            exch(k/2, k);
-            k = k/2;
+            for (int i = 0; i < k; i++)
+                keys.push_back(del_min());
+            return;
         }
+
+        auto before = [this](const Key& v, const Key& w) { return greater(w, v); };
+        std::nth_element(m_pq.begin(), m_pq.begin() + k, m_pq.end(), before);
+        std::sort(m_pq.begin(), m_pq.begin() + k, before);
+        std::move(m_pq.begin(), m_pq.begin() + k, std::back_inserter(keys));
+        m_pq.erase(m_pq.begin(), m_pq.begin() + k);
+        heapify();
     }
 
-    void sink(int k)
+    /**
+     * Returns the number of keys on this priority queue that are strictly less
+     * than {@code key}. Visits only those keys and their children, as the keys
+     * below a key at least {@code key} are at least {@code key} too.
+     *
+     * @param  key the key
+     * @return the number of keys on this priority queue less than {@code key}
+     */
+    int rank(const Key& key) const
     {
-        while (2*k <= m_n)
+        int rank = 0;
+        std::vector<int> stack = std::vector<int>();
+        if (!is_empty()) stack.push_back(0);
+        while (!stack.empty())
         {
-            int j = 2*k;
-            if (j < m_n && greater(j, j+1)) j++;
-            if (!greater(k, j)) break;
-            exch(k, j);
-            k = j;
+            int k = stack.back();
+            stack.pop_back();
+            if (!greater(key, m_pq[k])) continue;
+            rank++;
+            for (int c = D * k + 1; c <= D * k + D && c < size(); c++)
+                stack.push_back(c);
         }
+        return rank;
     }
 
+private:
+    static const int SWIM_LEVELS = 2;  // levels a key of a batch may climb on average before the rest is heapified
+
+    std::vector<Key> m_pq;          // store items at indices 0 to n-1
+    bool(*m_cmp)(Key*, Key*);       // optional comparator
+    Compare m_compare;              // order of the keys when m_cmp is not given
+
    /***************************************************************************
-    * Helper functions for compares and swaps.
+    * Helper functions to restore the heap invariant.
+    * The children of node k are D*k + 1 through D*k + D.
     ***************************************************************************/
-    bool greater(int i, int j) const
+
+    // levels of the heap
+    int height() const
     {
-        if (m_cmp == nullptr)
+        int levels = 0;
+        for (long long nodes = 0, level = 1; nodes < size(); level *= D)
         {
-            return *(m_pq[i]) > *(m_pq[j]);
+            nodes += level;
+            levels++;
         }
-        else
+        return levels;
+    }
+
+    void heapify()
+    {
+        for (int k = (size() - 2) / D; k >= 0; k--)
+            sink(k, std::move(m_pq[k]));
+        assert(is_min_heap());
+    }
+
+    // move the key at k up into the hole left by each larger parent; returns the levels it climbed
+    int swim(int k)
+    {
+        if (k == 0 || !greater(m_pq[(k - 1) / D], m_pq[k])) return 0;
+        Key x = std::move(m_pq[k]);
+        int levels = 0;
+        do
         {
-            return (*m_cmp)(m_pq[i].get(), m_pq[j].get());
-        }
+            int parent = (k - 1) / D;
+            m_pq[k] = std::move(m_pq[parent]);
+            k = parent;
+            levels++;
+        } while (k > 0 && greater(m_pq[(k - 1) / D], x));
+        m_pq[k] = std::move(x);
+        return levels;
     }
 
-    void exch(int i, int j)
+    // put x in the hole at k: move the smallest child up into the hole all
+    // the way down to a leaf, then sift x up from there
+    void sink(int k, Key x)
     {
-        std::swap(m_pq[i], m_pq[j]);
+        // the choice of comparator is made once, not at every compare
+        if (m_cmp == nullptr)
+            DaryHeap::sink<D>(m_pq.data(), k, size(), std::move(x),
+                [cmp = m_compare](const Key& v, const Key& w) { return cmp(w, v); });
+        else
+            DaryHeap::sink<D>(m_pq.data(), k, size(), std::move(x),
+                [this](const Key& v, const Key& w) { return greater(v, w); });
     }
 
-    // is pq[1..n] a min heap?
-    bool is_min_heap() const
+   /***************************************************************************
+    * Helper functions for compares.
+    ***************************************************************************/
+    bool greater(const Key& v, const Key& w) const
     {
-        for (int i = 1; i <= m_n; i++)
+        if (m_cmp == nullptr)
         {
-            if (m_pq[i] == nullptr) return false;
+            return m_compare(w, v);
         }
-        for (int i = m_n+1; i < m_pq.size(); i++)
+        else
         {
-            if (m_pq[i] != nullptr) return false;
+            return (*m_cmp)(const_cast<Key*>(&v), const_cast<Key*>(&w));
         }
-        if (m_pq[0] != nullptr) return false;
-        return is_min_heap_ordered(1);
     }
 
-    // is subtree of pq[1..n] rooted at k a min heap?
-    bool is_min_heap_ordered(int k) const
+    // is pq[0..n-1] a min heap?
+    bool is_min_heap() const
     {
-        if (k > m_n) return true;
-        int left = 2*k;
-        int right = 2*k + 1;
-        if (left  <= m_n && greater(k, left))  return false;
-        if (right <= m_n && greater(k, right)) return false;
-        return is_min_heap_ordered(left) && is_min_heap_ordered(right);
+        for (int k = 1; k < size(); k++)
+            if (greater(m_pq[(k - 1) / D], m_pq[k])) return false;
+        return true;
     }
 
 
@@ -299,10 +453,10 @@ private:
         using pointer           = Key*;  // or also value_type*
         using reference         = Key&;  // or also value_type&
 
-        HeapIterator(MinPQ<Key>& min_pq)
+        HeapIterator(MinPQ& min_pq)
         {
             m_copy = min_pq;
-            m_ptr = m_copy.m_pq[1].get();
+            m_ptr = m_copy.is_empty() ? nullptr : &m_copy.m_pq[0];
         }
 
         HeapIterator(pointer ptr) : m_ptr(ptr) {}
@@ -319,7 +473,7 @@ private:
             if (m_copy.is_empty())
                 m_ptr = nullptr;
             else
-                m_ptr = m_copy.m_pq[1].get();
+                m_ptr = &m_copy.m_pq[0];
 
             return *this;
         }  
@@ -344,7 +498,7 @@ private:
         
     private:
         pointer m_ptr;
-        MinPQ<Key> m_copy;
+        MinPQ m_copy;
     };
 
 public:
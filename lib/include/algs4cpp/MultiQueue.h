@@ -0,0 +1,432 @@
+#ifndef MULTIQUEUE_H
+#define MULTIQUEUE_H
+
+#include <atomic>
+#include <mutex>
+#include "MinPQ.h"
+#include "ParallelQuick.h"
+
+/**
+ *  The {@code MultiQueue} class represents a relaxed priority queue of generic
+ *  keys that many threads insert into and remove from at once. It supports
+ *  <em>insert</em> and <em>delete-a-small-key</em>, one key or a batch of
+ *  keys at a time, from any number of threads.
+ *  <p>
+ *  The keys are spread over several {@link MinPQ} heaps, each behind a lock
+ *  of its own (Rihani, Sanders and Dementiev). An insert adds the key to one
+ *  heap. A removal samples two heaps at random and removes the smaller of
+ *  their two minimums, which is not always the minimum of the whole queue.
+ *  A thread keeps inserting into the same heap, and removing from the same
+ *  two heaps, for {@code stickiness} operations in a row, so that the heaps
+ *  it works on stay in its cache; it moves on to other heaps at once when
+ *  another thread holds a lock, instead of waiting for it. The queue keeps
+ *  the heaps of each thread, so a thread may work on several queues in turn.
+ *  <p>
+ *  The relaxation is tunable. More heaps mean fewer collisions between
+ *  threads and larger rank errors; so does a larger stickiness. A queue of
+ *  one heap, as made by {@code strict()}, is an exact priority queue behind
+ *  a single lock, for tests and for comparison.
+ *  <p>
+ *  The <em>rank error</em> of a removal is the number of keys on the queue
+ *  smaller than the key removed. Every {@code rank_sample_period}-th removal
+ *  of each thread measures it, locking the heaps one at a time, and
+ *  {@code rank_error()} reports the mean and maximum of the samples, for
+ *  monitoring. The rank of a key on a heap is counted by {@code MinPQ::rank()},
+ *  in time proportional to the rank.
+ *  <p>
+ *  Removals return {@code false} only when every heap was found empty, one
+ *  heap at a time: a removal that races with inserts may miss their keys.
+ *  {@code size()} is exact only when no thread is modifying the queue.
+ *
+ *  @param <Key> the generic type of key on this priority queue
+ *  @param <Compare> the type of the functor ordering the keys, {@code std::less<Key>} by default
+ *  @param <D> the number of children of a node of each heap, 2 by default
+ */
+template <typename Key, typename Compare = std::less<Key>, int D = 2>
+class MultiQueue
+{
+public:
+    static const int HEAPS_PER_THREAD = 2;          // heaps per hardware thread by default
+    static const int STICKINESS = 8;                // operations in a row on the same heaps by default
+    static const int RANK_SAMPLE_PERIOD = 1024;     // removals of a thread per rank error sample by default
+
+    /**
+     * The rank errors sampled since the queue was created or the samples reset.
+     */
+    struct RankError
+    {
+        long long samples;      // removals measured
+        double mean;            // mean number of smaller keys on the queue at a removal
+        long long max;          // largest number of smaller keys on the queue at a removal
+    };
+
+    /**
+     * Initializes an empty queue with {@code HEAPS_PER_THREAD} heaps per hardware thread.
+     */
+    MultiQueue() : MultiQueue(HEAPS_PER_THREAD * std::max(1, (int) std::thread::hardware_concurrency()))
+    {
+    }
+
+    /**
+     * Initializes an empty queue of the given number of heaps.
+     *
+     * @param  heaps the number of heaps; 1 makes the queue strict
+     * @param  stickiness the operations in a row a thread performs on the same heaps
+     * @param  rank_sample_period the removals of a thread per rank error sample; 0 for none
+     * @throws IllegalArgumentException if {@code heaps < 1}, {@code stickiness < 1}
+     *         or {@code rank_sample_period < 0}
+     */
+    MultiQueue(int heaps, int stickiness = STICKINESS, int rank_sample_period = RANK_SAMPLE_PERIOD)
+    {
+        if (heaps < 1) error("a MultiQueue needs at least one heap: {}", heaps);
+        if (stickiness < 1) error("stickiness must be positive: {}", stickiness);
+        if (rank_sample_period < 0) error("rank sample period is negative: {}", rank_sample_period);
+        m_heaps = std::vector<ptr<Heap>>();
+        m_heaps.reserve(heaps);
+        for (int i = 0; i < heaps; i++)
+            m_heaps.push_back(alloc<Heap>());
+        m_stickiness = stickiness;
+        m_rank_sample_period = rank_sample_period;
+        m_id = next_id().fetch_add(1, std::memory_order_relaxed);
+        reset_rank_error();
+    }
+
+    MultiQueue(const MultiQueue&) = delete;
+    MultiQueue& operator=(const MultiQueue&) = delete;
+
+    /**
+     * Returns an empty strict queue: a single heap, whose removals always
+     * return a smallest key, sampling the rank error of every removal.
+     *
+     * @return an empty strict queue
+     */
+    static MultiQueue strict()
+    {
+        return MultiQueue(1, 1, 1);
+    }
+
+    /**
+     * Does this queue always remove a smallest key?
+     *
+     * @return {@code true} if this queue has a single heap; {@code false} otherwise
+     */
+    bool is_strict() const
+    {
+        return m_heaps.size() == 1;
+    }
+
+    /**
+     * Returns the number of heaps the keys are spread over.
+     *
+     * @return the number of heaps
+     */
+    int heaps() const
+    {
+        return m_heaps.size();
+    }
+
+    /**
+     * Returns the number of keys on this queue.
+     *
+     * @return the number of keys on this queue
+     */
+    int size() const
+    {
+        int n = 0;
+        for (const ptr<Heap>& heap : m_heaps)
+            n += heap->size.load(std::memory_order_relaxed);
+        return n;
+    }
+
+    /**
+     * Returns true if this queue is empty.
+     *
+     * @return {@code true} if this queue is empty; {@code false} otherwise
+     */
+    bool is_empty() const
+    {
+        return size() == 0;
+    }
+
+    /**
+     * Adds a new key to this queue.
+     *
+     * @param  key the key to add
+     */
+    void insert(Key key)
+    {
+        Heap& heap = lock_insert_heap();
+        heap.pq.insert(std::move(key));
+        heap.size.store(heap.pq.size(), std::memory_order_relaxed);
+        heap.lock.unlock();
+    }
+
+    /**
+     * Adds the keys in [first, last) to this queue, {@code stickiness} keys
+     * at a time to a heap, under one lock for each.
+     *
+     * @param  first an iterator to the first key to add
+     * @param  last an iterator past the last key to add
+     */
+    template <typename It>
+    void insert_batch(It first, It last)
+    {
+        while (first != last)
+        {
+            Heap& heap = lock_insert_heap();
+            for (int i = 0; i < m_stickiness && first != last; i++, ++first)
+                heap.pq.insert(*first);
+            heap.size.store(heap.pq.size(), std::memory_order_relaxed);
+            heap.lock.unlock();
+
+            // the next chunk goes to another heap
+            state().inserts_left = 0;
+        }
+    }
+
+    /**
+     * Removes a small key from this queue: the smaller of the minimums of two heaps.
+     *
+     * @param  key set to the key removed, if any
+     * @return {@code true} if a key was removed; {@code false} if the queue was empty
+     */
+    bool try_del_min(Key& key)
+    {
+        bool removed = remove([this, &key](Heap& first, Heap& second)
+        {
+            key = smaller(first, second).pq.del_min();
+        });
+        if (removed) sample_rank_error(key);
+        return removed;
+    }
+
+    /**
+     * Removes up to {@code k} small keys from this queue, under the locks of
+     * the same two heaps: each the smaller of their two minimums. The larger
+     * the batch, the further its last keys may be from the minimum of the queue.
+     *
+     * @param  k the number of keys to remove
+     * @param  keys the array to append the keys removed to, in ascending order
+     * @return the number of keys removed: fewer than {@code k} only if the
+     *         two heaps ran out, 0 only if the queue was empty
+     */
+    int try_del_min_batch(int k, std::vector<Key>& keys)
+    {
+        int start = keys.size();
+        remove([this, k, &keys](Heap& first, Heap& second)
+        {
+            for (int i = 0; i < k && !(first.pq.is_empty() && second.pq.is_empty()); i++)
+                keys.push_back(smaller(first, second).pq.del_min());
+        });
+        for (int i = start; i < keys.size(); i++)
+            sample_rank_error(keys[i]);
+        return keys.size() - start;
+    }
+
+    /**
+     * Returns the rank errors sampled so far.
+     *
+     * @return the number, mean and maximum of the rank errors sampled
+     */
+    RankError rank_error() const
+    {
+        RankError error;
+        error.samples = m_rank_samples.load(std::memory_order_relaxed);
+        error.mean = error.samples == 0 ? 0.0 : (double) m_rank_total.load(std::memory_order_relaxed) / error.samples;
+        error.max = m_rank_max.load(std::memory_order_relaxed);
+        return error;
+    }
+
+    /**
+     * Discards the rank errors sampled so far.
+     */
+    void reset_rank_error()
+    {
+        m_rank_samples.store(0, std::memory_order_relaxed);
+        m_rank_total.store(0, std::memory_order_relaxed);
+        m_rank_max.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    // a heap and its lock, on cache lines of their own
+    struct alignas(64) Heap
+    {
+        std::mutex lock;
+        MinPQ<Key, Compare, D> pq;
+        std::atomic<int> size = 0;      // keys on pq, to read without the lock
+    };
+
+    // the heaps a thread works on, and how many more operations it performs on them
+    struct Sticky
+    {
+        int insert_heap = 0;
+        int inserts_left = 0;
+        int remove_heaps[2] = { 0, 0 };
+        int removes_left = 0;
+        long long removals = 0;         // removals by the thread, to sample the rank error
+    };
+
+    std::vector<ptr<Heap>> m_heaps;
+    int m_stickiness;
+    int m_rank_sample_period;
+    long long m_id;                     // tells the queues apart in the cache of each thread
+    std::mutex m_states_lock;
+    std::map<std::thread::id, ptr<Sticky>> m_states;   // the state of each thread on this queue
+    Compare m_compare;
+    std::atomic<long long> m_rank_samples;
+    std::atomic<long long> m_rank_total;
+    std::atomic<long long> m_rank_max;
+
+    static std::atomic<long long>& next_id()
+    {
+        static std::atomic<long long> id = 0;
+        return id;
+    }
+
+    // the state of the calling thread on this queue; each thread caches the state
+    // it last used, and looks it up again when it moves to another queue
+    Sticky& state()
+    {
+        thread_local long long cached_id = -1;
+        thread_local Sticky* cached = nullptr;
+        if (cached_id != m_id)
+        {
+            std::lock_guard<std::mutex> guard(m_states_lock);
+            ptr<Sticky>& sticky = m_states[std::this_thread::get_id()];
+            if (sticky == nullptr) sticky = alloc<Sticky>();
+            cached = sticky.get();
+            cached_id = m_id;
+        }
+        return *cached;
+    }
+
+    // take the lock of the heap, unless another thread holds it; the single heap of a strict queue is waited for
+    bool try_lock(Heap& heap)
+    {
+        if (is_strict())
+        {
+            heap.lock.lock();
+            return true;
+        }
+        return heap.lock.try_lock();
+    }
+
+    // the heap of the thread for inserts, locked
+    Heap& lock_insert_heap()
+    {
+        Sticky& sticky = state();
+        while (true)
+        {
+            if (sticky.inserts_left == 0)
+            {
+                sticky.insert_heap = ParallelQuick::uniform_int(0, heaps() - 1);
+                sticky.inserts_left = m_stickiness;
+            }
+            Heap& heap = *m_heaps[sticky.insert_heap];
+            if (try_lock(heap))
+            {
+                sticky.inserts_left--;
+                return heap;
+            }
+            sticky.inserts_left = 0;
+        }
+    }
+
+    // the heap of the two with the smaller minimum; at least one of them has keys
+    Heap& smaller(Heap& first, Heap& second) const
+    {
+        if (first.pq.is_empty()) return second;
+        if (second.pq.is_empty()) return first;
+        return m_compare(second.pq.min(), first.pq.min()) ? second : first;
+    }
+
+    // call take(first, second) with the two heaps of the thread for removals locked, at least
+    // one of them with keys; once pairs keep coming up empty, with each nonempty heap in turn
+    template <typename F>
+    bool remove(F take)
+    {
+        Sticky& sticky = state();
+        int misses = 0;
+        while (misses < 2 * heaps())
+        {
+            if (sticky.removes_left == 0)
+            {
+                int i = ParallelQuick::uniform_int(0, heaps() - 1);
+                int j = heaps() == 1 ? i : ParallelQuick::uniform_int(0, heaps() - 2);
+                if (heaps() > 1 && j >= i) j++;
+                sticky.remove_heaps[0] = i;
+                sticky.remove_heaps[1] = j;
+                sticky.removes_left = m_stickiness;
+            }
+            Heap& first = *m_heaps[sticky.remove_heaps[0]];
+            Heap& second = *m_heaps[sticky.remove_heaps[1]];
+
+            // do not lock two heaps that look empty
+            if (first.size.load(std::memory_order_relaxed) == 0 && second.size.load(std::memory_order_relaxed) == 0)
+            {
+                sticky.removes_left = 0;
+                misses++;
+                continue;
+            }
+            if (!try_lock(first))
+            {
+                sticky.removes_left = 0;
+                continue;
+            }
+            if (&second != &first && !try_lock(second))
+            {
+                first.lock.unlock();
+                sticky.removes_left = 0;
+                continue;
+            }
+
+            bool found = !first.pq.is_empty() || !second.pq.is_empty();
+            if (found)
+            {
+                take(first, second);
+                first.size.store(first.pq.size(), std::memory_order_relaxed);
+                second.size.store(second.pq.size(), std::memory_order_relaxed);
+                sticky.removes_left--;
+            }
+            else
+            {
+                sticky.removes_left = 0;
+                misses++;
+            }
+            if (&second != &first) second.lock.unlock();
+            first.lock.unlock();
+            if (found) return true;
+        }
+
+        for (ptr<Heap>& heap : m_heaps)
+        {
+            std::lock_guard<std::mutex> guard(heap->lock);
+            if (heap->pq.is_empty()) continue;
+            take(*heap, *heap);
+            heap->size.store(heap->pq.size(), std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    // on every rank_sample_period-th removal of the thread, count the keys on the queue smaller than the key removed
+    void sample_rank_error(const Key& key)
+    {
+        if (m_rank_sample_period == 0 || ++state().removals % m_rank_sample_period != 0) return;
+
+        long long rank = 0;
+        for (ptr<Heap>& heap : m_heaps)
+        {
+            std::lock_guard<std::mutex> guard(heap->lock);
+            rank += heap->pq.rank(key);
+        }
+        m_rank_samples.fetch_add(1, std::memory_order_relaxed);
+        m_rank_total.fetch_add(rank, std::memory_order_relaxed);
+        long long max = m_rank_max.load(std::memory_order_relaxed);
+        while (rank > max && !m_rank_max.compare_exchange_weak(max, rank, std::memory_order_relaxed))
+        {
+        }
+    }
+};
+
+#endif
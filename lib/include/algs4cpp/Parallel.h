@@ -0,0 +1,376 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "ThreadPool.h"
+
+/**
+ *  The {@code Parallel} namespace provides the data-parallel building blocks
+ *  of the parallel algorithms: a parallel for over an index range, reduce,
+ *  inclusive and exclusive scan, pack and filter (stream compaction), and
+ *  stable partition.
+ *  <p>
+ *  Every primitive cuts its range into consecutive blocks of {@code grain}
+ *  elements (the last one shorter), runs one task per block on the shared
+ *  {@link ThreadPool}, and returns when all of them are done; a range of at
+ *  most one block runs on the calling thread. Primitives may be called from
+ *  inside pool tasks, so they compose with the fork-join algorithms.
+ *  <p>
+ *  Results are deterministic: the blocks depend only on the range and the
+ *  grain, never on the number of threads or on scheduling, and partial
+ *  results are combined in block order. An operation that is associative
+ *  but not exactly so, such as floating-point addition, therefore gives the
+ *  same result on every run and every machine for a given grain, though not
+ *  necessarily the result of a serial left-to-right loop.
+ *  <p>
+ *  Pack, filter and partition are stable. Scans work in place.
+ */
+namespace Parallel
+{
+    const int GRAIN = 1 << 14;      // default elements per task
+
+    // the number of blocks of grain elements covering n elements
+    inline int blocks(int n, int grain)
+    {
+        if (grain < 1) error("grain must be positive: {}", grain);
+        return n <= 0 ? 0 : (int) (((long long) n + grain - 1) / grain);
+    }
+
+    /**
+     * Returns the grain that cuts n elements into about four blocks per thread
+     * of the shared pool, the calling thread included, but no block shorter
+     * than {@code min_grain} but the last. The blocks then depend on the
+     * number of threads, so it suits work whose result does not depend on the
+     * blocks, such as sorting and exact counting.
+     *
+     * @param n the number of elements
+     * @param min_grain the fewest elements worth a task
+     * @return the grain
+     */
+    inline int task_grain(int n, int min_grain)
+    {
+        long long tasks = 4 * (ThreadPool::shared().size() + 1);
+        return (int) std::max<long long>(min_grain, (n + tasks - 1) / tasks);
+    }
+
+    /**
+     * Calls {@code f(b, first, last)} for every block b = [first, last) of
+     * {@code grain} indices that cover [lo, hi), in parallel: block b starts
+     * at {@code lo + b * grain}. For work that keeps a result per block.
+     *
+     * @param lo the first index
+     * @param hi one past the last index
+     * @param grain the indices per task
+     * @param f the function to call on each block
+     * @throws IllegalArgumentException if {@code grain < 1}
+     */
+    template <typename F>
+    void for_each_block(int lo, int hi, int grain, F f)
+    {
+        int count = blocks(hi - lo, grain);
+        auto first = [lo, hi, grain](int b) { return (int) std::min((long long) lo + (long long) b * grain, (long long) hi); };
+        if (count <= 1)
+        {
+            if (count == 1) f(0, lo, hi);
+            return;
+        }
+
+        TaskGroup group;
+        for (int b = 0; b < count; b++)
+        {
+            int start = first(b), end = first(b + 1);
+            group.run([&f, b, start, end] { f(b, start, end); });
+        }
+        group.wait();
+    }
+
+    // a value per block, padded apart so that neighbouring blocks do not share a cache line (nor a vector<bool> word)
+    template <typename T>
+    struct alignas(64) Slot
+    {
+        T value;
+    };
+
+    /**
+     * Calls {@code f(first, last)} for consecutive blocks [first, last) of
+     * {@code grain} indices that cover [lo, hi), in parallel.
+     *
+     * @param lo the first index
+     * @param hi one past the last index
+     * @param f the function to call on each block
+     * @param grain the indices per task
+     * @throws IllegalArgumentException if {@code grain < 1}
+     */
+    template <typename F>
+    void for_blocks(int lo, int hi, F f, int grain = GRAIN)
+    {
+        for_each_block(lo, hi, grain, [&f](int, int first, int last) { f(first, last); });
+    }
+
+    /**
+     * Calls {@code f(i)} for every index i in [lo, hi), in parallel,
+     * {@code grain} indices per task.
+     *
+     * @param lo the first index
+     * @param hi one past the last index
+     * @param f the function to call on each index
+     * @param grain the indices per task
+     * @throws IllegalArgumentException if {@code grain < 1}
+     */
+    template <typename F>
+    void for_each(int lo, int hi, F f, int grain = GRAIN)
+    {
+        for_each_block(lo, hi, grain, [&f](int, int first, int last)
+        {
+            for (int i = first; i < last; i++)
+                f(i);
+        });
+    }
+
+    /**
+     * Returns {@code identity op map(lo) op map(lo+1) op ... op map(hi-1)}, for an
+     * associative operation {@code op} of which {@code identity} is the identity.
+     *
+     * @param lo the first index
+     * @param hi one past the last index
+     * @param identity the identity of the operation
+     * @param map the function giving the value of each index
+     * @param op the associative operation
+     * @param grain the indices per task
+     * @return the reduction
+     * @throws IllegalArgumentException if {@code grain < 1}
+     */
+    template <typename T, typename Map, typename Op>
+    T map_reduce(int lo, int hi, T identity, Map map, Op op, int grain = GRAIN)
+    {
+        std::vector<Slot<T>> partial = std::vector<Slot<T>>(blocks(hi - lo, grain), Slot<T> { identity });
+        for_each_block(lo, hi, grain, [&partial, &map, &op, &identity](int b, int first, int last)
+        {
+            T sum = identity;
+            for (int i = first; i < last; i++)
+                sum = op(sum, map(i));
+            partial[b].value = sum;
+        });
+
+        T total = identity;
+        for (const Slot<T>& slot : partial)
+            total = op(total, slot.value);
+        return total;
+    }
+
+    /**
+     * Returns {@code identity op a[0] op a[1] op ... op a[n-1]}, for an associative
+     * operation {@code op} of which {@code identity} is the identity.
+     * <p>
+     * For example, {@code Parallel::reduce(a, 0.0, std::plus<double>())}.
+     *
+     * @param a the array
+     * @param identity the identity of the operation
+     * @param op the associative operation
+     * @param grain the elements per task
+     * @return the reduction
+     * @throws IllegalArgumentException if {@code grain < 1}
+     */
+    template <typename T, typename Op>
+    T reduce(const std::vector<T>& a, T identity, Op op, int grain = GRAIN)
+    {
+        return map_reduce(0, (int) a.size(), identity, [&a](int i) -> const T& { return a[i]; }, op, grain);
+    }
+
+    /**
+     * Replaces every element with the combination of itself and the elements
+     * before it: a[i] becomes {@code a[0] op a[1] op ... op a[i]}.
+     *
+     * @param a the array
+     * @param op the associative operation, addition by default
+     * @param grain the elements per task
+     * @throws IllegalArgumentException if {@code grain < 1}
+     */
+    template <typename T, typename Op = std::plus<T>>
+    void inclusive_scan(std::vector<T>& a, Op op = Op(), int grain = GRAIN)
+    {
+        static_assert(!std::is_same_v<T, bool>, "vector<bool> packs its elements, so blocks of it cannot be written concurrently");
+        int n = a.size();
+        int count = blocks(n, grain);
+        if (count <= 1)
+        {
+            for (int i = 1; i < n; i++)
+                a[i] = op(a[i-1], a[i]);
+            return;
+        }
+
+        // the sum of each block but the last
+        std::vector<Slot<T>> offset = std::vector<Slot<T>>(count);
+        for_each_block(0, n - (n - 1) % grain - 1, grain, [&a, &offset, &op](int b, int first, int last)
+        {
+            T sum = a[first];
+            for (int i = first + 1; i < last; i++)
+                sum = op(sum, a[i]);
+            offset[b + 1].value = sum;
+        });
+
+        // the sum of everything before each block
+        for (int b = 2; b < count; b++)
+            offset[b].value = op(offset[b-1].value, offset[b].value);
+
+        for_each_block(0, n, grain, [&a, &offset, &op](int b, int first, int last)
+        {
+            if (b > 0) a[first] = op(offset[b].value, a[first]);
+            for (int i = first + 1; i < last; i++)
+                a[i] = op(a[i-1], a[i]);
+        });
+    }
+
+    /**
+     * Replaces every element with the combination of the elements before it:
+     * a[0] becomes {@code identity} and a[i] becomes {@code identity op a[0] op ... op a[i-1]}.
+     * This turns counts into offsets, such as those of the buckets of a radix sort.
+     *
+     * @param a the array
+     * @param identity the identity of the operation, 0 by default
+     * @param op the associative operation, addition by default
+     * @param grain the elements per task
+     * @return the combination of all the elements
+     * @throws IllegalArgumentException if {@code grain < 1}
+     */
+    template <typename T, typename Op = std::plus<T>>
+    T exclusive_scan(std::vector<T>& a, T identity = T(), Op op = Op(), int grain = GRAIN)
+    {
+        static_assert(!std::is_same_v<T, bool>, "vector<bool> packs its elements, so blocks of it cannot be written concurrently");
+        int n = a.size();
+        int count = blocks(n, grain);
+        std::vector<Slot<T>> offset = std::vector<Slot<T>>(count + 1, Slot<T> { identity });
+        if (count > 1)
+        {
+            for_each_block(0, n, grain, [&a, &offset, &op, &identity](int b, int first, int last)
+            {
+                T sum = identity;
+                for (int i = first; i < last; i++)
+                    sum = op(sum, a[i]);
+                offset[b + 1].value = sum;
+            });
+            for (int b = 1; b <= count; b++)
+                offset[b].value = op(offset[b-1].value, offset[b].value);
+        }
+
+        T total = identity;
+        for_each_block(0, n, grain, [&a, &offset, &op, &total, count](int b, int first, int last)
+        {
+            T sum = offset[b].value;
+            for (int i = first; i < last; i++)
+            {
+                T x = std::move(a[i]);
+                a[i] = sum;
+                sum = op(sum, x);
+            }
+            if (b == count - 1) total = sum;
+        });
+        return total;
+    }
+
+    /**
+     * Returns the elements of {@code a} whose flags are set, in their order.
+     *
+     * @param a the array
+     * @param flags a flag for each element, convertible to bool
+     * @param grain the elements per task
+     * @return the flagged elements
+     * @throws IllegalArgumentException if the array and the flags differ in length
+     * @throws IllegalArgumentException if {@code grain < 1}
+     */
+    template <typename T, typename Flag>
+    std::vector<T> pack(const std::vector<T>& a, const std::vector<Flag>& flags, int grain = GRAIN)
+    {
+        static_assert(!std::is_same_v<T, bool>, "vector<bool> packs its elements, so blocks of it cannot be written concurrently");
+        if (a.size() != flags.size()) error("array and flags lengths disagree");
+        int n = a.size();
+
+        // where each block writes its flagged elements
+        std::vector<int> start = std::vector<int>(blocks(n, grain));
+        for_each_block(0, n, grain, [&flags, &start](int b, int first, int last)
+        {
+            int count = 0;
+            for (int i = first; i < last; i++)
+                count += (bool) flags[i];
+            start[b] = count;
+        });
+        int total = exclusive_scan(start);
+
+        std::vector<T> result = std::vector<T>(total);
+        for_each_block(0, n, grain, [&a, &flags, &start, &result](int b, int first, int last)
+        {
+            int k = start[b];
+            for (int i = first; i < last; i++)
+                if (flags[i]) result[k++] = a[i];
+        });
+        return result;
+    }
+
+    /**
+     * Returns the elements x of {@code a} for which {@code keep(x)} is true, in
+     * their order. {@code keep} is called once per element.
+     *
+     * @param a the array
+     * @param keep the predicate
+     * @param grain the elements per task
+     * @return the kept elements
+     * @throws IllegalArgumentException if {@code grain < 1}
+     */
+    template <typename T, typename Pred>
+    std::vector<T> filter(const std::vector<T>& a, Pred keep, int grain = GRAIN)
+    {
+        std::vector<uint8_t> flags = std::vector<uint8_t>(a.size());
+        for_each(0, (int) a.size(), [&a, &flags, &keep](int i) { flags[i] = keep(a[i]); }, grain);
+        return pack(a, flags, grain);
+    }
+
+    /**
+     * Rearranges {@code a} so that the elements x for which {@code pred(x)} is
+     * true come first, and returns how many there are. Both groups keep the
+     * order of their elements. {@code pred} is called once per element.
+     * Uses an auxiliary array of the same length.
+     *
+     * @param a the array
+     * @param pred the predicate
+     * @param grain the elements per task
+     * @return the number of elements for which {@code pred} is true
+     * @throws IllegalArgumentException if {@code grain < 1}
+     */
+    template <typename T, typename Pred>
+    int partition(std::vector<T>& a, Pred pred, int grain = GRAIN)
+    {
+        static_assert(!std::is_same_v<T, bool>, "vector<bool> packs its elements, so blocks of it cannot be written concurrently");
+        int n = a.size();
+        std::vector<uint8_t> flags = std::vector<uint8_t>(n);
+        std::vector<int> start = std::vector<int>(blocks(n, grain));
+        for_each_block(0, n, grain, [&a, &flags, &start, &pred](int b, int first, int last)
+        {
+            int count = 0;
+            for (int i = first; i < last; i++)
+                count += flags[i] = pred(a[i]);
+            start[b] = count;
+        });
+        int trues = exclusive_scan(start);
+
+        // block b writes its true elements from start[b], its false ones after every true
+        // element and the false elements of the blocks before it
+        std::vector<T> aux = std::vector<T>(n);
+        for_each_block(0, n, grain, [&a, &aux, &flags, &start, trues](int b, int first, int last)
+        {
+            int t = start[b];
+            int f = trues + (first - t);
+            for (int i = first; i < last; i++)
+            {
+                if (flags[i]) aux[t++] = std::move(a[i]);
+                else          aux[f++] = std::move(a[i]);
+            }
+        });
+
+        for_blocks(0, n, [&a, &aux](int first, int last)
+        {
+            std::move(aux.begin() + first, aux.begin() + last, a.begin() + first);
+        }, grain);
+        return trues;
+    }
+}
+
+#endif
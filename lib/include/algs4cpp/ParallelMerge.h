@@ -0,0 +1,151 @@
+#ifndef PARALLELMERGE_H
+#define PARALLELMERGE_H
+
+#include "Parallel.h"
+#include "SortingNetwork.h"
+
+/**
+ *  The {@code ParallelMerge} namespace provides the parallel mergesort
+ *  engine behind {@code Merge::parallel_sort()} and {@code MergeX::parallel_sort()}.
+ *  <p>
+ *  The two halves of every subarray longer than {@code SORT_GRAIN} are
+ *  sorted concurrently on the shared {@link ThreadPool}. Merges longer than
+ *  {@code MERGE_GRAIN} are themselves split: the output range is cut into
+ *  equal pieces and the <em>co-rank</em> of each cut (how many of its
+ *  elements come from the left run) is found by binary search, so every
+ *  piece merges independently. Like MergeX, it alternates the roles of the
+ *  input and auxiliary arrays, cuts off to insertion sort for tiny
+ *  subarrays and skips merges whose halves are already in order.
+ *  <p>
+ *  This sorting algorithm is stable. It takes &Theta;(<em>n</em> log <em>n</em>)
+ *  work and &Theta;(log<sup>3</sup> <em>n</em>) span, and uses
+ *  &Theta;(<em>n</em>) extra memory (not including the input array).
+ */
+namespace ParallelMerge
+{
+    const int CUTOFF = 7;             // cutoff to insertion sort
+    const int SORT_GRAIN = 8192;      // do not fork sorts smaller than this
+    const int MERGE_GRAIN = 16384;    // do not split merges smaller than this
+
+    // sort from a[lo] to a[hi] using insertion sort
+    template <typename T, typename Less>
+    void insertion_sort(std::vector<T>& a, int lo, int hi, Less less)
+    {
+        for (int i = lo + 1; i <= hi; i++)
+        {
+            for (int j = i; j > lo && less(a[j], a[j-1]); j--)
+            {
+                using std::swap;
+                swap(a[j], a[j-1]);
+            }
+        }
+    }
+
+    // stably merge src[lo .. mid] with src[mid+1 .. hi] into dst[k ..]
+    template <typename T, typename Less>
+    void merge(std::vector<T>& src, std::vector<T>& dst,
+        int i, int mid, int j, int hi, int k, Less less)
+    {
+        while (i <= mid && j <= hi)
+        {
+            if (less(src[j], src[i])) dst[k++] = src[j++];   // to ensure stability
+            else                      dst[k++] = src[i++];
+        }
+        while (i <= mid) dst[k++] = src[i++];
+        while (j <= hi)  dst[k++] = src[j++];
+    }
+
+    /**
+     * Returns the number of elements of the left run src[lo .. mid] among the
+     * first k elements of the stable merge of src[lo .. mid] and src[mid+1 .. hi].
+     */
+    template <typename T, typename Less>
+    int co_rank(std::vector<T>& src, int lo, int mid, int hi, int k, Less less)
+    {
+        int n1 = mid - lo + 1;
+        int n2 = hi - mid;
+        int left = std::max(0, k - n2);
+        int right = std::min(k, n1);
+        while (true)
+        {
+            int i = left + (right - left) / 2;
+            int j = k - i;
+
+            // the left run gives up a key that follows src[mid+1+j]
+            if (i > 0 && j < n2 && less(src[mid+1+j], src[lo+i-1]))
+                right = i - 1;
+
+            // the left run keeps back a key that precedes (or ties) src[mid+j]
+            else if (j > 0 && i < n1 && !less(src[mid+j], src[lo+i]))
+                left = i + 1;
+
+            else return i;
+        }
+    }
+
+    // stably merge src[lo .. mid] with src[mid+1 .. hi] into dst[lo .. hi]
+    // splitting the output into independently merged pieces
+    template <typename T, typename Less>
+    void parallel_merge(std::vector<T>& src, std::vector<T>& dst, int lo, int mid, int hi, Less less)
+    {
+        int n = hi - lo + 1;
+        Parallel::for_blocks(0, n, [&src, &dst, lo, mid, hi, less](int k1, int k2)
+        {
+            int i1 = co_rank(src, lo, mid, hi, k1, less);
+            int i2 = co_rank(src, lo, mid, hi, k2, less);
+            merge(src, dst, lo + i1, lo + i2 - 1, mid + 1 + k1 - i1, mid + k2 - i2, lo + k1, less);
+        }, Parallel::task_grain(n, MERGE_GRAIN));
+    }
+
+    // sort src[lo .. hi] into dst[lo .. hi]; both hold the same keys on entry
+    template <typename T, typename Less>
+    void sort(std::vector<T>& src, std::vector<T>& dst, int lo, int hi, Less less)
+    {
+        if (hi <= lo + SortingNetwork::cutoff<T, Less>(CUTOFF))
+        {
+            if constexpr (SortingNetwork::applies<T, Less>) SortingNetwork::sort(dst, lo, hi);
+            else                                            insertion_sort(dst, lo, hi, less);
+            return;
+        }
+        int mid = lo + (hi - lo) / 2;
+
+        if (hi - lo + 1 < SORT_GRAIN)
+        {
+            sort(dst, src, lo, mid, less);
+            sort(dst, src, mid+1, hi, less);
+        }
+        else
+        {
+            TaskGroup group;
+            group.run([&src, &dst, lo, mid, less] { sort(dst, src, lo, mid, less); });
+            sort(dst, src, mid+1, hi, less);
+            group.wait();
+        }
+
+        if (!less(src[mid+1], src[mid]))
+        {
+            std::copy(src.begin() + lo, src.begin() + hi + 1, dst.begin() + lo);
+            return;
+        }
+
+        if (hi - lo + 1 < MERGE_GRAIN) merge(src, dst, lo, mid, mid + 1, hi, lo, less);
+        else                           parallel_merge(src, dst, lo, mid, hi, less);
+    }
+
+    /**
+     * Rearranges the array in the order given by {@code less},
+     * sorting and merging subarrays concurrently.
+     *
+     * @param a the array to be sorted
+     * @param less the strict weak ordering to sort by
+     */
+    template <typename T, typename Less>
+    void sort(std::vector<T>& a, Less less)
+    {
+        if (a.size() < 2) return;
+        std::vector<T> aux = std::vector<T>(a.begin(), a.end());
+        sort(aux, a, 0, a.size() - 1, less);
+    }
+}
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef PARALLELQUICK_H
+#define PARALLELQUICK_H
+
+#include "Parallel.h"
+
+/**
+ *  The {@code ParallelQuick} namespace provides the building blocks shared by
+ *  {@code Quick::parallel_sort()}, {@code QuickX::parallel_sort()} and
+ *  {@code Quick3way::parallel_sort()}, and the depth limit of the introsort
+ *  guard of {@code Quick}, {@code QuickX} and {@code QuickBentleyMcIlroy}.
+ *  <p>
+ *  Subarrays of at least {@code PARTITION_GRAIN} keys are split with a
+ *  parallel 3-way partition: the subarray is cut into blocks, every block
+ *  counts its keys less than, equal to and greater than the pivot, a prefix
+ *  sum over the counts gives each block its output offsets, and the blocks
+ *  then scatter their keys to an auxiliary array concurrently. Keys equal
+ *  to the pivot end up in their final position, so duplicate-heavy inputs
+ *  shrink quickly.
+ *  <p>
+ *  The random numbers used by the parallel sorts come from a generator local
+ *  to each thread, since {@link StdRandom} is not safe to share between threads.
+ */
+namespace ParallelQuick
+{
+    const int SORT_GRAIN = 8192;            // sort subarrays smaller than this inline
+    const int PARTITION_GRAIN = 1 << 18;    // partition subarrays at least this long in parallel
+    const int BLOCK_SIZE = 1 << 14;         // minimum number of keys per partition block
+    const int SAMPLE_SIZE = 31;             // keys sampled to choose a parallel pivot
+
+    /**
+     * Returns the number of partitions an introsort of n keys may nest before
+     * it heapsorts: 2 floor(lg n).
+     */
+    inline int depth_limit(int n)
+    {
+        int depth = 0;
+        for (; n > 1; n /= 2) depth += 2;
+        return depth;
+    }
+
+    /**
+     * Returns a random integer uniformly in [lo, hi], from a generator local to the calling thread.
+     */
+    inline int uniform_int(int lo, int hi)
+    {
+        thread_local std::minstd_rand rng = std::minstd_rand(std::random_device()());
+        return std::uniform_int_distribution<int>(lo, hi)(rng);
+    }
+
+    /**
+     * Rearranges a[lo .. hi] in uniformly random order; safe to call from any thread.
+     */
+    template <typename T>
+    void shuffle(std::vector<T>& a, int lo, int hi)
+    {
+        using std::swap;
+        for (int i = lo; i < hi; i++)
+            swap(a[i], a[uniform_int(i, hi)]);
+    }
+
+    /**
+     * Returns the median of a random sample of a[lo .. hi].
+     */
+    template <typename T, typename Less>
+    T sample_pivot(std::vector<T>& a, int lo, int hi, Less less)
+    {
+        std::vector<T> sample = std::vector<T>();
+        sample.reserve(SAMPLE_SIZE);
+        for (int i = 0; i < SAMPLE_SIZE; i++)
+            sample.push_back(a[uniform_int(lo, hi)]);
+        std::nth_element(sample.begin(), sample.begin() + SAMPLE_SIZE / 2, sample.end(), less);
+        return sample[SAMPLE_SIZE / 2];
+    }
+
+    /**
+     * Partitions a[lo .. hi] around v in parallel, using aux[lo .. hi] as scratch space,
+     * so that a[lo .. lt-1] < v = a[lt .. gt] < a[gt+1 .. hi].
+     *
+     * @return the pair {@code (lt, gt)}
+     */
+    template <typename T, typename Less>
+    std::pair<int, int> partition(std::vector<T>& a, std::vector<T>& aux, int lo, int hi, const T& v, Less less)
+    {
+        int n = hi - lo + 1;
+        int grain = Parallel::task_grain(n, BLOCK_SIZE);
+        int blocks = Parallel::blocks(n, grain);
+
+        // count the keys of each block that belong to each side
+        std::vector<int> to_less = std::vector<int>(blocks);
+        std::vector<int> to_equal = std::vector<int>(blocks);
+        std::vector<int> to_greater = std::vector<int>(blocks);
+        Parallel::for_each_block(lo, hi + 1, grain, [&a, &v, &to_less, &to_equal, &to_greater, less](int b, int first, int last)
+        {
+            int lt = 0, eq = 0;
+            for (int i = first; i < last; i++)
+            {
+                if      (less(a[i], v)) lt++;
+                else if (!less(v, a[i])) eq++;
+            }
+            to_less[b] = lt;
+            to_equal[b] = eq;
+            to_greater[b] = (last - first) - lt - eq;
+        });
+
+        // exclusive prefix sums of the counts give every block its three output cursors:
+        // keys less than v go to [lo, lt), keys equal to it to [lt, gt), greater keys after
+        int lt = Parallel::exclusive_scan(to_less, lo);
+        int gt = Parallel::exclusive_scan(to_equal, lt);
+        Parallel::exclusive_scan(to_greater, gt);
+
+        // scatter to aux[] and move back to a[]
+        Parallel::for_each_block(lo, hi + 1, grain, [&a, &aux, &v, &to_less, &to_equal, &to_greater, less](int b, int first, int last)
+        {
+            int i_less = to_less[b], i_equal = to_equal[b], i_greater = to_greater[b];
+            for (int i = first; i < last; i++)
+            {
+                if      (less(a[i], v))  aux[i_less++] = std::move(a[i]);
+                else if (less(v, a[i]))  aux[i_greater++] = std::move(a[i]);
+                else                     aux[i_equal++] = std::move(a[i]);
+            }
+        });
+
+        Parallel::for_blocks(lo, hi + 1, [&a, &aux](int first, int last)
+        {
+            std::move(aux.begin() + first, aux.begin() + last, a.begin() + first);
+        }, grain);
+
+        return std::make_pair(lt, gt - 1);
+    }
+}
+
+#endif
@@ -1,6 +1,9 @@
 #ifndef QUICK_H
 #define QUICK_H
 
+#include "Heap.h"
+#include "ParallelQuick.h"
+#include "SortingNetwork.h"
 #include "StdOut.h"
 #include "StdRandom.h"
 
@@ -36,6 +39,23 @@
  *  The {@code Quick} class provides static methods for sorting an
  *  array and selecting the ith smallest element in an array using quicksort.
  *  <p>
+ *  The {@code parallel_sort} method sorts the two sides of every large
+ *  partition concurrently on the shared {@link ThreadPool}; see {@link ParallelQuick}.
+ *  <p>
+ *  The {@code intro_sort} method skips the shuffle. It partitions on the
+ *  median of the first, middle and last keys, and heapsorts any subarray
+ *  nested more than 2 lg <em>n</em> partitions deep, so it makes
+ *  ~ <em>n</em> lg <em>n</em> compares in the worst case.
+ *  <p>
+ *  The {@code select} method given a list of ranks places the keys of all of
+ *  them with a single recursive partitioning, splitting the ranks between the
+ *  two sides of each partition instead of starting over for each rank.
+ *  Selection does not shuffle: each pivot is the key of a middle rank in a
+ *  random sample of about <em>n</em><sup>2/3</sup> keys (Floyd and Rivest),
+ *  so a single rank takes about <em>n</em> + min(<em>k</em>, <em>n</em> - <em>k</em>) compares.
+ *  The {@code parallel_select} method partitions large subarrays in parallel
+ *  and works on the two sides concurrently, and {@code quantiles} uses it.
+ *  <p>
  *  For additional documentation, see
  *  <a href="https://algs4.cs.princeton.edu/23quicksort">Section 2.3</a>
  *  of <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
@@ -44,7 +64,7 @@
  *  @author Kevin Wayne
  */
 
-template <typename T>
+template <typename T, typename Compare = std::less<T>>
 class Quick
 {
 public:
@@ -53,12 +73,94 @@ public:
      * @param a the array to be sorted
      */
     static void sort(std::vector<T>& a)
+    {
+        sort(a, Compare());
+    };
+
+    /**
+     * Rearranges the array in ascending order, using a comparator.
+     * @param a the array to be sorted
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void sort(std::vector<T>& a, Less cmp)
     {
         StdRandom::shuffle(a);
-        sort(a, 0, a.size() - 1);
-        assert(is_sorted(a));
+        sort(a, 0, a.size() - 1, cmp);
+        assert(is_sorted(a, 0, a.size() - 1, cmp));
     };
 
+    /**
+     * Rearranges the array in ascending order, using a comparator.
+     * @param a the array to be sorted
+     * @param comparator the comparator specifying the order
+     */
+    static void sort(std::vector<T>& a, cmp_func)
+    {
+        sort<bool(*)(T, T)>(a, cmp);
+    }
+
+    /**
+     * Rearranges the array in ascending order, using the natural order,
+     * with introsort instead of an up-front shuffle.
+     * @param a the array to be sorted
+     */
+    static void intro_sort(std::vector<T>& a)
+    {
+        intro_sort(a, Compare());
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator,
+     * with introsort instead of an up-front shuffle.
+     * @param a the array to be sorted
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void intro_sort(std::vector<T>& a, Less cmp)
+    {
+        intro_sort(a, 0, a.size() - 1, ParallelQuick::depth_limit(a.size()), cmp);
+        assert(is_sorted(a, 0, a.size() - 1, cmp));
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator,
+     * with introsort instead of an up-front shuffle.
+     * @param a the array to be sorted
+     * @param comparator the comparator specifying the order
+     */
+    static void intro_sort(std::vector<T>& a, cmp_func)
+    {
+        intro_sort<bool(*)(T, T)>(a, cmp);
+    }
+
+    /**
+     * Rearranges the array in ascending order, using the natural order,
+     * sorting the two sides of each partition in parallel.
+     * @param a the array to be sorted
+     */
+    static void parallel_sort(std::vector<T>& a)
+    {
+        parallel_sort(a, Compare());
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator,
+     * sorting the two sides of each partition in parallel.
+     * @param a the array to be sorted
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void parallel_sort(std::vector<T>& a, Less cmp)
+    {
+        std::vector<T> aux = std::vector<T>();
+        if (a.size() >= ParallelQuick::PARTITION_GRAIN) aux.resize(a.size());
+        TaskGroup group;
+        parallel_sort(a, aux, 0, a.size() - 1, group, cmp);
+        group.wait();
+        assert(is_sorted(a, 0, a.size() - 1, cmp));
+    }
+
     /**
      * Rearranges the array so that {@code a[k]} contains the kth smallest key;
      * {@code a[0]} through {@code a[k-1]} are less than (or equal to) {@code a[k]}; and
@@ -70,21 +172,124 @@ public:
      * @throws IllegalArgumentException unless {@code 0 <= k < a.size()}
      */
     static T select(std::vector<T>& a, int k)
+    {
+        return select(a, k, Compare());
+    }
+
+    /**
+     * Rearranges the array so that {@code a[k]} contains the kth smallest key
+     * in the order given by the comparator.
+     *
+     * @param  a the array
+     * @param  k the rank of the key
+     * @param  cmp the comparator specifying the order (a functor, lambda or function)
+     * @return the key of rank {@code k}
+     * @throws IllegalArgumentException unless {@code 0 <= k < a.size()}
+     */
+    template <typename Less>
+    static T select(std::vector<T>& a, int k, Less cmp)
     {
         if (k < 0 || k >= a.size())
         {
             error("index is not between 0 and {}: {}", a.size(), k);
         }
-        StdRandom::shuffle(a);
-        int lo = 0, hi = a.size() - 1;
-        while (hi > lo)
+        select(a, 0, a.size() - 1, &k, &k + 1, ParallelQuick::depth_limit(a.size()), cmp);
+        return a[k];
+    }
+
+    /**
+     * Rearranges the array so that {@code a[k]} contains the kth smallest key
+     * for every rank {@code k} in {@code ranks}, with the keys between
+     * two consecutive ranks in between them, and returns those keys.
+     * For example, {@code select(a, { n/2, 9*n/10, 99*n/100 })}.
+     *
+     * @param  a the array
+     * @param  ranks the ranks of the keys, in any order
+     * @return the keys of the given ranks, in the order of {@code ranks}
+     * @throws IllegalArgumentException unless {@code 0 <= k < a.size()} for every rank
+     */
+    static std::vector<T> select(std::vector<T>& a, const std::vector<int>& ranks)
+    {
+        return select(a, ranks, Compare());
+    }
+
+    /**
+     * Rearranges the array so that {@code a[k]} contains the kth smallest key
+     * in the order given by the comparator for every rank {@code k} in {@code ranks}.
+     *
+     * @param  a the array
+     * @param  ranks the ranks of the keys, in any order
+     * @param  cmp the comparator specifying the order (a functor, lambda or function)
+     * @return the keys of the given ranks, in the order of {@code ranks}
+     * @throws IllegalArgumentException unless {@code 0 <= k < a.size()} for every rank
+     */
+    template <typename Less>
+    static std::vector<T> select(std::vector<T>& a, const std::vector<int>& ranks, Less cmp)
+    {
+        std::vector<int> targets = sorted_ranks(a, ranks);
+        select(a, 0, a.size() - 1, targets.data(), targets.data() + targets.size(), ParallelQuick::depth_limit(a.size()), cmp);
+        return keys_of(a, ranks);
+    }
+
+    /**
+     * Rearranges the array so that {@code a[k]} contains the kth smallest key
+     * for every rank {@code k} in {@code ranks}, partitioning in parallel.
+     *
+     * @param  a the array
+     * @param  ranks the ranks of the keys, in any order
+     * @return the keys of the given ranks, in the order of {@code ranks}
+     * @throws IllegalArgumentException unless {@code 0 <= k < a.size()} for every rank
+     */
+    static std::vector<T> parallel_select(std::vector<T>& a, const std::vector<int>& ranks)
+    {
+        return parallel_select(a, ranks, Compare());
+    }
+
+    /**
+     * Rearranges the array so that {@code a[k]} contains the kth smallest key
+     * in the order given by the comparator for every rank {@code k} in {@code ranks},
+     * partitioning in parallel.
+     *
+     * @param  a the array
+     * @param  ranks the ranks of the keys, in any order
+     * @param  cmp the comparator specifying the order (a functor, lambda or function)
+     * @return the keys of the given ranks, in the order of {@code ranks}
+     * @throws IllegalArgumentException unless {@code 0 <= k < a.size()} for every rank
+     */
+    template <typename Less>
+    static std::vector<T> parallel_select(std::vector<T>& a, const std::vector<int>& ranks, Less cmp)
+    {
+        std::vector<int> targets = sorted_ranks(a, ranks);
+        std::vector<T> aux = std::vector<T>();
+        if (a.size() >= ParallelQuick::PARTITION_GRAIN) aux.resize(a.size());
+        TaskGroup group;
+        parallel_select(a, aux, 0, a.size() - 1, targets.data(), targets.data() + targets.size(), group, cmp);
+        group.wait();
+        return keys_of(a, ranks);
+    }
+
+    /**
+     * Returns the quantiles of the keys, rearranging the array as {@code parallel_select} does.
+     * The quantile {@code q} is the smallest key that at least a fraction {@code q} of
+     * the keys are less than or equal to (the key of rank ceil(q n) - 1, or the smallest key).
+     * For example, {@code quantiles(latencies, { 0.5, 0.9, 0.99, 0.999 })}.
+     *
+     * @param  a the array
+     * @param  fractions the quantiles to find, between 0 and 1
+     * @return the quantiles, in the order of {@code fractions}
+     * @throws IllegalArgumentException if the array is empty or a fraction is not between 0 and 1
+     */
+    static std::vector<T> quantiles(std::vector<T>& a, const std::vector<double>& fractions)
+    {
+        if (a.empty()) error("quantiles of an empty array");
+        std::vector<int> ranks = std::vector<int>(fractions.size());
+        for (int i = 0; i < fractions.size(); i++)
         {
-            int i = partition(a, lo, hi);
-            if      (i > k) hi = i - 1;
-            else if (i < k) lo = i + 1;
-            else return a[i];
+            double q = fractions[i];
+            if (!(q >= 0 && q <= 1)) error("quantile is not between 0 and 1: {}", q);
+            ranks[i] = std::max(0, (int) std::ceil(q * a.size()) - 1);
         }
-        return a[lo];
+        return parallel_select(a, ranks);
     }
 
     static bool is_sorted(std::vector<T>& a)
@@ -94,9 +299,7 @@ public:
 
     static bool is_sorted(std::vector<T>& a, int lo, int hi)
     {
-        for (int i = lo + 1; i <= hi; i++)
-            if (less(a[i], a[i-1])) return false;
-        return true;
+        return is_sorted(a, lo, hi, Compare());
     }
 
     static void show(std::vector<T>& a)
@@ -108,16 +311,203 @@ public:
     }
 
 private:
-    static void sort(std::vector<T>& a, int lo, int hi)
+    static const int SELECT_CUTOFF = 16;    // select in subarrays this small by sorting them
+    static const int SAMPLE_CUTOFF = 600;   // select in subarrays larger than this around sampled pivots
+
+    template <typename Less>
+    static void sort(std::vector<T>& a, int lo, int hi, Less cmp)
     {
         if (hi <= lo) return;
-        int j = partition(a, lo, hi);
-        sort(a, lo, j-1);
-        sort(a, j+1, hi);
-        assert(is_sorted(a, lo, hi));
+
+        // small subarrays of primitive keys go to a sorting network
+        if constexpr (SortingNetwork::applies<T, Less>)
+        {
+            if (hi <= lo + SortingNetwork::CUTOFF)
+            {
+                SortingNetwork::sort(a, lo, hi);
+                return;
+            }
+        }
+
+        int j = partition(a, lo, hi, cmp);
+        sort(a, lo, j-1, cmp);
+        sort(a, j+1, hi, cmp);
+        assert(is_sorted(a, lo, hi, cmp));
+    }
+
+    // quicksort a[lo .. hi] on median-of-3 pivots, heapsorting it once depth partitions are used up
+    template <typename Less>
+    static void intro_sort(std::vector<T>& a, int lo, int hi, int depth, Less cmp)
+    {
+        if (hi <= lo) return;
+
+        // small subarrays of primitive keys go to a sorting network
+        if constexpr (SortingNetwork::applies<T, Less>)
+        {
+            if (hi <= lo + SortingNetwork::CUTOFF)
+            {
+                SortingNetwork::sort(a, lo, hi);
+                return;
+            }
+        }
+
+        if (depth == 0)
+        {
+            Heap<T>::sort(a, lo, hi, cmp);
+            return;
+        }
+
+        exch(a, lo, median3(a, lo, lo + (hi - lo)/2, hi, cmp));
+        int j = partition(a, lo, hi, cmp);
+        intro_sort(a, lo, j-1, depth-1, cmp);
+        intro_sort(a, j+1, hi, depth-1, cmp);
     }
 
-    static int partition(std::vector<T>& a, int lo, int hi)
+    // quicksort a[lo .. hi], forking the left side of each partition onto the pool
+    // the random pivot swap and leaf shuffle stand in for the up-front shuffle
+    template <typename Less>
+    static void parallel_sort(std::vector<T>& a, std::vector<T>& aux, int lo, int hi, TaskGroup& group, Less cmp)
+    {
+        if (hi - lo + 1 < ParallelQuick::SORT_GRAIN)
+        {
+            ParallelQuick::shuffle(a, lo, hi);
+            sort(a, lo, hi, cmp);
+            return;
+        }
+
+        int lt, gt;
+        if (hi - lo + 1 >= ParallelQuick::PARTITION_GRAIN)
+        {
+            T v = ParallelQuick::sample_pivot(a, lo, hi, cmp);
+            std::tie(lt, gt) = ParallelQuick::partition(a, aux, lo, hi, v, cmp);
+        }
+        else
+        {
+            exch(a, lo, ParallelQuick::uniform_int(lo, hi));
+            lt = gt = partition(a, lo, hi, cmp);
+        }
+
+        group.run([&a, &aux, lo, lt, &group, cmp] { parallel_sort(a, aux, lo, lt-1, group, cmp); });
+        parallel_sort(a, aux, gt+1, hi, group, cmp);
+    }
+
+    // place the keys of ranks [first, last) of a[lo .. hi], all of them in range and in order:
+    // partition around a key of the middle rank, recurse into the side with fewer ranks and loop
+    // on the other; once depth partitions are used up, sort what remains
+    template <typename Less>
+    static void select(std::vector<T>& a, int lo, int hi, const int* first, const int* last, int depth, Less cmp)
+    {
+        while (first != last)
+        {
+            if (hi - lo < SELECT_CUTOFF || depth == 0)
+            {
+                intro_sort(a, lo, hi, ParallelQuick::depth_limit(hi - lo + 1), cmp);
+                return;
+            }
+            depth--;
+
+            // bring a key of rank about k to a[k]: the key of rank k in a random sample placed around
+            // a[k], the sample shifted away from the nearer end if k is the only rank left
+            const int* mid = first + (last - first) / 2;
+            int k = *mid;
+            int n = hi - lo + 1;
+            if (n > SAMPLE_CUTOFF)
+            {
+                auto [size, rank] = sample_rank(n, k - lo, last - first == 1);
+                int left = std::clamp(k - rank, lo, hi - size + 1);
+                for (int i = left; i < left + size; i++)
+                    exch(a, i, ParallelQuick::uniform_int(lo, hi));
+                select(a, left, left + size - 1, mid, mid + 1, depth, cmp);
+            }
+            else exch(a, k, ParallelQuick::uniform_int(lo, hi));
+
+            exch(a, lo, k);
+            int j = partition(a, lo, hi, cmp);
+            const int* split = std::lower_bound(first, last, j);
+            const int* after = (split != last && *split == j) ? split + 1 : split;
+            if (split - first < last - after)
+            {
+                select(a, lo, j-1, first, split, depth, cmp);
+                lo = j + 1;
+                first = after;
+            }
+            else
+            {
+                select(a, j+1, hi, after, last, depth, cmp);
+                hi = j - 1;
+                last = split;
+            }
+        }
+    }
+
+    // place the keys of ranks [first, last) of a[lo .. hi], partitioning large subarrays in parallel
+    // around a sampled key and forking the side of lower ranks onto the pool
+    template <typename Less>
+    static void parallel_select(std::vector<T>& a, std::vector<T>& aux, int lo, int hi,
+        const int* first, const int* last, TaskGroup& group, Less cmp)
+    {
+        if (first == last) return;
+        int n = hi - lo + 1;
+        if (n < ParallelQuick::PARTITION_GRAIN)
+        {
+            select(a, lo, hi, first, last, ParallelQuick::depth_limit(n), cmp);
+            return;
+        }
+
+        const int* mid = first + (last - first) / 2;
+        auto [size, rank] = sample_rank(n, *mid - lo, last - first == 1);
+        std::vector<T> sample = std::vector<T>();
+        sample.reserve(size);
+        for (int i = 0; i < size; i++)
+            sample.push_back(a[ParallelQuick::uniform_int(lo, hi)]);
+        std::nth_element(sample.begin(), sample.begin() + rank, sample.end(), cmp);
+
+        auto [lt, gt] = ParallelQuick::partition(a, aux, lo, hi, sample[rank], cmp);
+        const int* split = std::lower_bound(first, last, lt);
+        const int* after = std::upper_bound(split, last, gt);
+        group.run([&a, &aux, lo, lt, first, split, &group, cmp] { parallel_select(a, aux, lo, lt-1, first, split, group, cmp); });
+        parallel_select(a, aux, gt+1, hi, after, last, group, cmp);
+    }
+
+    // Floyd and Rivest's sample for the key of rank i of n: its size, about n^(2/3), and the
+    // rank in the sample of the key to partition on; with bias, that key is a little past
+    // rank i, away from the nearer end, so that rank i most likely ends up on the smaller side
+    static std::pair<int, int> sample_rank(int n, int i, bool bias)
+    {
+        double z = std::log(n);
+        double s = 0.5 * std::exp(2 * z / 3);
+        double sd = bias ? 0.5 * std::sqrt(z * s * (n - s) / n) * (i < n / 2 ? -1 : 1) : 0;
+        int size = (int) s;
+        return std::make_pair(size, std::clamp((int) (i * s / n - sd), 0, size - 1));
+    }
+
+    // the ranks sorted without duplicates, after checking them
+    static std::vector<int> sorted_ranks(const std::vector<T>& a, const std::vector<int>& ranks)
+    {
+        for (int k : ranks)
+        {
+            if (k < 0 || k >= a.size())
+            {
+                error("index is not between 0 and {}: {}", a.size(), k);
+            }
+        }
+        std::vector<int> sorted = ranks;
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        return sorted;
+    }
+
+    static std::vector<T> keys_of(const std::vector<T>& a, const std::vector<int>& ranks)
+    {
+        std::vector<T> keys = std::vector<T>();
+        keys.reserve(ranks.size());
+        for (int k : ranks)
+            keys.push_back(a[k]);
+        return keys;
+    }
+
+    template <typename Less>
+    static int partition(std::vector<T>& a, int lo, int hi, Less cmp)
     {
         int i = lo;
         int j = hi + 1;
@@ -126,13 +516,13 @@ private:
         {
 
             // find item on lo to swap
-            while (less(a[++i], v))
+            while (less(a[++i], v, cmp))
             {
                 if (i == hi) break;
             }
 
             // find item on hi to swap
-            while (less(v, a[--j]))
+            while (less(v, a[--j], cmp))
             {
                 if (j == lo) break;      // redundant since a[lo] acts as sentinel
             }
@@ -150,17 +540,33 @@ private:
         return j;
     }
 
-    static bool less(T v, T w)
+    // return the index of the median element among a[i], a[j], and a[k]
+    template <typename Less>
+    static int median3(std::vector<T>& a, int i, int j, int k, Less cmp)
+    {
+        return (less(a[i], a[j], cmp) ?
+               (less(a[j], a[k], cmp) ? j : less(a[i], a[k], cmp) ? k : i) :
+               (less(a[k], a[j], cmp) ? j : less(a[k], a[i], cmp) ? k : i));
+    }
+
+    template <typename Less>
+    static bool is_sorted(std::vector<T>& a, int lo, int hi, Less cmp)
+    {
+        for (int i = lo + 1; i <= hi; i++)
+            if (less(a[i], a[i-1], cmp)) return false;
+        return true;
+    }
+
+    template <typename Less>
+    static bool less(const T& v, const T& w, Less cmp)
     {
-        if (v == w) return false;   // optimization when reference equals
-        return v < w;
+        return cmp(v, w);
     }
 
     static void exch(std::vector<T>& a, int i, int j)
     {
-        T swap = a[i];
-        a[i] = a[j];
-        a[j] = swap;
+        using std::swap;
+        swap(a[i], a[j]);
     }
 };
 
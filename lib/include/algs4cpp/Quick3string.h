@@ -0,0 +1,280 @@
+#ifndef QUICK3STRING_H
+#define QUICK3STRING_H
+
+#include "ParallelQuick.h"
+#include "StdOut.h"
+#include "StdRandom.h"
+
+/******************************************************************************
+ *  Compilation:  javac Quick3string.java
+ *  Execution:    java Quick3string < input.txt
+ *  Dependencies: StdIn.java StdOut.java
+ *  Data files:   https://algs4.cs.princeton.edu/51radix/words3.txt
+ *                https://algs4.cs.princeton.edu/51radix/shells.txt
+ *
+ *  Reads string from standard input and 3-way string quicksort them.
+ *
+ *  % java Quick3string < shell.txt
+ *  are
+ *  by
+ *  sea
+ *  seashells
+ *  seashells
+ *  sells
+ *  sells
+ *  she
+ *  she
+ *  shells
+ *  shore
+ *  surely
+ *  the
+ *  the
+ *
+ *
+ ******************************************************************************/
+
+/**
+ *  The {@code Quick3string} class provides static methods for sorting an
+ *  array of strings using 3-way radix quicksort.
+ *  <p>
+ *  Partitioning looks at one character per string, so a shared prefix is
+ *  scanned once per string instead of once per comparison. Strings are
+ *  swapped, never copied, and subarrays of at most {@code CUTOFF} strings
+ *  are insertion sorted comparing only from the current character on.
+ *  <p>
+ *  {@code T} is a string type with {@code size()}, {@code operator[]} and
+ *  {@code compare()}, such as {@code std::string} or {@code std::string_view}.
+ *  <p>
+ *  For additional documentation,
+ *  see <a href="https://algs4.cs.princeton.edu/51radix">Section 5.1</a> of
+ *  <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
+ *
+ *  @author Robert Sedgewick
+ *  @author Kevin Wayne
+ */
+template <typename T>
+class Quick3string
+{
+public:
+    /**
+     * Rearranges the array of strings in ascending order.
+     *
+     * @param a the array to be sorted
+     */
+    static void sort(std::vector<T>& a)
+    {
+        StdRandom::shuffle(a);
+        sort(a, 0, a.size()-1, 0);
+        assert(is_sorted(a));
+    }
+
+    /**
+     * Rearranges the array of strings in ascending order, comparing cached prefixes.
+     * <p>
+     * Every string is paired with the next 8 bytes of its key as a big-endian
+     * integer and a pointer to it, and the pairs are 3-way quicksorted on the
+     * integers, 8 bytes at a time instead of 1. A group of strings whose
+     * prefixes tie moves on to the next 8 bytes, reloading only their
+     * prefixes, so long shared prefixes (URLs, paths) are read once per
+     * partitioning level. Small groups are insertion sorted on the prefixes,
+     * comparing the strings themselves only on ties. The strings are then
+     * moved, never copied, into their sorted order.
+     *
+     * @param a the array to be sorted
+     */
+    static void prefix_sort(std::vector<T>& a)
+    {
+        int n = a.size();
+        std::vector<Prefixed> items = std::vector<Prefixed>(n);
+        for (int i = 0; i < n; i++)
+            items[i] = Prefixed { prefix(a[i], 0), &a[i] };
+        prefix_sort(items, 0, n - 1, 0);
+
+        std::vector<T> sorted = std::vector<T>();
+        sorted.reserve(n);
+        for (const Prefixed& item : items)
+            sorted.push_back(std::move(*item.s));
+        a = std::move(sorted);
+        assert(is_sorted(a));
+    }
+
+    // print array to standard output
+    static void show(std::vector<T>& a)
+    {
+        for (int i = 0; i < a.size(); i++)
+        {
+            StdOut::println(a[i]);
+        }
+    }
+
+private:
+    static const int CUTOFF = 15;   // cutoff to insertion sort
+
+    // return the dth character of s, -1 if d = length of s
+    static int char_at(const T& s, int d)
+    {
+        assert(d >= 0 && d <= s.size());
+        if (d == s.size()) return -1;
+        return (uint8_t) s[d];
+    }
+
+    // 3-way string quicksort a[lo..hi] starting at dth character
+    static void sort(std::vector<T>& a, int lo, int hi, int d)
+    {
+        // cutoff to insertion sort for small subarrays
+        if (hi <= lo + CUTOFF)
+        {
+            insertion(a, lo, hi, d);
+            return;
+        }
+
+        int lt = lo, gt = hi;
+        int v = char_at(a[lo], d);
+        int i = lo + 1;
+        while (i <= gt)
+        {
+            int t = char_at(a[i], d);
+            if      (t < v) exch(a, lt++, i++);
+            else if (t > v) exch(a, i, gt--);
+            else            i++;
+        }
+
+        // a[lo..lt-1] < v = a[lt..gt] < a[gt+1..hi].
+        sort(a, lo, lt-1, d);
+        if (v >= 0) sort(a, lt, gt, d+1);
+        sort(a, gt+1, hi, d);
+    }
+
+    // a string and its 8 bytes from some depth d on
+    struct Prefixed
+    {
+        uint64_t prefix;    // bytes d .. d+7 of *s, big-endian, padded with zeros past its end
+        T* s;
+    };
+
+    // bytes d .. d+7 of s as a big-endian integer, so that integer order is string order
+    static uint64_t prefix(const T& s, int d)
+    {
+        uint64_t prefix = 0;
+        if (d + 8 <= s.size())
+        {
+            const char* p = s.data() + d;
+            for (int i = 0; i < 8; i++)
+                prefix = prefix << 8 | (uint8_t) p[i];
+        }
+        else
+        {
+            for (int i = 0; i < 8; i++)
+                prefix = prefix << 8 | (d + i < s.size() ? (uint8_t) s[d + i] : 0);
+        }
+        return prefix;
+    }
+
+    // 3-way radix quicksort of a[lo..hi] on the 8 bytes starting at the dth character
+    static void prefix_sort(std::vector<Prefixed>& a, int lo, int hi, int d)
+    {
+        if (hi <= lo + CUTOFF)
+        {
+            prefix_insertion(a, lo, hi, d);
+            return;
+        }
+
+        std::swap(a[lo], a[ParallelQuick::uniform_int(lo, hi)]);
+        int lt = lo, gt = hi;
+        uint64_t v = a[lo].prefix;
+        int i = lo + 1;
+        while (i <= gt)
+        {
+            uint64_t t = a[i].prefix;
+            if      (t < v) std::swap(a[lt++], a[i++]);
+            else if (t > v) std::swap(a[i], a[gt--]);
+            else            i++;
+        }
+        prefix_sort(a, lo, lt-1, d);
+        prefix_sort(a, gt+1, hi, d);
+
+        // a[lt..gt] agree on 8 bytes: the strings that end within them come first, shortest first,
+        // and the rest go on to the next 8 bytes
+        int mid = lt;
+        for (int i = lt; i <= gt; i++)
+            if (a[i].s->size() <= d + 8) std::swap(a[i], a[mid++]);
+        std::sort(a.begin() + lt, a.begin() + mid, [](const Prefixed& x, const Prefixed& y) { return x.s->size() < y.s->size(); });
+        for (int i = mid; i <= gt; i++)
+            a[i].prefix = prefix(*a[i].s, d + 8);
+        prefix_sort(a, mid, gt, d + 8);
+    }
+
+    // sort from a[lo] to a[hi] on their prefixes, and on the strings from the dth character on ties
+    static void prefix_insertion(std::vector<Prefixed>& a, int lo, int hi, int d)
+    {
+        for (int i = lo + 1; i <= hi; i++)
+        {
+            Prefixed v = a[i];
+            int j = i;
+            for (; j > lo && prefix_less(v, a[j-1], d); j--)
+                a[j] = a[j-1];
+            a[j] = v;
+        }
+    }
+
+    static bool prefix_less(const Prefixed& v, const Prefixed& w, int d)
+    {
+        if (v.prefix != w.prefix) return v.prefix < w.prefix;
+        return less(*v.s, *w.s, d);
+    }
+
+    // sort from a[lo] to a[hi], starting at the dth character
+    static void insertion(std::vector<T>& a, int lo, int hi, int d)
+    {
+        for (int i = lo; i <= hi; i++)
+            for (int j = i; j > lo && less(a[j], a[j-1], d); j--)
+                exch(a, j, j-1);
+    }
+
+    // exchange a[i] and a[j]
+    static void exch(std::vector<T>& a, int i, int j)
+    {
+        std::swap(a[i], a[j]);
+    }
+
+    // is v less than w, starting at character d
+    static bool less(const T& v, const T& w, int d)
+    {
+        assert(d <= v.size() && d <= w.size());
+        return v.compare(d, T::npos, w, d, T::npos) < 0;
+    }
+
+    // is the array sorted
+    static bool is_sorted(std::vector<T>& a)
+    {
+        for (int i = 1; i < a.size(); i++)
+            if (a[i] < a[i-1]) return false;
+        return true;
+    }
+};
+
+/******************************************************************************
+ *  Copyright 2002-2022, Robert Sedgewick and Kevin Wayne.
+ *
+ *  This file is part of algs4.jar, which accompanies the textbook
+ *
+ *      Algorithms, 4th edition by Robert Sedgewick and Kevin Wayne,
+ *      Addison-Wesley Professional, 2011, ISBN 0-321-57351-X.
+ *      http://algs4.cs.princeton.edu
+ *
+ *
+ *  algs4.jar is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  algs4.jar is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with algs4.jar.  If not, see http://www.gnu.org/licenses.
+ ******************************************************************************/
+
+#endif
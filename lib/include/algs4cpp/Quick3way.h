@@ -1,6 +1,8 @@
 #ifndef QUICK3WAY_H
 #define QUICK3WAY_H
 
+#include "ParallelQuick.h"
+#include "SortingNetwork.h"
 #include "StdOut.h"
 #include "StdRandom.h"
 
@@ -31,6 +33,11 @@
  *  The {@code Quick3way} class provides static methods for sorting an
  *  array using quicksort with 3-way partitioning.
  *  <p>
+ *  The {@code parallel_sort} method sorts the two sides of every large
+ *  partition concurrently on the shared {@link ThreadPool}; see {@link ParallelQuick}.
+ *  Keys equal to the partitioning item are never revisited, so inputs with
+ *  many duplicates split into little work.
+ *  <p>
  *  For additional documentation, see
  *  <a href="https://algs4.cs.princeton.edu/23quicksort">Section 2.3</a>
  *  of <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
@@ -39,7 +46,7 @@
  *  @author Kevin Wayne
  */
 
-template <typename T>
+template <typename T, typename Compare = std::less<T>>
 class Quick3way
 {
 public:
@@ -48,30 +55,77 @@ public:
      * @param a the array to be sorted
      */
     static void sort(std::vector<T>& a)
+    {
+        sort(a, Compare());
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator.
+     * @param a the array to be sorted
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void sort(std::vector<T>& a, Less cmp)
     {
         StdRandom::shuffle(a);
-        sort(a, 0, a.size() - 1);
-        assert(is_sorted(a));
+        sort(a, 0, a.size() - 1, cmp);
+        assert(is_sorted(a, 0, a.size() - 1, cmp));
+    }
+
+    /**
+     * Rearranges the array in ascending order, using the natural order,
+     * sorting the two sides of each partition in parallel.
+     * @param a the array to be sorted
+     */
+    static void parallel_sort(std::vector<T>& a)
+    {
+        parallel_sort(a, Compare());
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator,
+     * sorting the two sides of each partition in parallel.
+     * @param a the array to be sorted
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void parallel_sort(std::vector<T>& a, Less cmp)
+    {
+        std::vector<T> aux = std::vector<T>();
+        if (a.size() >= ParallelQuick::PARTITION_GRAIN) aux.resize(a.size());
+        TaskGroup group;
+        parallel_sort(a, aux, 0, a.size() - 1, group, cmp);
+        group.wait();
+        assert(is_sorted(a, 0, a.size() - 1, cmp));
     }
 
     // quicksort the subarray a[lo .. hi] using 3-way partitioning
     static void sort(std::vector<T>& a, int lo, int hi)
+    {
+        sort(a, lo, hi, Compare());
+    }
+
+    // quicksort the subarray a[lo .. hi] using 3-way partitioning and a comparator
+    template <typename Less>
+    static void sort(std::vector<T>& a, int lo, int hi, Less cmp)
     {
         if (hi <= lo) return;
-        int lt = lo, gt = hi;
-        T v = a[lo];
-        int i = lo + 1;
-        while (i <= gt)
+
+        // small subarrays of primitive keys go to a sorting network
+        if constexpr (SortingNetwork::applies<T, Less>)
         {
-            if      (a[i] < v) exch(a, lt++, i++);
-            else if (a[i] > v) exch(a, i, gt--);
-            else              i++;
+            if (hi <= lo + SortingNetwork::CUTOFF)
+            {
+                SortingNetwork::sort(a, lo, hi);
+                return;
+            }
         }
 
-        // a[lo..lt-1] < v = a[lt..gt] < a[gt+1..hi].
-        sort(a, lo, lt-1);
-        sort(a, gt+1, hi);
-        assert(is_sorted(a, lo, hi));
+        int lt, gt;
+        partition(a, lo, hi, lt, gt, cmp);
+        sort(a, lo, lt-1, cmp);
+        sort(a, gt+1, hi, cmp);
+        assert(is_sorted(a, lo, hi, cmp));
     }
     
     /***************************************************************************
@@ -84,9 +138,7 @@ public:
 
     static bool is_sorted(std::vector<T>& a, int lo, int hi)
     {
-        for (int i = lo + 1; i <= hi; i++)
-            if (less(a[i], a[i-1])) return false;
-        return true;
+        return is_sorted(a, lo, hi, Compare());
     }
 
     // print array to standard output
@@ -99,24 +151,74 @@ public:
     }
 
 private:
+    // partition a[lo .. hi] around a[lo] so that a[lo..lt-1] < v = a[lt..gt] < a[gt+1..hi]
+    template <typename Less>
+    static void partition(std::vector<T>& a, int lo, int hi, int& lt, int& gt, Less cmp)
+    {
+        lt = lo;
+        gt = hi;
+        T v = a[lo];
+        int i = lo + 1;
+        while (i <= gt)
+        {
+            if      (less(a[i], v, cmp)) exch(a, lt++, i++);
+            else if (less(v, a[i], cmp)) exch(a, i, gt--);
+            else                         i++;
+        }
+    }
+
+    // quicksort a[lo .. hi], forking the left side of each partition onto the pool
+    // the random pivot swap and leaf shuffle stand in for the up-front shuffle
+    template <typename Less>
+    static void parallel_sort(std::vector<T>& a, std::vector<T>& aux, int lo, int hi, TaskGroup& group, Less cmp)
+    {
+        if (hi - lo + 1 < ParallelQuick::SORT_GRAIN)
+        {
+            ParallelQuick::shuffle(a, lo, hi);
+            sort(a, lo, hi, cmp);
+            return;
+        }
+
+        int lt, gt;
+        if (hi - lo + 1 >= ParallelQuick::PARTITION_GRAIN)
+        {
+            T v = ParallelQuick::sample_pivot(a, lo, hi, cmp);
+            std::tie(lt, gt) = ParallelQuick::partition(a, aux, lo, hi, v, cmp);
+        }
+        else
+        {
+            exch(a, lo, ParallelQuick::uniform_int(lo, hi));
+            partition(a, lo, hi, lt, gt, cmp);
+        }
+
+        group.run([&a, &aux, lo, lt, &group, cmp] { parallel_sort(a, aux, lo, lt-1, group, cmp); });
+        parallel_sort(a, aux, gt+1, hi, group, cmp);
+    }
 
    /***************************************************************************
     *  Helper sorting functions.
     ***************************************************************************/
 
     // is v < w ?
-    static bool less(T v, T w)
+    template <typename Less>
+    static bool less(const T& v, const T& w, Less cmp)
     {
-        return v < w;
-
+        return cmp(v, w);
     }
 
     // exchange a[i] and a[j]
     static void exch(std::vector<T>& a, int i, int j)
     {
-        T swap = a[i];
-        a[i] = a[j];
-        a[j] = swap;
+        using std::swap;
+        swap(a[i], a[j]);
+    }
+
+    template <typename Less>
+    static bool is_sorted(std::vector<T>& a, int lo, int hi, Less cmp)
+    {
+        for (int i = lo + 1; i <= hi; i++)
+            if (less(a[i], a[i-1], cmp)) return false;
+        return true;
     }
 };
 
@@ -1,6 +1,10 @@
 #ifndef QUICKBENTLEYMCILROY_H
 #define QUICKBENTLEYMCILROY_H
 
+#include "Heap.h"
+#include "ParallelQuick.h"
+#include "SortCutoffs.h"
+#include "SortingNetwork.h"
 #include "StdOut.h"
 
 /******************************************************************************
@@ -25,6 +29,10 @@
  *  an array using an optimized version of quicksort (using Bentley-McIlroy
  *  3-way partitioning, Tukey's ninther, and cutoff to insertion sort).
  *  <p>
+ *  A subarray nested more than 2 lg <em>n</em> partitions deep is heapsorted
+ *  instead (introsort), so inputs crafted against the ninther take
+ *  ~ <em>n</em> lg <em>n</em> compares, not ~ <em>n</em><sup>2</sup>/2.
+ *  <p>
  *  For additional documentation, see
  *  <a href="https://algs4.cs.princeton.edu/23quicksort">Section 2.3</a>
  *  of <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
@@ -32,7 +40,7 @@
  *  @author Robert Sedgewick
  *  @author Kevin Wayne
  */
-template <typename T>
+template <typename T, typename Compare = std::less<T>>
 class QuickBentleyMcIlroy
 {
 public:
@@ -42,7 +50,18 @@ public:
      */
     static void sort(std::vector<T>& a)
     {
-        sort(a, 0, a.size() - 1);
+        sort(a, Compare());
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator.
+     * @param a the array to be sorted
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void sort(std::vector<T>& a, Less cmp)
+    {
+        sort(a, 0, a.size() - 1, ParallelQuick::depth_limit(a.size()), cmp);
     }
 
     /***************************************************************************
@@ -50,8 +69,9 @@ public:
     ***************************************************************************/
     static bool is_sorted(std::vector<T>& a)
     {
+        Compare cmp = Compare();
         for (int i = 1; i < a.size(); i++)
-            if (less(a[i], a[i-1])) return false;
+            if (less(a[i], a[i-1], cmp)) return false;
         return true;
     }
 
@@ -66,26 +86,36 @@ public:
 
 private:
     // cutoff to insertion sort, must be >= 1
-    static const int INSERTION_SORT_CUTOFF = 8;
+    static const int INSERTION_SORT_CUTOFF = SortCutoffs::of<T>.insertion;
 
     // cutoff to median-of-3 partitioning
-    static const int MEDIAN_OF_3_CUTOFF = 40;
+    static const int MEDIAN_OF_3_CUTOFF = SortCutoffs::of<T>.median_of_3;
 
-    static void sort(std::vector<T>& a, int lo, int hi)
+    // quicksort a[lo .. hi], heapsorting it once depth partitions are used up
+    template <typename Less>
+    static void sort(std::vector<T>& a, int lo, int hi, int depth, Less cmp)
     {
         int n = hi - lo + 1;
 
         // cutoff to insertion sort
-        if (n <= INSERTION_SORT_CUTOFF)
+        if (n <= SortingNetwork::cutoff<T, Less>(INSERTION_SORT_CUTOFF))
+        {
+            if constexpr (SortingNetwork::applies<T, Less>) SortingNetwork::sort(a, lo, hi);
+            else                                            insertion_sort(a, lo, hi, cmp);
+            return;
+        }
+
+        // partitions keep coming out lopsided
+        if (depth == 0)
         {
-            insertion_sort(a, lo, hi);
+            Heap<T>::sort(a, lo, hi, cmp);
             return;
         }
 
         // use median-of-3 as partitioning element
         else if (n <= MEDIAN_OF_3_CUTOFF)
         {
-            int m = median3(a, lo, lo + n/2, hi);
+            int m = median3(a, lo, lo + n/2, hi, cmp);
             exch(a, m, lo);
         }
 
@@ -94,10 +124,10 @@ private:
         {
             int eps = n/8;
             int mid = lo + n/2;
-            int m1 = median3(a, lo, lo + eps, lo + eps + eps);
-            int m2 = median3(a, mid - eps, mid, mid + eps);
-            int m3 = median3(a, hi - eps - eps, hi - eps, hi);
-            int ninther = median3(a, m1, m2, m3);
+            int m1 = median3(a, lo, lo + eps, lo + eps + eps, cmp);
+            int m2 = median3(a, mid - eps, mid, mid + eps, cmp);
+            int m3 = median3(a, hi - eps - eps, hi - eps, hi, cmp);
+            int ninther = median3(a, m1, m2, m3, cmp);
             exch(a, ninther, lo);
         }
 
@@ -107,19 +137,19 @@ private:
         T v = a[lo];
         while (true)
         {
-            while (less(a[++i], v))
+            while (less(a[++i], v, cmp))
                 if (i == hi) break;
-            while (less(v, a[--j]))
+            while (less(v, a[--j], cmp))
                 if (j == lo) break;
 
             // pointers cross
-            if (i == j && eq(a[i], v))
+            if (i == j && eq(a[i], v, cmp))
                 exch(a, ++p, i);
             if (i >= j) break;
 
             exch(a, i, j);
-            if (eq(a[i], v)) exch(a, ++p, i);
-            if (eq(a[j], v)) exch(a, --q, j);
+            if (eq(a[i], v, cmp)) exch(a, ++p, i);
+            if (eq(a[j], v, cmp)) exch(a, --q, j);
         }
 
 
@@ -129,26 +159,28 @@ private:
         for (int k = hi; k >= q; k--)
             exch(a, k, i++);
 
-        sort(a, lo, j);
-        sort(a, i, hi);
+        sort(a, lo, j, depth-1, cmp);
+        sort(a, i, hi, depth-1, cmp);
     }
 
 
     // sort from a[lo] to a[hi] using insertion sort
-    static void insertion_sort(std::vector<T>& a, int lo, int hi)
+    template <typename Less>
+    static void insertion_sort(std::vector<T>& a, int lo, int hi, Less cmp)
     {
         for (int i = lo; i <= hi; i++)
-            for (int j = i; j > lo && less(a[j], a[j-1]); j--)
+            for (int j = i; j > lo && less(a[j], a[j-1], cmp); j--)
                 exch(a, j, j-1);
     }
 
 
     // return the index of the median element among a[i], a[j], and a[k]
-    static int median3(std::vector<T>& a, int i, int j, int k)
+    template <typename Less>
+    static int median3(std::vector<T>& a, int i, int j, int k, Less cmp)
     {
-        return (less(a[i], a[j]) ?
-               (less(a[j], a[k]) ? j : less(a[i], a[k]) ? k : i) :
-               (less(a[k], a[j]) ? j : less(a[k], a[i]) ? k : i));
+        return (less(a[i], a[j], cmp) ?
+               (less(a[j], a[k], cmp) ? j : less(a[i], a[k], cmp) ? k : i) :
+               (less(a[k], a[j], cmp) ? j : less(a[k], a[i], cmp) ? k : i));
     }
 
    /***************************************************************************
@@ -156,25 +188,24 @@ private:
     ***************************************************************************/
 
     // is v < w ?
-    static bool less(T v, T w)
+    template <typename Less>
+    static bool less(const T& v, const T& w, Less cmp)
     {
-        if (v == w) return false;    // optimization when reference equal
-        return v < w;
+        return cmp(v, w);
     }
 
-    // does v == w ?
-    static bool eq(T v, T w)
+    // is v equivalent to w under the order ?
+    template <typename Less>
+    static bool eq(const T& v, const T& w, Less cmp)
     {
-        if (v == w) return true;    // optimization when reference equal
-        return v == w;
+        return !cmp(v, w) && !cmp(w, v);
     }
 
     // exchange a[i] and a[j]
     static void exch(std::vector<T>& a, int i, int j)
     {
-        T swap = a[i];
-        a[i] = a[j];
-        a[j] = swap;
+        using std::swap;
+        swap(a[i], a[j]);
     }
 };
 
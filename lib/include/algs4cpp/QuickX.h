@@ -1,7 +1,11 @@
 #ifndef QUICKX_H
 #define QUICKX_H
 
+#include "Heap.h"
 #include "Insertion.h"
+#include "ParallelQuick.h"
+#include "SortCutoffs.h"
+#include "SortingNetwork.h"
 #include "StdOut.h"
 
 /******************************************************************************
@@ -22,6 +26,20 @@
  *  algorithm, median-of-3 to choose the partitioning element, and cutoff
  *  to insertion sort).
  *  <p>
+ *  There is no up-front shuffle, so a subarray nested more than
+ *  2 lg <em>n</em> partitions deep is heapsorted instead (introsort): inputs
+ *  crafted against median-of-3 take ~ <em>n</em> lg <em>n</em> compares, not
+ *  ~ <em>n</em><sup>2</sup>/2.
+ *  <p>
+ *  With {@code Partitioning::BLOCK} (the default for arithmetic keys), each
+ *  side of the partition compares {@code BLOCK} keys at a time, recording the
+ *  offsets of keys on the wrong side without branching on the outcome, and
+ *  then swaps the recorded keys in pairs (BlockQuicksort). Random keys no
+ *  longer mispredict half of the branches of Hoare's scan loops.
+ *  <p>
+ *  The {@code parallel_sort} method sorts the two sides of every large
+ *  partition concurrently on the shared {@link ThreadPool}; see {@link ParallelQuick}.
+ *  <p>
  *  For additional documentation, see
  *  <a href="https://algs4.cs.princeton.edu/23quicksort">Section 2.3</a>
  *  of <i>Algorithms, 4th Edition</i> by Robert Sedgewick and Kevin Wayne.
@@ -29,20 +47,99 @@
  *  @author Robert Sedgewick
  *  @author Kevin Wayne
  */
-template <typename T>
+template <typename T, typename Compare = std::less<T>>
 class QuickX
 {
 public:
-    
+    // how to partition: Hoare's scan loops, or blocks of branch-free compares
+    enum class Partitioning { HOARE, BLOCK };
+
+    // block partitioning pays off when compares are cheap
+    static const Partitioning DEFAULT_PARTITIONING = std::is_arithmetic_v<T> ? Partitioning::BLOCK : Partitioning::HOARE;
+
     /**
      * Rearranges the array in ascending order, using the natural order.
      * @param a the array to be sorted
      */
     static void sort(std::vector<T>& a)
     {
-        // StdRandom.shuffle(a);
-        sort(a, 0, a.size() - 1);
-        assert(is_sorted(a));
+        sort(a, Compare());
+    }
+
+    /**
+     * Rearranges the array in ascending order, using the natural order
+     * and the given partitioning scheme.
+     * @param a the array to be sorted
+     * @param partitioning the partitioning scheme
+     */
+    static void sort(std::vector<T>& a, Partitioning partitioning)
+    {
+        sort(a, Compare(), partitioning);
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator.
+     * @param a the array to be sorted
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void sort(std::vector<T>& a, Less cmp)
+    {
+        sort(a, cmp, DEFAULT_PARTITIONING);
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator
+     * and the given partitioning scheme.
+     * @param a the array to be sorted
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     * @param partitioning the partitioning scheme
+     */
+    template <typename Less>
+    static void sort(std::vector<T>& a, Less cmp, Partitioning partitioning)
+    {
+        sort(a, 0, a.size() - 1, ParallelQuick::depth_limit(a.size()), partitioning, cmp);
+        assert(is_sorted(a, cmp));
+    }
+
+    /**
+     * Rearranges the subarray a[lo .. hi] in ascending order, using a comparator.
+     * @param a the array
+     * @param lo the index of the first key to sort
+     * @param hi the index of the last key to sort
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void sort(std::vector<T>& a, int lo, int hi, Less cmp)
+    {
+        sort(a, lo, hi, ParallelQuick::depth_limit(hi - lo + 1), DEFAULT_PARTITIONING, cmp);
+    }
+
+    /**
+     * Rearranges the array in ascending order, using the natural order,
+     * sorting the two sides of each partition in parallel.
+     * @param a the array to be sorted
+     */
+    static void parallel_sort(std::vector<T>& a)
+    {
+        parallel_sort(a, Compare());
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator,
+     * sorting the two sides of each partition in parallel.
+     * @param a the array to be sorted
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void parallel_sort(std::vector<T>& a, Less cmp)
+    {
+        std::vector<T> aux = std::vector<T>();
+        if (a.size() >= ParallelQuick::PARTITION_GRAIN) aux.resize(a.size());
+        TaskGroup group;
+        parallel_sort(a, aux, 0, a.size() - 1, ParallelQuick::depth_limit(a.size()), DEFAULT_PARTITIONING, group, cmp);
+        group.wait();
+        assert(is_sorted(a, cmp));
     }
 
     // print array to standard output
@@ -59,39 +156,76 @@ public:
     ***************************************************************************/
     static bool is_sorted(std::vector<T>& a)
     {
-        for (int i = 1; i < a.size(); i++)
-            if (less(a[i], a[i-1])) return false;
-        return true;
+        return is_sorted(a, Compare());
     }
 
 private:
     // cutoff to insertion sort, must be >= 1
-    static const int INSERTION_SORT_CUTOFF = 8;
+    static const int INSERTION_SORT_CUTOFF = SortCutoffs::of<T>.insertion;
 
-    // quicksort the subarray from a[lo] to a[hi]
-    static void sort(std::vector<T>& a, int lo, int hi)
+    // keys compared at a time by block partitioning, at most 256 for the byte offsets
+    static const int BLOCK = 64;
+
+    // quicksort the subarray from a[lo] to a[hi], heapsorting it once depth partitions are used up
+    template <typename Less>
+    static void sort(std::vector<T>& a, int lo, int hi, int depth, Partitioning partitioning, Less cmp)
     {
         if (hi <= lo) return;
 
         // cutoff to insertion sort (Insertion.sort() uses half-open intervals)
         int n = hi - lo + 1;
-        if (n <= INSERTION_SORT_CUTOFF)
+        if (n <= SortingNetwork::cutoff<T, Less>(INSERTION_SORT_CUTOFF))
         {
-            Insertion<T>::sort(a, lo, hi + 1);
+            if constexpr (SortingNetwork::applies<T, Less>) SortingNetwork::sort(a, lo, hi);
+            else                                            Insertion<T>::sort(a, lo, hi + 1, cmp);
             return;
         }
 
-        int j = partition(a, lo, hi);
-        sort(a, lo, j-1);
-        sort(a, j+1, hi);
+        if (depth == 0)
+        {
+            Heap<T>::sort(a, lo, hi, cmp);
+            return;
+        }
+
+        int j = partitioning == Partitioning::BLOCK ? block_partition(a, lo, hi, cmp) : partition(a, lo, hi, cmp);
+        sort(a, lo, j-1, depth-1, partitioning, cmp);
+        sort(a, j+1, hi, depth-1, partitioning, cmp);
+    }
+
+    // quicksort a[lo .. hi], forking the left side of each partition onto the pool
+    template <typename Less>
+    static void parallel_sort(std::vector<T>& a, std::vector<T>& aux, int lo, int hi, int depth, Partitioning partitioning,
+        TaskGroup& group, Less cmp)
+    {
+        if (hi - lo + 1 < ParallelQuick::SORT_GRAIN || depth == 0)
+        {
+            sort(a, lo, hi, depth, partitioning, cmp);
+            return;
+        }
+
+        int lt, gt;
+        if (hi - lo + 1 >= ParallelQuick::PARTITION_GRAIN)
+        {
+            T v = ParallelQuick::sample_pivot(a, lo, hi, cmp);
+            std::tie(lt, gt) = ParallelQuick::partition(a, aux, lo, hi, v, cmp);
+        }
+        else
+        {
+            lt = gt = partitioning == Partitioning::BLOCK ? block_partition(a, lo, hi, cmp) : partition(a, lo, hi, cmp);
+        }
+
+        group.run([&a, &aux, lo, lt, depth, partitioning, &group, cmp]
+            { parallel_sort(a, aux, lo, lt-1, depth-1, partitioning, group, cmp); });
+        parallel_sort(a, aux, gt+1, hi, depth-1, partitioning, group, cmp);
     }
 
     // partition the subarray a[lo..hi] so that a[lo..j-1] <= a[j] <= a[j+1..hi]
     // and return the index j.
-    static int partition(std::vector<T>& a, int lo, int hi)
+    template <typename Less>
+    static int partition(std::vector<T>& a, int lo, int hi, Less cmp)
     {
         int n = hi - lo + 1;
-        int m = median3(a, lo, lo + n/2, hi);
+        int m = median3(a, lo, lo + n/2, hi, cmp);
         exch(a, m, lo);
 
         int i = lo;
@@ -99,13 +233,13 @@ private:
         T v = a[lo];
 
         // a[lo] is unique largest element
-        while (less(a[++i], v))
+        while (less(a[++i], v, cmp))
         {
             if (i == hi) { exch(a, lo, hi); return hi; }
         }
 
         // a[lo] is unique smallest element
-        while (less(v, a[--j]))
+        while (less(v, a[--j], cmp))
         {
             if (j == lo + 1) return lo;
         }
@@ -114,8 +248,8 @@ private:
         while (i < j)
         {
             exch(a, i, j);
-            while (less(a[++i], v)) ;
-            while (less(v, a[--j])) ;
+            while (less(a[++i], v, cmp)) ;
+            while (less(v, a[--j], cmp)) ;
         }
 
         // put partitioning item v at a[j]
@@ -125,12 +259,111 @@ private:
         return j;
     }
 
+    // partition a[lo..hi] like partition(), but compare a block of keys at a time,
+    // recording the offsets of keys on the wrong side, and swap them in pairs
+    template <typename Less>
+    static int block_partition(std::vector<T>& a, int lo, int hi, Less cmp)
+    {
+        int n = hi - lo + 1;
+        int m = median3(a, lo, lo + n/2, hi, cmp);
+        exch(a, m, lo);
+        T v = a[lo];
+
+        // a[lo+1 .. first-1] <= v <= a[last .. hi]; a[first .. last-1] is still to be placed
+        int first = lo + 1, last = hi + 1;
+        alignas(64) uint8_t offsets_l[BLOCK], offsets_r[BLOCK];
+        int start_l = 0, start_r = 0, num_l = 0, num_r = 0;
+        while (last - first > 2 * BLOCK)
+        {
+            // keys >= v from first on, keys <= v from last back
+            if (num_l == 0)
+            {
+                start_l = 0;
+                for (int i = 0; i < BLOCK; i++)
+                {
+                    offsets_l[num_l] = i;
+                    num_l += !less(a[first + i], v, cmp);
+                }
+            }
+            if (num_r == 0)
+            {
+                start_r = 0;
+                for (int i = 1; i <= BLOCK; i++)
+                {
+                    offsets_r[num_r] = i;
+                    num_r += !less(v, a[last - i], cmp);
+                }
+            }
+
+            int num = std::min(num_l, num_r);
+            for (int k = 0; k < num; k++)
+                exch(a, first + offsets_l[start_l + k], last - offsets_r[start_r + k]);
+            num_l -= num; start_l += num;
+            num_r -= num; start_r += num;
+            if (num_l == 0) first += BLOCK;
+            if (num_r == 0) last -= BLOCK;
+        }
+
+        // at most 2 * BLOCK keys are left, one block of them possibly scanned already
+        int unknown = last - first - (num_l > 0 || num_r > 0 ? BLOCK : 0);
+        int size_l, size_r;
+        if      (num_r > 0) { size_l = unknown;   size_r = BLOCK; }
+        else if (num_l > 0) { size_l = BLOCK;     size_r = unknown; }
+        else                { size_l = unknown/2; size_r = unknown - size_l; }
+        if (num_l == 0)
+        {
+            start_l = 0;
+            for (int i = 0; i < size_l; i++)
+            {
+                offsets_l[num_l] = i;
+                num_l += !less(a[first + i], v, cmp);
+            }
+        }
+        if (num_r == 0)
+        {
+            start_r = 0;
+            for (int i = 1; i <= size_r; i++)
+            {
+                offsets_r[num_r] = i;
+                num_r += !less(v, a[last - i], cmp);
+            }
+        }
+
+        int num = std::min(num_l, num_r);
+        for (int k = 0; k < num; k++)
+            exch(a, first + offsets_l[start_l + k], last - offsets_r[start_r + k]);
+        num_l -= num; start_l += num;
+        num_r -= num; start_r += num;
+        if (num_l == 0) first += size_l;
+        if (num_r == 0) last -= size_r;
+
+        // a[first .. last-1] is one side's block: move its misplaced keys to the other end
+        if (num_l > 0)
+        {
+            while (num_l-- > 0)
+                exch(a, first + offsets_l[start_l + num_l], --last);
+            first = last;
+        }
+        if (num_r > 0)
+        {
+            while (num_r-- > 0)
+                exch(a, last - offsets_r[start_r + num_r], first++);
+        }
+
+        // put partitioning item v at a[first-1]
+        exch(a, lo, first - 1);
+
+        // now, a[lo .. first-2] <= a[first-1] <= a[first .. hi]
+        return first - 1;
+    }
+
     // return the index of the median element among a[i], a[j], and a[k]
-    static int median3(std::vector<T>& a, int i, int j, int k)
+    template <typename Less>
+    static int median3(std::vector<T>& a, int i, int j, int k, Less cmp)
     {
-        return (less(a[i], a[j]) ?
-               (less(a[j], a[k]) ? j : less(a[i], a[k]) ? k : i) :
-               (less(a[k], a[j]) ? j : less(a[k], a[i]) ? k : i));
+        return (less(a[i], a[j], cmp) ?
+               (less(a[j], a[k], cmp) ? j : less(a[i], a[k], cmp) ? k : i) :
+               (less(a[k], a[j], cmp) ? j : less(a[k], a[i], cmp) ? k : i));
     }
 
    /***************************************************************************
@@ -138,17 +371,25 @@ private:
     ***************************************************************************/
 
     // is v < w ?
-    static bool less(T v, T w)
+    template <typename Less>
+    static bool less(const T& v, const T& w, Less cmp)
     {
-        return v < w;
+        return cmp(v, w);
     }
 
     // exchange a[i] and a[j]
     static void exch(std::vector<T>& a, int i, int j)
     {
-        T swap = a[i];
-        a[i] = a[j];
-        a[j] = swap;
+        using std::swap;
+        swap(a[i], a[j]);
+    }
+
+    template <typename Less>
+    static bool is_sorted(std::vector<T>& a, Less cmp)
+    {
+        for (int i = 1; i < a.size(); i++)
+            if (less(a[i], a[i-1], cmp)) return false;
+        return true;
     }
 };
 
@@ -0,0 +1,312 @@
+#ifndef RADIXHEAP_H
+#define RADIXHEAP_H
+
+#include <bit>
+
+/**
+ *  The {@code RadixHeap} class represents a monotone indexed priority queue
+ *  of integer keys: the keys inserted, or decreased to, are never less than
+ *  the last minimum removed, as the tentative distances of Dijkstra's
+ *  algorithm or the times of a discrete event simulation. It supports the
+ *  <em>insert</em>, <em>delete-the-minimum</em>, <em>decrease-key</em> and
+ *  <em>delete</em> operations of {@link IndexMinPQ}, with an integer
+ *  between {@code 0} and {@code maxN - 1} associated with each key.
+ *  <p>
+ *  This implementation uses a <em>radix heap</em> (Ahuja, Mehlhorn, Orlin
+ *  and Tarjan): bucket 0 holds the keys equal to the last minimum, and
+ *  bucket <em>b</em> the keys whose highest bit that differs from the last
+ *  minimum is bit <em>b</em> - 1. An insert or a decrease is a move to a
+ *  bucket, with no compares. When bucket 0 runs out, the first bucket
+ *  that has keys is redistributed to lower buckets around its minimum; a
+ *  key only ever moves down, so each one is moved at most once per bit.
+ *  The <em>insert</em>, <em>decrease-key</em> and <em>delete</em>
+ *  operations take &Theta;(1) time, and <em>delete-the-minimum</em>
+ *  &Theta;(log <em>C</em>) amortized time, where <em>C</em> is the largest
+ *  difference between the keys on the queue, and at most the number of
+ *  bits of {@code Key}.
+ *  <p>
+ *  Finding the minimum may redistribute a bucket, so {@code min_index()}
+ *  and {@code min_key()} are not {@code const}, and a key peeked at counts
+ *  as removed: the keys inserted afterwards must be at least that key.
+ *
+ *  @param <Key> the integral type of key on this priority queue
+ */
+template <typename Key = int>
+class RadixHeap
+{
+public:
+    /**
+     * Default Constructor
+     */
+    RadixHeap() : RadixHeap(0)
+    {
+    }
+
+    /**
+     * Initializes an empty radix heap with indices between {@code 0}
+     * and {@code max_n - 1}.
+     *
+     * @param  max_n the keys on this priority queue are index from {@code 0} to {@code max_n - 1}
+     * @throws IllegalArgumentException if {@code max_n < 0}
+     */
+    RadixHeap(int max_n)
+    {
+        static_assert(std::is_integral_v<Key>, "a radix heap orders integral keys");
+        if (max_n < 0) error("illegal argument exception");
+        m_max_n = max_n;
+        m_n = 0;
+        m_keys = std::vector<Key>(m_max_n);
+        m_bucket = std::vector<int>(m_max_n, -1);
+        m_position = std::vector<int>(m_max_n);
+        m_buckets = std::vector<std::vector<int>>(BUCKETS);
+        m_last = 0;
+    }
+
+    /**
+     * Returns true if this priority queue is empty.
+     *
+     * @return {@code true} if this priority queue is empty;
+     *         {@code false} otherwise
+     */
+    bool is_empty() const
+    {
+        return m_n == 0;
+    }
+
+    /**
+     * Is {@code i} an index on this priority queue?
+     *
+     * @param  i an index
+     * @return {@code true} if {@code i} is an index on this priority queue;
+     *         {@code false} otherwise
+     * @throws IllegalArgumentException unless {@code 0 <= i < m_max_n}
+     */
+    bool contains(int i) const
+    {
+        validate_index(i);
+        return m_bucket[i] != -1;
+    }
+
+    /**
+     * Returns the number of keys on this priority queue.
+     *
+     * @return the number of keys on this priority queue
+     */
+    int size() const
+    {
+        return m_n;
+    }
+
+    /**
+     * Associate key with index i.
+     *
+     * @param  i an index
+     * @param  key the key to associate with index {@code i}
+     * @throws IllegalArgumentException unless {@code 0 <= i < m_max_n}
+     * @throws IllegalArgumentException if there already is an item
+     *         associated with index {@code i}
+     * @throws IllegalArgumentException if {@code key} is less than the last minimum
+     */
+    void insert(int i, Key key)
+    {
+        validate_index(i);
+        if (m_bucket[i] != -1) error("index is already in the priority queue");
+        validate_key(key);
+        m_keys[i] = key;
+        place(i);
+        m_n++;
+    }
+
+    /**
+     * Associates the key with index {@code i} if {@code i} is not on this
+     * priority queue, or decreases the key of {@code i} to it if it is smaller;
+     * does nothing otherwise.
+     *
+     * @param  i an index
+     * @param  key the new key of index {@code i}, if smaller
+     * @return {@code true} if the key was inserted or decreased;
+     *         {@code false} if {@code i} already had a key at most {@code key}
+     * @throws IllegalArgumentException unless {@code 0 <= i < m_max_n}
+     * @throws IllegalArgumentException if {@code key} is less than the last minimum
+     */
+    bool push_or_decrease(int i, Key key)
+    {
+        validate_index(i);
+        if (m_bucket[i] == -1)
+        {
+            insert(i, key);
+            return true;
+        }
+        if (key >= m_keys[i]) return false;
+        validate_key(key);
+        unplace(i);
+        m_keys[i] = key;
+        place(i);
+        return true;
+    }
+
+    /**
+     * Returns an index associated with a minimum key.
+     *
+     * @return an index associated with a minimum key
+     * @throws NoSuchElementException if this priority queue is empty
+     */
+    int min_index()
+    {
+        if (is_empty()) error("Priority queue underflow");
+        refill();
+        return m_buckets[0].back();
+    }
+
+    /**
+     * Returns a minimum key.
+     *
+     * @return a minimum key
+     * @throws NoSuchElementException if this priority queue is empty
+     */
+    Key min_key()
+    {
+        return m_keys[min_index()];
+    }
+
+    /**
+     * Removes a minimum key and returns its associated index.
+     *
+     * @return an index associated with a minimum key
+     * @throws NoSuchElementException if this priority queue is empty
+     */
+    int del_min()
+    {
+        int min = min_index();
+        m_buckets[0].pop_back();
+        m_bucket[min] = -1;
+        m_n--;
+        return min;
+    }
+
+    /**
+     * Returns the key associated with index {@code i}.
+     *
+     * @param  i the index of the key to return
+     * @return the key associated with index {@code i}
+     * @throws IllegalArgumentException unless {@code 0 <= i < m_max_n}
+     * @throws NoSuchElementException no key is associated with index {@code i}
+     */
+    Key key_of(int i) const
+    {
+        validate_index(i);
+        if (m_bucket[i] == -1) error("index is not in the priority queue");
+        return m_keys[i];
+    }
+
+    /**
+     * Decrease the key associated with index {@code i} to the specified value.
+     *
+     * @param  i the index of the key to decrease
+     * @param  key decrease the key associated with index {@code i} to this key
+     * @throws IllegalArgumentException unless {@code 0 <= i < m_max_n}
+     * @throws IllegalArgumentException if {@code key >= keyOf(i)}
+     * @throws IllegalArgumentException if {@code key} is less than the last minimum
+     * @throws NoSuchElementException no key is associated with index {@code i}
+     */
+    void decrease_key(int i, Key key)
+    {
+        validate_index(i);
+        if (m_bucket[i] == -1) error("index is not in the priority queue");
+        if (m_keys[i] == key)
+            error("Calling decrease_key() with a key equal to the key in the priority queue");
+        if (m_keys[i] < key)
+            error("Calling decrease_key() with a key that is strictly greater than the key in the priority queue");
+        validate_key(key);
+        unplace(i);
+        m_keys[i] = key;
+        place(i);
+    }
+
+    /**
+     * Remove the key on the priority queue associated with index {@code i}.
+     *
+     * @param  i the index of the key to remove
+     * @throws IllegalArgumentException unless {@code 0 <= i < m_max_n}
+     * @throws NoSuchElementException no key is associated with index {@code i}
+     */
+    void delete_key(int i)
+    {
+        validate_index(i);
+        if (m_bucket[i] == -1) error("index is not in the priority queue");
+        unplace(i);
+        m_n--;
+    }
+
+private:
+    // the keys as unsigned integers in the same order
+    using Bits = std::make_unsigned_t<Key>;
+    static constexpr Bits SIGN = std::is_signed_v<Key> ? Bits(1) << (std::numeric_limits<Bits>::digits - 1) : 0;
+    static constexpr int BUCKETS = std::numeric_limits<Bits>::digits + 1;
+
+    int m_max_n;                                // maximum number of elements on PQ
+    int m_n;                                    // number of elements on PQ
+    std::vector<Key> m_keys;                    // keys[i] = priority of i
+    std::vector<int> m_bucket;                  // bucket of i, or -1 if i is not on PQ
+    std::vector<int> m_position;                // position of i in its bucket
+    std::vector<std::vector<int>> m_buckets;    // indices by the highest bit their key differs from last in
+    std::vector<int> m_scratch;                 // the bucket being redistributed
+    Bits m_last;                                // the last minimum
+
+    static Bits bits(Key key)
+    {
+        return Bits(key) ^ SIGN;
+    }
+
+    // throw an IllegalArgumentException if i is an invalid index
+    void validate_index(int i) const
+    {
+        if (i < 0) error("index is negative: {}", i);
+        if (i >= m_max_n) error("index >= capacity: {}", i);
+    }
+
+    // throw an IllegalArgumentException if the key is less than the last minimum
+    void validate_key(Key key) const
+    {
+        if (bits(key) < m_last) error("key is less than the last minimum: {}", key);
+    }
+
+    void place(int i)
+    {
+        Bits x = bits(m_keys[i]) ^ m_last;
+        int b = x == 0 ? 0 : std::bit_width(x);
+        m_bucket[i] = b;
+        m_position[i] = m_buckets[b].size();
+        m_buckets[b].push_back(i);
+    }
+
+    // take i out of its bucket, filling its place with the last index of the bucket
+    void unplace(int i)
+    {
+        std::vector<int>& bucket = m_buckets[m_bucket[i]];
+        int last = bucket.back();
+        bucket[m_position[i]] = last;
+        m_position[last] = m_position[i];
+        bucket.pop_back();
+        m_bucket[i] = -1;
+    }
+
+    // if bucket 0 is empty, make the minimum of the first bucket with keys the last
+    // minimum, and move the keys of that bucket down to the buckets around it
+    void refill()
+    {
+        if (!m_buckets[0].empty()) return;
+        int b = 1;
+        while (m_buckets[b].empty()) b++;
+
+        std::swap(m_scratch, m_buckets[b]);
+        m_last = std::numeric_limits<Bits>::max();
+        for (int i : m_scratch)
+            m_last = std::min(m_last, bits(m_keys[i]));
+        for (int i : m_scratch)
+            place(i);
+        m_scratch.clear();
+    }
+};
+
+#endif
@@ -0,0 +1,281 @@
+#ifndef SAMPLESORT_H
+#define SAMPLESORT_H
+
+#include "Parallel.h"
+#include "ParallelQuick.h"
+#include "Quick3way.h"
+#include "QuickX.h"
+#include "StdRandom.h"
+
+/**
+ *  The {@code SampleSort} class provides static methods for sorting an
+ *  array using <em>super scalar sample sort</em> (Sanders and Winkel), a
+ *  distribution sort for arrays too large for a partition or a merge at a
+ *  time to keep up with memory.
+ *  <p>
+ *  Up to 255 splitters are chosen from a random sample of the keys and laid
+ *  out as an implicit binary search tree. Each key is classified by
+ *  descending the tree with a compare per level and no branches, several
+ *  keys at a time, and its bucket number is written to an oracle array; a
+ *  second pass moves every key to its bucket in an auxiliary array. Those two
+ *  passes are the only ones over the whole array: each bucket is small enough
+ *  to be sorted while it is in cache, or is sample sorted in turn, the two
+ *  arrays trading places. When the sample holds repeated splitters, keys equal
+ *  to a splitter get buckets of their own, which need no further sorting.
+ *  <p>
+ *  {@code parallel_sort} classifies and moves blocks of the array
+ *  concurrently and sorts the buckets concurrently, on the shared
+ *  {@link ThreadPool}. Buckets of fewer than {@code SORT_GRAIN} keys are
+ *  sorted with {@link QuickX}, the samples with {@link Quick3way}. The
+ *  top-level sample is drawn with {@link StdRandom}; the samples of the
+ *  buckets, drawn on the pool, with {@code ParallelQuick::uniform_int()}.
+ *  <p>
+ *  This sorting algorithm is not stable. It uses &Theta;(<em>n</em>) extra
+ *  memory: an auxiliary array and a 2-byte oracle per key.
+ */
+template <typename T, typename Compare = std::less<T>>
+class SampleSort
+{
+public:
+    static const int LOG_BUCKETS = 8;       // at most 2^LOG_BUCKETS buckets per level
+    static const int OVERSAMPLING = 8;      // sampled keys per bucket
+    static const int SORT_GRAIN = 1 << 14;  // sort buckets smaller than this with a quicksort
+    static const int BLOCK_SIZE = 1 << 16;  // keys classified per task
+
+    /**
+     * Rearranges the array in ascending order, using the natural order.
+     * @param a the array to be sorted
+     */
+    static void sort(std::vector<T>& a)
+    {
+        sort(a, Compare());
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator.
+     * @param a the array to be sorted
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void sort(std::vector<T>& a, Less cmp)
+    {
+        sort(a, cmp, nullptr);
+    }
+
+    /**
+     * Rearranges the array in ascending order, using the natural order,
+     * classifying and sorting in parallel.
+     * @param a the array to be sorted
+     */
+    static void parallel_sort(std::vector<T>& a)
+    {
+        parallel_sort(a, Compare());
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator,
+     * classifying and sorting in parallel.
+     * @param a the array to be sorted
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void parallel_sort(std::vector<T>& a, Less cmp)
+    {
+        TaskGroup group;
+        sort(a, cmp, &group);
+    }
+
+private:
+    static const int UNROLL = 8;            // keys descending the tree together
+    static const int MAX_DEPTH = 8;         // levels of sample sort before a bucket is quicksorted anyway
+
+    // the splitters of one level, and how to find the bucket of a key
+    struct Classifier
+    {
+        int log_k;                  // levels of the tree
+        std::vector<T> tree;        // splitters at 1 .. k-1, children of j at 2j and 2j+1
+        std::vector<T> splitters;   // the same k-1 splitters in order
+        bool equality;              // do keys equal to a splitter get a bucket of their own?
+
+        // buckets: 2b for the keys with b splitters at most them, 2b-1 for those equal to splitter b-1
+        int buckets() const
+        {
+            return 2 << log_k;
+        }
+    };
+
+    template <typename Less>
+    static void sort(std::vector<T>& a, Less cmp, TaskGroup* group)
+    {
+        int n = a.size();
+        if (n < SORT_GRAIN)
+        {
+            base_sort(a, 0, n, cmp);
+            return;
+        }
+
+        std::vector<T> aux = std::vector<T>(n);
+        std::vector<uint16_t> oracle = std::vector<uint16_t>(n);
+        sort(a, aux, oracle, 0, n, false, MAX_DEPTH, true, cmp, group);
+        if (group != nullptr) group->wait();
+        assert(std::is_sorted(a.begin(), a.end(), cmp));
+    }
+
+    // sort the keys in a[lo .. hi) with aux[lo .. hi) as scratch space, leaving them
+    // in aux if to_aux and in a otherwise; top-level samples come from StdRandom
+    template <typename Less>
+    static void sort(std::vector<T>& a, std::vector<T>& aux, std::vector<uint16_t>& oracle,
+        int lo, int hi, bool to_aux, int depth, bool top, Less cmp, TaskGroup* group)
+    {
+        int n = hi - lo;
+        if (n < SORT_GRAIN || depth == 0)
+        {
+            base_sort(a, lo, hi, cmp);
+            if (to_aux) std::move(a.begin() + lo, a.begin() + hi, aux.begin() + lo);
+            return;
+        }
+
+        Classifier c = classifier(a, lo, hi, top, cmp);
+        int buckets = c.buckets();
+        int grain = group == nullptr ? n : Parallel::task_grain(n, BLOCK_SIZE);
+        int blocks = Parallel::blocks(n, grain);
+
+        // first pass: the bucket of every key, and the size of every bucket in every block
+        std::vector<int> counts = std::vector<int>(blocks * buckets);
+        Parallel::for_each_block(lo, hi, grain, [&](int b, int first, int last)
+        {
+            classify(a, oracle, first, last, c, counts.data() + b * buckets, cmp);
+        });
+
+        // where every block starts in every bucket, and where every bucket starts
+        std::vector<int> bucket_start = std::vector<int>(buckets + 1);
+        int sum = lo;
+        for (int k = 0; k < buckets; k++)
+        {
+            bucket_start[k] = sum;
+            for (int b = 0; b < blocks; b++)
+            {
+                int count = counts[b * buckets + k];
+                counts[b * buckets + k] = sum;
+                sum += count;
+            }
+        }
+        bucket_start[buckets] = hi;
+
+        // second pass: move every key to its bucket in aux
+        Parallel::for_each_block(lo, hi, grain, [&](int b, int first, int last)
+        {
+            int* next = counts.data() + b * buckets;
+            for (int i = first; i < last; i++)
+                aux[next[oracle[i]]++] = std::move(a[i]);
+        });
+
+        // the buckets, now in aux, end up where a[lo .. hi) should; buckets of equal keys are sorted already
+        for (int k = 0; k < buckets; k++)
+        {
+            int first = bucket_start[k], last = bucket_start[k + 1];
+            if (last - first == 0) continue;
+            if (k % 2 == 1 || last - first < 2)
+            {
+                if (!to_aux) std::move(aux.begin() + first, aux.begin() + last, a.begin() + first);
+                continue;
+            }
+
+            auto task = [&a, &aux, &oracle, first, last, to_aux, depth, cmp, group]
+            {
+                sort(aux, a, oracle, first, last, !to_aux, depth - 1, false, cmp, group);
+            };
+            if (group != nullptr) group->run(task);
+            else                  task();
+        }
+    }
+
+    // splitters from a sample of a[lo .. hi)
+    template <typename Less>
+    static Classifier classifier(std::vector<T>& a, int lo, int hi, bool top, Less cmp)
+    {
+        Classifier c;
+        int n = hi - lo;
+        c.log_k = 1;
+        while (c.log_k < LOG_BUCKETS && (n >> c.log_k) >= SORT_GRAIN) c.log_k++;
+        int k = 1 << c.log_k;
+
+        int size = OVERSAMPLING * k;
+        std::vector<T> sample = std::vector<T>();
+        sample.reserve(size);
+        for (int i = 0; i < size; i++)
+            sample.push_back(a[top ? lo + StdRandom::uniform_int(n) : ParallelQuick::uniform_int(lo, hi - 1)]);
+        Quick3way<T>::sort(sample, 0, size - 1, cmp);
+
+        // every OVERSAMPLING-th key, each repeated splitter dropped and replaced at the end by the largest
+        for (int i = 1; i < k; i++)
+        {
+            const T& s = sample[i * OVERSAMPLING - 1];
+            if (c.splitters.empty() || cmp(c.splitters.back(), s)) c.splitters.push_back(s);
+        }
+        c.equality = (int) c.splitters.size() < k - 1;
+        while ((int) c.splitters.size() < k - 1)
+            c.splitters.push_back(c.splitters.back());
+
+        c.tree = std::vector<T>(k);
+        int next = 0;
+        build_tree(c, 1, next);
+        return c;
+    }
+
+    // lay the splitters out in order over the subtree rooted at j
+    static void build_tree(Classifier& c, int j, int& next)
+    {
+        if (j >= (int) c.tree.size()) return;
+        build_tree(c, 2 * j, next);
+        c.tree[j] = c.splitters[next++];
+        build_tree(c, 2 * j + 1, next);
+    }
+
+    // write the bucket of each key of a[first .. last) to the oracle, and count the keys of each bucket
+    template <typename Less>
+    static void classify(const std::vector<T>& a, std::vector<uint16_t>& oracle, int first, int last,
+        const Classifier& c, int* count, Less cmp)
+    {
+        int k = 1 << c.log_k;
+        const T* tree = c.tree.data();
+
+        // UNROLL independent descents at a time keep several compares in flight
+        int i = first;
+        for (; i + UNROLL <= last; i += UNROLL)
+        {
+            int j[UNROLL];
+            for (int u = 0; u < UNROLL; u++)
+                j[u] = 1;
+            for (int level = 0; level < c.log_k; level++)
+                for (int u = 0; u < UNROLL; u++)
+                    j[u] = 2 * j[u] + !cmp(a[i + u], tree[j[u]]);
+            for (int u = 0; u < UNROLL; u++)
+                count[oracle[i + u] = bucket(a[i + u], j[u] - k, c, cmp)]++;
+        }
+        for (; i < last; i++)
+        {
+            int j = 1;
+            for (int level = 0; level < c.log_k; level++)
+                j = 2 * j + !cmp(a[i], tree[j]);
+            count[oracle[i] = bucket(a[i], j - k, c, cmp)]++;
+        }
+    }
+
+    // the bucket of x, given the number b of splitters at most x
+    template <typename Less>
+    static int bucket(const T& x, int b, const Classifier& c, Less cmp)
+    {
+        if (c.equality && b > 0 && !cmp(c.splitters[b - 1], x)) return 2 * b - 1;
+        return 2 * b;
+    }
+
+    // quicksort a[lo .. hi)
+    template <typename Less>
+    static void base_sort(std::vector<T>& a, int lo, int hi, Less cmp)
+    {
+        QuickX<T>::sort(a, lo, hi - 1, cmp);
+    }
+};
+
+#endif
@@ -43,7 +43,7 @@
  *  @author Robert Sedgewick
  *  @author Kevin Wayne
  */
-template <typename T>
+template <typename T, typename Compare = std::less<T>>
 class Selection
 {
 public:
@@ -52,6 +52,17 @@ public:
      * @param a the array to be sorted
      */
     static void sort(std::vector<T>& a)
+    {
+        sort(a, Compare());
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator.
+     * @param a the array
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void sort(std::vector<T>& a, Less cmp)
     {
         int n = a.size();
         for (int i = 0; i < n; i++)
@@ -59,12 +70,12 @@ public:
             int min = i;
             for (int j = i+1; j < n; j++)
             {
-                if (less(a[j], a[min])) min = j;
+                if (less(a[j], a[min], cmp)) min = j;
             }
             exch(a, i, min);
-            assert(is_sorted(a, 0, i));
+            assert(is_sorted(a, 0, i, cmp));
         }
-        assert(is_sorted(a));
+        assert(is_sorted(a, cmp));
     }
 
     /**
@@ -74,18 +85,7 @@ public:
      */
     static void sort(std::vector<T>& a, cmp_func)
     {
-        int n = a.size();
-        for (int i = 0; i < n; i++)
-        {
-            int min = i;
-            for (int j = i+1; j < n; j++)
-            {
-                if (less(cmp, a[j], a[min])) min = j;
-            }
-            exch(a, i, min);
-            assert(is_sorted(a, cmp, 0, i));
-        }
-        assert(is_sorted(a, cmp));
+        sort<bool(*)(T, T)>(a, cmp);
     }
 
     // print array to standard output
@@ -104,24 +104,17 @@ private:
     ***************************************************************************/
 
     // is v < w ?
-    static bool less(T v, T w)
-    {
-        return v < w; 
-    }
-
-    // is v < w ?
-    static bool less(cmp_func, T v, T w)
+    template <typename Less>
+    static bool less(const T& v, const T& w, Less cmp)
     {
-        return (*cmp)(v, w); 
+        return cmp(v, w); 
     }
 
-
     // exchange a[i] and a[j]
     static void exch(std::vector<T>& a, int i, int j)
     {
-        T swap = a[i];
-        a[i] = a[j];
-        a[j] = swap;
+        using std::swap;
+        swap(a[i], a[j]);
     }
 
 
@@ -130,30 +123,18 @@ private:
     ***************************************************************************/
 
     // is the array a[] sorted?
-    static bool is_sorted(std::vector<T>& a)
-    {
-        return is_sorted(a, 0, a.size() - 1);
-    }
-
-    // is the array sorted from a[lo] to a[hi]
-    static bool is_sorted(std::vector<T>& a, int lo, int hi)
-    {
-        for (int i = lo + 1; i <= hi; i++)
-            if (less(a[i], a[i-1])) return false;
-        return true;
-    }
-
-    // is the array a[] sorted?
-    static bool is_sorted(std::vector<T>& a, cmp_func)
+    template <typename Less>
+    static bool is_sorted(std::vector<T>& a, Less cmp)
     {
-        return is_sorted(a, cmp, 0, a.size() - 1);
+        return is_sorted(a, 0, a.size() - 1, cmp);
     }
 
     // is the array sorted from a[lo] to a[hi]
-    static bool is_sorted(std::vector<T>& a, cmp_func, int lo, int hi)
+    template <typename Less>
+    static bool is_sorted(std::vector<T>& a, int lo, int hi, Less cmp)
     {
         for (int i = lo + 1; i <= hi; i++)
-            if (less(cmp, a[i], a[i-1])) return false;
+            if (less(a[i], a[i-1], cmp)) return false;
         return true;
     }
 };
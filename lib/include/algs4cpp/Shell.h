@@ -45,7 +45,7 @@
  *  @author Robert Sedgewick
  *  @author Kevin Wayne
  */
-template <typename T>
+template <typename T, typename Compare = std::less<T>>
 class Shell
 {
 public:
@@ -54,6 +54,17 @@ public:
      * @param a the array to be sorted
      */
     static void sort(std::vector<T>& a)
+    {
+        sort(a, Compare());
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator.
+     * @param a the array to be sorted
+     * @param cmp the comparator specifying the order (a functor, lambda or function)
+     */
+    template <typename Less>
+    static void sort(std::vector<T>& a, Less cmp)
     {
         int n = a.size();
 
@@ -66,15 +77,25 @@ public:
             // h-sort the array
             for (int i = h; i < n; i++)
             {
-                for (int j = i; j >= h && less(a[j], a[j-h]); j -= h)
+                for (int j = i; j >= h && less(a[j], a[j-h], cmp); j -= h)
                 {
                     exch(a, j, j-h);
                 }
             }
-            assert(is_h_sorted(a, h));
+            assert(is_h_sorted(a, h, cmp));
             h /= 3;
         }
-        assert(is_sorted(a));
+        assert(is_sorted(a, cmp));
+    }
+
+    /**
+     * Rearranges the array in ascending order, using a comparator.
+     * @param a the array to be sorted
+     * @param comparator the comparator specifying the order
+     */
+    static void sort(std::vector<T>& a, cmp_func)
+    {
+        sort<bool(*)(T, T)>(a, cmp);
     }
     
     // print array to standard output
@@ -93,35 +114,37 @@ private:
     ***************************************************************************/
 
     // is v < w ?
-    static bool less(T v, T w)
+    template <typename Less>
+    static bool less(const T& v, const T& w, Less cmp)
     {
-        return v < w; 
+        return cmp(v, w); 
     }
 
     // exchange a[i] and a[j]
     static void exch(std::vector<T>& a, int i, int j)
     {
-        T swap = a[i];
-        a[i] = a[j];
-        a[j] = swap;
+        using std::swap;
+        swap(a[i], a[j]);
     }
 
 
    /***************************************************************************
     *  Check if array is sorted - useful for debugging.
     ***************************************************************************/
-    static bool is_sorted(std::vector<T>& a)
+    template <typename Less>
+    static bool is_sorted(std::vector<T>& a, Less cmp)
     {
         for (int i = 1; i < a.size(); i++)
-            if (less(a[i], a[i-1])) return false;
+            if (less(a[i], a[i-1], cmp)) return false;
         return true;
     }
 
     // is the array h-sorted?
-    static bool is_h_sorted(std::vector<T>& a, int h)
+    template <typename Less>
+    static bool is_h_sorted(std::vector<T>& a, int h, Less cmp)
     {
         for (int i = h; i < a.size(); i++)
-            if (less(a[i], a[i-h])) return false;
+            if (less(a[i], a[i-h], cmp)) return false;
         return true;
     }
 };
@@ -0,0 +1,78 @@
+#ifndef SORTCUTOFFS_H
+#define SORTCUTOFFS_H
+
+// written by the tune-cutoffs target of the build, if it has been run
+#if __has_include("SortCutoffsTuned.h")
+#include "SortCutoffsTuned.h"
+#endif
+
+// {merge, insertion, median of 3} for each category, the textbook's unless tuned
+#ifndef ALGS4CPP_CUTOFFS_4_BYTE
+#define ALGS4CPP_CUTOFFS_4_BYTE TEXTBOOK
+#endif
+#ifndef ALGS4CPP_CUTOFFS_8_BYTE
+#define ALGS4CPP_CUTOFFS_8_BYTE TEXTBOOK
+#endif
+#ifndef ALGS4CPP_CUTOFFS_STRING
+#define ALGS4CPP_CUTOFFS_STRING TEXTBOOK
+#endif
+
+/**
+ *  The {@code SortCutoffs} namespace holds the subarray sizes at which the
+ *  sorts change strategy, per category of key type: keys of at most 4 bytes,
+ *  other keys of at most 8 bytes that are copied bit by bit, and strings
+ *  (which stand for every other key, whose compares and moves cost more).
+ *  <p>
+ *  {@link MergeX} insertion sorts subarrays of at most {@code merge} + 1 keys,
+ *  {@link QuickX} and {@link QuickBentleyMcIlroy} those of at most
+ *  {@code insertion} keys, and {@link QuickBentleyMcIlroy} partitions
+ *  subarrays of at most {@code median_of_3} keys on a median of 3 rather
+ *  than on Tukey's ninther.
+ *  <p>
+ *  The cutoffs default to the textbook's. Building the {@code tune-cutoffs}
+ *  target times the sorts on the build machine over a range of cutoffs, and
+ *  writes the fastest of each category to {@code SortCutoffsTuned.h} in the
+ *  build tree, which the sorts compiled afterwards pick up. The macros
+ *  {@code ALGS4CPP_CUTOFFS_4_BYTE}, {@code ALGS4CPP_CUTOFFS_8_BYTE} and
+ *  {@code ALGS4CPP_CUTOFFS_STRING} can also be defined on the command line.
+ *  <p>
+ *  Keys that go to a {@link SortingNetwork} use its cutoff instead of
+ *  {@code merge} and {@code insertion}. The {@code tune-cutoffs} target
+ *  therefore leaves those two at the textbook's for a category whose
+ *  timing key, {@code int} for 4-byte keys and {@code double} for 8-byte
+ *  keys, goes to the network: they are read only by the other keys of the
+ *  category, such as unsigned integers and small structs, which it does not
+ *  time.
+ */
+namespace SortCutoffs
+{
+    struct Cutoffs
+    {
+        int merge;          // MergeX sorts subarrays of at most merge + 1 keys by insertion
+        int insertion;      // the quicksorts sort subarrays of at most insertion keys by insertion
+        int median_of_3;    // QuickBentleyMcIlroy partitions subarrays of at most median_of_3 keys on a median of 3
+    };
+
+    constexpr Cutoffs TEXTBOOK = { 7, 8, 40 };
+
+    constexpr Cutoffs FOUR_BYTE = ALGS4CPP_CUTOFFS_4_BYTE;
+    constexpr Cutoffs EIGHT_BYTE = ALGS4CPP_CUTOFFS_8_BYTE;
+    constexpr Cutoffs STRING = ALGS4CPP_CUTOFFS_STRING;
+
+    /**
+     * The cutoffs for keys of type {@code T}, by the category of the type.
+     * Specialize it for a key type that should not go by its category.
+     */
+    template <typename T>
+    struct Of
+    {
+        static constexpr Cutoffs value = sizeof(T) <= 4 && std::is_trivially_copyable_v<T> ? FOUR_BYTE
+            : sizeof(T) <= 8 && std::is_trivially_copyable_v<T> ? EIGHT_BYTE
+            : STRING;
+    };
+
+    template <typename T>
+    constexpr Cutoffs of = Of<T>::value;
+}
+
+#endif
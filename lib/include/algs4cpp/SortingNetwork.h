@@ -0,0 +1,329 @@
+#ifndef SORTINGNETWORK_H
+#define SORTINGNETWORK_H
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+/**
+ *  The {@code SortingNetwork} namespace provides the base case used by the
+ *  divide-and-conquer sorts for small subarrays of primitive keys.
+ *  <p>
+ *  Up to {@code MAX_SIZE} keys are copied into a buffer padded with the
+ *  largest value of the type to a power of two, sorted with a bitonic
+ *  sorting network and copied back. The network performs the same
+ *  compare-exchanges whatever the input, so it has no data-dependent
+ *  branches to mispredict, unlike insertion sort.
+ *  <p>
+ *  On x86-64, {@code int}, {@code long long}, {@code float} and
+ *  {@code double} keys are compare-exchanged a register at a time, and the
+ *  sorts send their small subarrays here: with the SSE2 every x86-64
+ *  processor has (4 32-bit or 2 64-bit keys per register), or with AVX2
+ *  (8 32-bit or 4 64-bit keys per register) when the translation unit is
+ *  compiled for it. Configure with {@code ALGS4CPP_NATIVE_ARCH} to compile
+ *  for the instruction set of the build machine. Every other arithmetic type,
+ *  and every type on other targets, runs the same network one pair of keys at
+ *  a time with branch-free selects; that is slower than insertion sort, so
+ *  the sorts keep insertion sort for those keys.
+ *  <p>
+ *  Keys are moved by blends, never recombined by min and max, so every key
+ *  comes out bit for bit as it went in (-0.0 and 0.0 included). Floating
+ *  point keys must not be NaN.
+ */
+namespace SortingNetwork
+{
+    const int MAX_SIZE = 64;    // largest subarray the network sorts
+    const int CUTOFF = 31;      // subarrays of at most CUTOFF + 1 keys go to the network
+
+    // the padding key, which sorts after every other key
+    template <typename T>
+    constexpr T largest()
+    {
+        if constexpr (std::numeric_limits<T>::has_infinity) return std::numeric_limits<T>::infinity();
+        else                                                 return std::numeric_limits<T>::max();
+    }
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+
+   /***************************************************************************
+    *  Registers. Keys of every type are shuffled and blended as packed floats;
+    *  only the comparison depends on the key type.
+    ***************************************************************************/
+
+#if defined(__AVX2__)
+    template <typename T>
+    struct Lanes
+    {
+        using V = __m256;
+        static const int W = 32 / sizeof(T);    // keys per register
+
+        static V load(const T* p)      { return _mm256_load_ps((const float*) p); }
+        static void store(T* p, V v)   { _mm256_store_ps((float*) p, v); }
+        static V blend(V a, V b, V m)  { return _mm256_blendv_ps(a, b, m); }
+        static V flip(V m)             { return _mm256_xor_ps(m, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+        static V flip(V m, V n)        { return _mm256_xor_ps(m, n); }
+
+        // exchange each key with the key j positions away
+        static V partner(V v, int j)
+        {
+            switch (j * (int) sizeof(T) / 4)
+            {
+                case 4:  return _mm256_permute2f128_ps(v, v, 1);
+                case 2:  return _mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2));
+                default: return _mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+            }
+        }
+
+        // all ones in the keys whose position has the given bit set
+        static V bit(int b)
+        {
+            __m256i index = _mm256_srli_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), sizeof(T) / 8);
+            __m256i mask = _mm256_set1_epi32(b);
+            return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(index, mask), mask));
+        }
+
+        // all ones in the keys where a < b
+        static V less(V a, V b)
+        {
+            if constexpr (std::is_same_v<T, float>)
+                return _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+            else if constexpr (std::is_same_v<T, double>)
+                return _mm256_castpd_ps(_mm256_cmp_pd(_mm256_castps_pd(a), _mm256_castps_pd(b), _CMP_LT_OQ));
+            else if constexpr (sizeof(T) == 4)
+                return _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_castps_si256(b), _mm256_castps_si256(a)));
+            else
+                return _mm256_castsi256_ps(_mm256_cmpgt_epi64(_mm256_castps_si256(b), _mm256_castps_si256(a)));
+        }
+    };
+
+    template <typename T>
+    concept Vectorized = std::is_same_v<T, float> || std::is_same_v<T, double>
+        || (std::is_integral_v<T> && std::is_signed_v<T> && (sizeof(T) == 4 || sizeof(T) == 8));
+#else
+    template <typename T>
+    struct Lanes
+    {
+        using V = __m128;
+        static const int W = 16 / sizeof(T);    // keys per register
+
+        static V load(const T* p)      { return _mm_load_ps((const float*) p); }
+        static void store(T* p, V v)   { _mm_store_ps((float*) p, v); }
+        static V flip(V m, V n)        { return _mm_xor_ps(m, n); }
+
+        // the keys of b where m is all ones, of a where it is all zeros
+        static V blend(V a, V b, V m)
+        {
+#if defined(__SSE4_1__)
+            return _mm_blendv_ps(a, b, m);
+#else
+            return _mm_or_ps(_mm_and_ps(m, b), _mm_andnot_ps(m, a));
+#endif
+        }
+        static V flip(V m)             { return _mm_xor_ps(m, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+
+        // exchange each key with the key j positions away
+        static V partner(V v, int j)
+        {
+            switch (j * (int) sizeof(T) / 4)
+            {
+                case 2:  return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2));
+                default: return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+            }
+        }
+
+        // all ones in the keys whose position has the given bit set
+        static V bit(int b)
+        {
+            __m128i index = _mm_srli_epi32(_mm_setr_epi32(0, 1, 2, 3), sizeof(T) / 8);
+            __m128i mask = _mm_set1_epi32(b);
+            return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(index, mask), mask));
+        }
+
+        // all ones in the keys where a < b
+        static V less(V a, V b)
+        {
+            if constexpr (std::is_same_v<T, float>)
+                return _mm_cmplt_ps(a, b);
+            else if constexpr (std::is_same_v<T, double>)
+                return _mm_castpd_ps(_mm_cmplt_pd(_mm_castps_pd(a), _mm_castps_pd(b)));
+            else if constexpr (sizeof(T) == 4)
+                return _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_castps_si128(b), _mm_castps_si128(a)));
+            else
+                return _mm_castsi128_ps(greater64(_mm_castps_si128(b), _mm_castps_si128(a)));
+        }
+
+        // all ones in the 64-bit keys where x > y
+        static __m128i greater64(__m128i x, __m128i y)
+        {
+#if defined(__SSE4_2__)
+            return _mm_cmpgt_epi64(x, y);
+#else
+            // the high halves decide, signed; if they are equal, the borrow of y - x
+            // out of the low halves, unsigned, is in the high half of the difference
+            __m128i r = _mm_and_si128(_mm_cmpeq_epi32(x, y), _mm_sub_epi64(y, x));
+            r = _mm_or_si128(r, _mm_cmpgt_epi32(x, y));
+            return _mm_shuffle_epi32(r, _MM_SHUFFLE(3, 3, 1, 1));
+#endif
+        }
+    };
+
+    template <typename T>
+    concept Vectorized = std::is_same_v<T, float> || std::is_same_v<T, double>
+        || (std::is_integral_v<T> && std::is_signed_v<T> && (sizeof(T) == 4 || sizeof(T) == 8));
+#endif
+
+    // bitonic sort of the regs * W keys held in r[]
+    template <typename T>
+    void bitonic(typename Lanes<T>::V* r, int regs)
+    {
+        using L = Lanes<T>;
+        using V = typename L::V;
+        const int W = L::W;
+        int n = regs * W;
+
+        for (int k = 2; k <= n; k *= 2)
+        {
+            for (int j = k / 2; j > 0; j /= 2)
+            {
+                // partners in different registers: every key of r[a] pairs with the key below it in r[a + d]
+                if (j >= W)
+                {
+                    int d = j / W;
+                    for (int a = 0; a < regs; a++)
+                    {
+                        if (a & d) continue;
+                        V x = r[a], y = r[a + d];
+                        V swap = ((a * W) & k) ? L::less(x, y) : L::less(y, x);
+                        r[a] = L::blend(x, y, swap);
+                        r[a + d] = L::blend(y, x, swap);
+                    }
+                }
+
+                // partners in the same register: each key keeps itself or takes its partner,
+                // the upper key of an ascending pair (or lower of a descending one) wanting the larger
+                else
+                {
+                    V upper = k < W ? L::flip(L::bit(j), L::bit(k)) : L::bit(j);
+                    for (int a = 0; a < regs; a++)
+                    {
+                        V wants_larger = ((a * W) & k) ? L::flip(upper) : upper;
+                        V v = r[a];
+                        V p = L::partner(v, j);
+                        V take = L::blend(L::less(p, v), L::less(v, p), wants_larger);
+                        r[a] = L::blend(v, p, take);
+                    }
+                }
+            }
+        }
+    }
+
+#else
+
+    template <typename T>
+    concept Vectorized = false;
+
+#endif
+
+    /**
+     * Should the sorts hand small subarrays of {@code T} ordered by {@code Less}
+     * to the network? Only for the natural order of a key type the registers hold.
+     */
+    template <typename T, typename Less>
+    constexpr bool applies = Vectorized<T>
+        && (std::is_same_v<Less, std::less<T>> || std::is_same_v<Less, std::less<>>);
+
+    /**
+     * Returns the subarray cutoff a sort should use: {@code CUTOFF} if the
+     * network applies to {@code T} and {@code Less}, {@code otherwise} if not.
+     */
+    template <typename T, typename Less>
+    constexpr int cutoff(int otherwise)
+    {
+        return applies<T, Less> ? CUTOFF : otherwise;
+    }
+
+    // bitonic sort of the n keys of a[], n a power of two
+    template <typename T>
+    void bitonic(T* a, int n)
+    {
+        for (int k = 2; k <= n; k *= 2)
+        {
+            for (int j = k / 2; j > 0; j /= 2)
+            {
+                for (int i = 0; i < n; i++)
+                {
+                    int l = i ^ j;
+                    if (l < i) continue;
+                    T x = a[i], y = a[l];
+                    bool swap = (i & k) ? x < y : y < x;
+                    a[i] = swap ? y : x;
+                    a[l] = swap ? x : y;
+                }
+            }
+        }
+    }
+
+    /**
+     * Rearranges a[0 .. n-1] in ascending order.
+     *
+     * @param a the keys to be sorted
+     * @param n the number of keys, at most {@code MAX_SIZE}
+     */
+    template <typename T>
+    void sort(T* a, int n)
+    {
+        static_assert(std::is_arithmetic_v<T>, "sorting networks sort primitive keys");
+        assert(n <= MAX_SIZE);
+        if (n < 2) return;
+
+        if constexpr (Vectorized<T>)
+        {
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+            using L = Lanes<T>;
+            int regs = 1;
+            while (regs * L::W < n) regs *= 2;
+
+            alignas(32) T buf[MAX_SIZE];
+            std::copy(a, a + n, buf);
+            std::fill(buf + n, buf + regs * L::W, largest<T>());
+
+            typename L::V r[MAX_SIZE / L::W];
+            for (int i = 0; i < regs; i++)
+                r[i] = L::load(buf + i * L::W);
+            bitonic<T>(r, regs);
+            for (int i = 0; i < regs; i++)
+                L::store(buf + i * L::W, r[i]);
+
+            std::copy(buf, buf + n, a);
+#endif
+        }
+        else
+        {
+            int size = 2;
+            while (size < n) size *= 2;
+
+            T buf[MAX_SIZE];
+            std::copy(a, a + n, buf);
+            std::fill(buf + n, buf + size, largest<T>());
+            bitonic(buf, size);
+            std::copy(buf, buf + n, a);
+        }
+    }
+
+    /**
+     * Rearranges a[lo .. hi] in ascending order.
+     *
+     * @param a the array
+     * @param lo the index of the first key to sort
+     * @param hi the index of the last key to sort; at most {@code MAX_SIZE} keys
+     */
+    template <typename T>
+    void sort(std::vector<T>& a, int lo, int hi)
+    {
+        sort(a.data() + lo, hi - lo + 1);
+    }
+}
+
+#endif
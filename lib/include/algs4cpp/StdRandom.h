@@ -282,9 +282,8 @@ namespace StdRandom
         for (int i = 0; i < n; i++)
         {
             int r = i + uniform_int(n-i);     // between i and n-1
-            T temp = a[i];
-            a[i] = a[r];
-            a[r] = temp;
+            using std::swap;
+            swap(a[i], a[r]);
         }
     }
 
@@ -306,9 +305,8 @@ namespace StdRandom
         for (int i = lo; i < hi; i++)
         {
             int r = i + uniform_int(hi-i);     // between i and hi-1
-            T temp = a[i];
-            a[i] = a[r];
-            a[r] = temp;
+            using std::swap;
+            swap(a[i], a[r]);
         }
     }
 
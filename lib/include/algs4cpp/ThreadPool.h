@@ -0,0 +1,148 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+
+/**
+ *  The {@code ThreadPool} class represents a fixed set of worker threads
+ *  that execute tasks submitted by the parallel algorithms in this library.
+ *  <p>
+ *  Each worker owns a double-ended task queue. A worker pushes and pops
+ *  its own tasks at the back (newest first, so recursive algorithms stay
+ *  depth-first and cache friendly) and steals from the front of the other
+ *  queues (oldest first, which are the largest subproblems) when its own
+ *  queue is empty. Tasks submitted from outside the pool go to a shared
+ *  injection queue that every worker steals from.
+ *  <p>
+ *  Threads that wait on a {@link TaskGroup} help execute queued tasks
+ *  instead of blocking, so fork-join recursion may nest to any depth
+ *  without deadlocking the pool.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * Initializes a pool with the given number of worker threads.
+     *
+     * @param n_threads the number of worker threads
+     * @throws IllegalArgumentException if {@code n_threads < 1}
+     */
+    ThreadPool(int n_threads);
+
+    /**
+     * Finishes the queued tasks and joins the worker threads.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Returns the pool shared by every parallel algorithm in the library.
+     * It has one worker per hardware thread, less the calling thread.
+     *
+     * @return the shared thread pool
+     */
+    static ThreadPool& shared();
+
+    /**
+     * Returns the number of worker threads.
+     *
+     * @return the number of worker threads
+     */
+    int size() const;
+
+    /**
+     * Queues a task for execution by one of the workers.
+     *
+     * @param task the task to execute
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * Removes one queued task and executes it on the calling thread.
+     *
+     * @return {@code true} if a task was executed; {@code false} if no task was queued
+     */
+    bool run_pending_task();
+
+private:
+    struct WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<ptr<WorkQueue>> m_queues;   // one per worker, then the injection queue
+    std::vector<std::thread> m_threads;
+    std::atomic<int> m_queued;              // tasks waiting in any queue
+    std::atomic<bool> m_done;
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_wake;
+
+    // index of the queue the calling thread pushes to and pops from
+    int home_queue() const;
+
+    // pop from the back of queue id, else steal from the front of the others
+    bool pop_task(int id, std::function<void()>& task);
+
+    void worker_loop(int id);
+};
+
+/**
+ *  The {@code TaskGroup} class tracks a set of tasks forked onto a
+ *  {@link ThreadPool} so they can be joined with {@code wait()}.
+ *  While waiting, the calling thread executes queued tasks itself.
+ *  <p>
+ *  A task that throws still counts as finished, and {@code wait()}
+ *  rethrows the first exception thrown by a task of the group on the
+ *  thread that waits, so it never escapes a worker.
+ */
+class TaskGroup
+{
+public:
+    /**
+     * Initializes an empty task group on the given pool.
+     *
+     * @param pool the pool to run the tasks on
+     */
+    TaskGroup(ThreadPool& pool = ThreadPool::shared());
+
+    /**
+     * Waits for every task in the group, dropping any exception a task
+     * threw that {@code wait()} has not rethrown.
+     */
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    /**
+     * Forks a task onto the pool.
+     *
+     * @param task the task to execute
+     */
+    void run(std::function<void()> task);
+
+    /**
+     * Returns when every task forked by this group has finished.
+     *
+     * @throws the first exception thrown by a task of the group since the last {@code wait()}
+     */
+    void wait();
+
+private:
+    ThreadPool& m_pool;
+    std::atomic<int> m_running;
+    std::mutex m_error_mutex;
+    std::exception_ptr m_error;     // first exception thrown by a task, until wait() rethrows it
+
+    // help run queued tasks until every task of the group has finished
+    void join();
+};
+
+#endif
@@ -0,0 +1,181 @@
+#include "ThreadPool.h"
+
+// the pool and queue index of the current thread, if it is a worker
+static thread_local ThreadPool* current_pool = nullptr;
+static thread_local int current_worker = -1;
+
+ThreadPool::ThreadPool(int n_threads)
+{
+    if (n_threads < 1) error("number of threads must be at least 1: {}", n_threads);
+
+    m_queued = 0;
+    m_done = false;
+    for (int i = 0; i <= n_threads; i++)
+        m_queues.push_back(alloc<WorkQueue>());
+
+    for (int i = 0; i < n_threads; i++)
+        m_threads.emplace_back(&ThreadPool::worker_loop, this, i);
+}
+
+ThreadPool::~ThreadPool()
+{
+    // let the workers drain every queue before they exit
+    while (run_pending_task())
+        continue;
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        m_done = true;
+    }
+    m_wake.notify_all();
+
+    for (std::thread& thread : m_threads)
+        thread.join();
+}
+
+ThreadPool& ThreadPool::shared()
+{
+    static ThreadPool pool(std::max(1, (int) std::thread::hardware_concurrency() - 1));
+    return pool;
+}
+
+int ThreadPool::size() const
+{
+    return m_threads.size();
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    // count first so m_queued never undercounts the queued tasks
+    m_queued++;
+    WorkQueue& queue = *m_queues[home_queue()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    // taking the sleep mutex orders this wakeup after a worker's last check
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+    }
+    m_wake.notify_one();
+}
+
+bool ThreadPool::run_pending_task()
+{
+    std::function<void()> task;
+    if (!pop_task(home_queue(), task)) return false;
+    task();
+    return true;
+}
+
+int ThreadPool::home_queue() const
+{
+    if (current_pool == this) return current_worker;
+    return m_threads.size();
+}
+
+bool ThreadPool::pop_task(int id, std::function<void()>& task)
+{
+    if (m_queued == 0) return false;
+
+    int n = m_queues.size();
+
+    // newest task of our own queue
+    {
+        WorkQueue& own = *m_queues[id];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty())
+        {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            m_queued--;
+            return true;
+        }
+    }
+
+    // oldest task of some other queue
+    for (int k = 1; k < n; k++)
+    {
+        WorkQueue& victim = *m_queues[(id + k) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            m_queued--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::worker_loop(int id)
+{
+    current_pool = this;
+    current_worker = id;
+
+    while (true)
+    {
+        std::function<void()> task;
+        if (pop_task(id, task))
+        {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        m_wake.wait(lock, [this] { return m_done || m_queued > 0; });
+        if (m_done && m_queued == 0) return;
+    }
+}
+
+TaskGroup::TaskGroup(ThreadPool& pool) : m_pool(pool)
+{
+    m_running = 0;
+}
+
+TaskGroup::~TaskGroup()
+{
+    join();
+}
+
+void TaskGroup::run(std::function<void()> task)
+{
+    m_running++;
+    m_pool.submit([this, task = std::move(task)]
+    {
+        // keep the first exception for wait(); the task counts as finished either way
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m_error_mutex);
+            if (!m_error) m_error = std::current_exception();
+        }
+        m_running--;
+    });
+}
+
+void TaskGroup::wait()
+{
+    join();
+
+    std::exception_ptr error = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_error_mutex);
+        std::swap(error, m_error);
+    }
+    if (error) std::rethrow_exception(error);
+}
+
+void TaskGroup::join()
+{
+    while (m_running > 0)
+    {
+        if (!m_pool.run_pending_task())
+            std::this_thread::yield();
+    }
+}
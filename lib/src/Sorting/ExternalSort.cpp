@@ -0,0 +1,441 @@
+#include "ExternalSort.h"
+#include "IndexMinPQ.h"
+#include "LSD.h"
+#include "Merge.h"
+
+#include <charconv>
+#include <stdexcept>
+
+namespace
+{
+    // report a failure of the sort by throwing, not by error(), which exits: unwinding removes the runs
+    template <typename E = std::runtime_error, typename... Args>
+    [[noreturn]] void fail(const std::format_string<Args...> fmt, Args&&... args)
+    {
+        throw E(std::vformat(fmt.get(), std::make_format_args(args...)));
+    }
+
+    // a new directory of our own under parent, removed with everything in it when it goes out of scope
+    class TempDir
+    {
+    public:
+        explicit TempDir(const std::filesystem::path& parent)
+        {
+            std::random_device seed;
+            do m_path = parent / ("external-sort-" + std::to_string(seed()));
+            while (!std::filesystem::create_directory(m_path));
+        }
+
+        TempDir(const TempDir&) = delete;
+        TempDir& operator=(const TempDir&) = delete;
+
+        ~TempDir()
+        {
+            std::error_code ignored;
+            std::filesystem::remove_all(m_path, ignored);
+        }
+
+        const std::filesystem::path& path() const
+        {
+            return m_path;
+        }
+
+    private:
+        std::filesystem::path m_path;
+    };
+
+    // buffered output to a file
+    class Writer
+    {
+    public:
+        Writer(const std::filesystem::path& path, size_t capacity) :
+            m_path(path), m_out(path, std::ios::binary), m_capacity(capacity)
+        {
+            if (!m_out) fail("could not open {} for writing", path.string());
+            m_buf.reserve(capacity);
+        }
+
+        // a writer not closed was abandoned by a failure: drop what is left, without checking
+        ~Writer()
+        {
+            if (m_out.is_open()) m_out.close();
+        }
+
+        void write(const char* p, size_t n)
+        {
+            if (m_buf.size() + n > m_capacity) flush();
+            if (n > m_capacity) emit(p, n);
+            else                m_buf.append(p, n);
+        }
+
+        void write_line(std::string_view line)
+        {
+            write(line.data(), line.size());
+            write("\n", 1);
+        }
+
+        void write_value(int64_t x)
+        {
+            write((const char*) &x, sizeof(x));
+        }
+
+        void write_text(int64_t x)
+        {
+            char text[24];
+            char* end = std::to_chars(text, text + sizeof(text), x).ptr;
+            *end++ = '\n';
+            write(text, end - text);
+        }
+
+        void close()
+        {
+            if (!m_out.is_open()) return;
+            flush();
+            m_out.close();
+            if (!m_out) fail("could not write {}", m_path.string());
+        }
+
+    private:
+        std::filesystem::path m_path;
+        std::ofstream m_out;
+        std::string m_buf;
+        size_t m_capacity;
+
+        void flush()
+        {
+            emit(m_buf.data(), m_buf.size());
+            m_buf.clear();
+        }
+
+        void emit(const char* p, size_t n)
+        {
+            if (!m_out.write(p, n)) fail("could not write {}", m_path.string());
+        }
+    };
+
+    // buffered input from a file, refilled a block at a time
+    class Reader
+    {
+    public:
+        Reader(const std::filesystem::path& path, size_t capacity) :
+            m_path(path), m_in(path, std::ios::binary), m_buf(capacity, '\0'), m_pos(0), m_filled(0), m_eof(false)
+        {
+            if (!m_in) fail("could not open {}", path.string());
+        }
+
+        // the next line, without its newline; valid until the next call
+        bool next(std::string_view& line)
+        {
+            while (true)
+            {
+                const char* start = m_buf.data() + m_pos;
+                const char* nl = (const char*) memchr(start, '\n', m_filled - m_pos);
+                if (nl != nullptr)
+                {
+                    line = std::string_view(start, nl - start);
+                    m_pos = nl - m_buf.data() + 1;
+                    return true;
+                }
+                if (m_eof)
+                {
+                    // last line without a newline
+                    if (m_pos == m_filled) return false;
+                    line = std::string_view(start, m_filled - m_pos);
+                    m_pos = m_filled;
+                    return true;
+                }
+                refill();
+            }
+        }
+
+        // the next binary value
+        bool next(int64_t& x)
+        {
+            if (m_filled - m_pos < sizeof(x))
+            {
+                if (!m_eof) refill();
+                if (m_filled - m_pos < sizeof(x)) return false;
+            }
+            memcpy(&x, m_buf.data() + m_pos, sizeof(x));
+            m_pos += sizeof(x);
+            return true;
+        }
+
+    private:
+        std::filesystem::path m_path;
+        std::ifstream m_in;
+        std::string m_buf;
+        size_t m_pos;       // next unread byte
+        size_t m_filled;    // end of the bytes read
+        bool m_eof;
+
+        // keep the unread bytes and read more after them, growing the buffer if it is full
+        void refill()
+        {
+            memmove(m_buf.data(), m_buf.data() + m_pos, m_filled - m_pos);
+            m_filled -= m_pos;
+            m_pos = 0;
+            if (m_filled == m_buf.size()) m_buf.resize(2 * m_buf.size());
+            m_in.read(m_buf.data() + m_filled, m_buf.size() - m_filled);
+            m_filled += m_in.gcount();
+            if (m_in.eof()) m_eof = true;
+            else if (!m_in) fail("could not read {}", m_path.string());
+        }
+    };
+
+    // merge the sorted readers, passing each key in order to emit, as Multiway does
+    template <typename Key, typename Emit>
+    void merge_readers(std::vector<ptr<Reader>>& readers, Emit emit)
+    {
+        int n = readers.size();
+        IndexMinPQ<Key> pq = IndexMinPQ<Key>(n);
+        Key key;
+        for (int i = 0; i < n; i++)
+            if (readers[i]->next(key))
+                pq.insert(i, key);
+
+        // write the min, then replace it by the next key of its reader;
+        // the key is a view into that reader's buffer, so delete it first
+        while (!pq.is_empty())
+        {
+            emit(pq.min_key());
+            int i = pq.del_min();
+            if (readers[i]->next(key))
+                pq.insert(i, key);
+        }
+    }
+
+    bool is_space(char c)
+    {
+        return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+}
+
+ExternalSort::ExternalSort(long long memory, int fan_in, std::string temp_dir) :
+    m_memory(memory), m_fan_in(fan_in), m_runs(0), m_merge_passes(0), m_next_run(0)
+{
+    if (memory < 64 * 1024) error("memory budget must be at least 64 KiB");
+    if (fan_in < 2) error("fan-in must be at least 2");
+    m_temp_dir = temp_dir.empty() ? std::filesystem::temp_directory_path() : std::filesystem::path(temp_dir);
+}
+
+void ExternalSort::sort_lines(const std::string& input, const std::string& output)
+{
+    sort(input, output, Format::LINES);
+}
+
+void ExternalSort::sort_integers(const std::string& input, const std::string& output)
+{
+    sort(input, output, Format::INTEGERS);
+}
+
+int ExternalSort::runs() const
+{
+    return m_runs;
+}
+
+int ExternalSort::merge_passes() const
+{
+    return m_merge_passes;
+}
+
+void ExternalSort::sort(const std::string& input, const std::string& output, Format format)
+{
+    if (!std::filesystem::exists(input)) fail<std::invalid_argument>("could not open {}", input);
+    if (std::filesystem::exists(output) && std::filesystem::equivalent(input, output))
+        fail<std::invalid_argument>("output {} would overwrite the input", output);
+
+    // a directory of our own for the runs, removed however the sort ends
+    TempDir temp = TempDir(m_temp_dir);
+    const std::filesystem::path& dir = temp.path();
+
+    m_runs = 0;
+    m_merge_passes = 0;
+    m_next_run = 0;
+    std::vector<std::filesystem::path> runs = format == Format::LINES
+        ? make_line_runs(input, dir)
+        : make_integer_runs(input, dir);
+    m_runs = runs.size();
+    merge_runs(runs, output, dir, format);
+}
+
+std::filesystem::path ExternalSort::next_run(const std::filesystem::path& dir)
+{
+    return dir / ("run-" + std::to_string(m_next_run++));
+}
+
+std::vector<std::filesystem::path> ExternalSort::make_line_runs(const std::string& input, const std::filesystem::path& dir)
+{
+    // half the budget holds the text, the other half a view of each line and the merge aux array
+    size_t block = m_memory / 2;
+    size_t max_lines = m_memory / (4 * sizeof(std::string_view));
+
+    std::ifstream in = std::ifstream(input, std::ios::binary);
+    if (!in) fail("could not open {}", input);
+    std::string buf = std::string(block, '\0');
+    size_t filled = 0;
+    bool eof = false;
+
+    std::vector<std::filesystem::path> runs = std::vector<std::filesystem::path>();
+    std::vector<std::string_view> lines = std::vector<std::string_view>();
+    while (!eof || filled > 0)
+    {
+        if (!eof)
+        {
+            in.read(buf.data() + filled, buf.size() - filled);
+            filled += in.gcount();
+            if (in.eof()) eof = true;
+            else if (!in) fail("could not read {}", input);
+        }
+
+        // split the whole lines, and the last line at the end of the input
+        lines.clear();
+        size_t start = 0;
+        while (start < filled && lines.size() < max_lines)
+        {
+            const char* nl = (const char*) memchr(buf.data() + start, '\n', filled - start);
+            size_t end = nl != nullptr ? nl - buf.data() : filled;
+            if (nl == nullptr && !eof) break;
+            lines.emplace_back(buf.data() + start, end - start);
+            start = end + 1;
+        }
+        start = std::min(start, filled);
+
+        // nothing left, or a line longer than the buffer: grow it
+        if (lines.empty())
+        {
+            if (filled == 0) break;
+            buf.resize(2 * buf.size());
+            continue;
+        }
+
+        Merge<std::string_view>::parallel_sort(lines);
+        runs.push_back(next_run(dir));
+        Writer out = Writer(runs.back(), std::min<size_t>(block / 8, 1 << 20));
+        for (std::string_view line : lines)
+            out.write_line(line);
+        out.close();
+
+        // keep the partial line for the next run
+        memmove(buf.data(), buf.data() + start, filled - start);
+        filled -= start;
+    }
+    return runs;
+}
+
+std::vector<std::filesystem::path> ExternalSort::make_integer_runs(const std::string& input, const std::filesystem::path& dir)
+{
+    // a quarter of the budget holds the text, the rest the values and the radix sort aux array
+    size_t block = m_memory / 4;
+    size_t max_values = (m_memory - block) / (2 * sizeof(int64_t));
+
+    std::ifstream in = std::ifstream(input, std::ios::binary);
+    if (!in) fail("could not open {}", input);
+    std::string buf = std::string(block, '\0');
+    size_t filled = 0;
+    bool eof = false;
+
+    std::vector<std::filesystem::path> runs = std::vector<std::filesystem::path>();
+    std::vector<int64_t> values = std::vector<int64_t>();
+    while (!eof || filled > 0)
+    {
+        // fill the text buffer and parse it until the values are full
+        while (values.size() < max_values && (!eof || filled > 0))
+        {
+            if (!eof)
+            {
+                in.read(buf.data() + filled, buf.size() - filled);
+                filled += in.gcount();
+                if (in.eof()) eof = true;
+                else if (!in) fail("could not read {}", input);
+            }
+
+            size_t i = 0;
+            while (values.size() < max_values)
+            {
+                while (i < filled && is_space(buf[i])) i++;
+                size_t start = i;
+                while (i < filled && !is_space(buf[i])) i++;
+                if (start == i || (i == filled && !eof))
+                {
+                    i = start;
+                    break;
+                }
+
+                int64_t x;
+                std::from_chars_result result = std::from_chars(buf.data() + start, buf.data() + i, x);
+                if (result.ec != std::errc() || result.ptr != buf.data() + i)
+                    fail<std::invalid_argument>("not a 64-bit integer: {}", std::string(buf.data() + start, i - start));
+                values.push_back(x);
+            }
+
+            // no whole token in a full buffer
+            if (i == 0 && filled == buf.size() && values.size() < max_values)
+                fail<std::invalid_argument>("not a 64-bit integer: {}...", buf.substr(0, 32));
+
+            // keep the partial token for the next read
+            memmove(buf.data(), buf.data() + i, filled - i);
+            filled -= i;
+        }
+        if (values.empty()) break;
+
+        std::vector<int64_t> aux = std::vector<int64_t>(values.size());
+        LSD::parallel_sort(values, aux, [](int64_t x) { return LSD::radix_key(x); });
+        runs.push_back(next_run(dir));
+        Writer out = Writer(runs.back(), std::min<size_t>(block / 8, 1 << 20));
+        for (int64_t x : values)
+            out.write_value(x);
+        out.close();
+        values.clear();
+    }
+    return runs;
+}
+
+void ExternalSort::merge_runs(std::vector<std::filesystem::path> runs, const std::string& output,
+    const std::filesystem::path& dir, Format format)
+{
+    // merge groups of fan_in runs into longer runs until one merge is left
+    while (runs.size() > (size_t) m_fan_in)
+    {
+        std::vector<std::filesystem::path> merged = std::vector<std::filesystem::path>();
+        for (size_t lo = 0; lo < runs.size(); lo += m_fan_in)
+        {
+            size_t hi = std::min(runs.size(), lo + m_fan_in);
+            std::vector<std::filesystem::path> group = std::vector<std::filesystem::path>(runs.begin() + lo, runs.begin() + hi);
+            if (group.size() == 1)
+            {
+                merged.push_back(group[0]);
+                continue;
+            }
+            merged.push_back(next_run(dir));
+            merge(group, merged.back(), format, false);
+            for (const std::filesystem::path& run : group)
+                std::filesystem::remove(run);
+        }
+        runs = merged;
+        m_merge_passes++;
+    }
+
+    merge(runs, output, format, true);
+    m_merge_passes++;
+}
+
+void ExternalSort::merge(const std::vector<std::filesystem::path>& runs, const std::filesystem::path& output,
+    Format format, bool final)
+{
+    // one buffer per run and one for the output
+    size_t buffer = std::max<size_t>(m_memory / (runs.size() + 1), 4096);
+
+    std::vector<ptr<Reader>> readers = std::vector<ptr<Reader>>();
+    for (const std::filesystem::path& run : runs)
+        readers.push_back(alloc<Reader>(run, buffer));
+    Writer out = Writer(output, buffer);
+
+    if (format == Format::LINES)
+        merge_readers<std::string_view>(readers, [&](std::string_view line) { out.write_line(line); });
+    else if (final)
+        merge_readers<int64_t>(readers, [&](int64_t x) { out.write_text(x); });
+    else
+        merge_readers<int64_t>(readers, [&](int64_t x) { out.write_value(x); });
+    out.close();
+}
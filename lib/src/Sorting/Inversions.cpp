@@ -0,0 +1,27 @@
+#include "Inversions.h"
+
+long Inversions::kendall_tau(const std::vector<int>& a, const std::vector<int>& b)
+{
+    if (a.size() != b.size()) error("Array dimensions disagree");
+    int n = a.size();
+
+    // position of each element in a
+    std::vector<int> ainv = std::vector<int>(n, -1);
+    for (int i = 0; i < n; i++)
+    {
+        if (a[i] < 0 || a[i] >= n || ainv[a[i]] != -1) error("first argument is not a permutation");
+        ainv[a[i]] = i;
+    }
+
+    // b with each element replaced by its position in a: its inversions are the disagreements
+    std::vector<int> bnew = std::vector<int>(n);
+    std::vector<bool> seen = std::vector<bool>(n);
+    for (int i = 0; i < n; i++)
+    {
+        if (b[i] < 0 || b[i] >= n || seen[b[i]]) error("second argument is not a permutation");
+        seen[b[i]] = true;
+        bnew[i] = ainv[b[i]];
+    }
+
+    return parallel_count(bnew);
+}
@@ -0,0 +1,65 @@
+#include "LSD.h"
+
+void LSD::sort(std::vector<std::string>& a, int w)
+{
+    int n = a.size();
+    std::vector<std::string> aux = std::vector<std::string>(n);
+
+    for (int d = w-1; d >= 0; d--)
+    {
+        // sort by key-indexed counting on dth character
+
+        // compute frequency counts
+        std::vector<int> count = std::vector<int>(R + 1);
+        for (int i = 0; i < n; i++)
+            count[(uint8_t) a[i][d] + 1]++;
+
+        // compute cumulates
+        for (int r = 0; r < R; r++)
+            count[r+1] += count[r];
+
+        // move data
+        for (int i = 0; i < n; i++)
+            aux[count[(uint8_t) a[i][d]]++] = std::move(a[i]);
+
+        // copy back
+        for (int i = 0; i < n; i++)
+            a[i] = std::move(aux[i]);
+    }
+}
+
+void LSD::sort(std::vector<int>& a)
+{
+    std::vector<int> aux = std::vector<int>(a.size());
+    sort(a, aux, 0, a.size(), [](int x) { return radix_key(x); });
+}
+
+void LSD::sort(std::vector<long>& a)
+{
+    std::vector<long> aux = std::vector<long>(a.size());
+    sort(a, aux, 0, a.size(), [](long x) { return radix_key(x); });
+}
+
+void LSD::sort(std::vector<double>& a)
+{
+    std::vector<double> aux = std::vector<double>(a.size());
+    sort(a, aux, 0, a.size(), [](double x) { return radix_key(x); });
+}
+
+void LSD::parallel_sort(std::vector<int>& a)
+{
+    std::vector<int> aux = std::vector<int>(a.size());
+    parallel_sort(a, aux, [](int x) { return radix_key(x); });
+}
+
+void LSD::parallel_sort(std::vector<long>& a)
+{
+    std::vector<long> aux = std::vector<long>(a.size());
+    parallel_sort(a, aux, [](long x) { return radix_key(x); });
+}
+
+void LSD::parallel_sort(std::vector<double>& a)
+{
+    std::vector<double> aux = std::vector<double>(a.size());
+    parallel_sort(a, aux, [](double x) { return radix_key(x); });
+}
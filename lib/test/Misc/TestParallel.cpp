@@ -0,0 +1,82 @@
+#include "Parallel.h"
+#include "StdRandom.h"
+#include "StdOut.h"
+
+/**
+ * Unit tests the {@code Parallel} primitives against serial loops.
+ *
+ * @param args the command-line arguments
+ */
+int Misc_TestParallel(int argc, char** argv)
+{
+    StdRandom::set_seed(20);
+    for (int n : { 0, 1, 2, 999, 1000, 1001, 100000 })
+    {
+        std::vector<long long> a = std::vector<long long>(n);
+        for (int i = 0; i < n; i++)
+            a[i] = StdRandom::uniform_int(-1000, 1000);
+
+        // for_each and for_blocks visit every index once
+        std::vector<int> visits = std::vector<int>(n);
+        Parallel::for_each(0, n, [&visits](int i) { visits[i]++; }, 100);
+        Parallel::for_blocks(0, n, [&visits](int lo, int hi)
+        {
+            for (int i = lo; i < hi; i++)
+                visits[i]++;
+        }, 1000);
+        if (std::count(visits.begin(), visits.end(), 2) != n) return 1;
+
+        // reduce
+        long long sum = 0, max = std::numeric_limits<long long>::min();
+        for (long long x : a)
+        {
+            sum += x;
+            max = std::max(max, x);
+        }
+        if (Parallel::reduce(a, 0LL, std::plus<long long>(), 1000) != sum) return 1;
+        if (Parallel::reduce(a, std::numeric_limits<long long>::min(), [](long long x, long long y) { return std::max(x, y); }) != max) return 1;
+
+        // scans
+        std::vector<long long> inclusive = a;
+        std::vector<long long> exclusive = a;
+        Parallel::inclusive_scan(inclusive, std::plus<long long>(), 1000);
+        if (Parallel::exclusive_scan(exclusive, 0LL, std::plus<long long>(), 1000) != sum) return 1;
+        long long prefix = 0;
+        for (int i = 0; i < n; i++)
+        {
+            if (exclusive[i] != prefix) return 1;
+            prefix += a[i];
+            if (inclusive[i] != prefix) return 1;
+        }
+
+        // filter and partition keep the order of the elements
+        auto even = [](long long x) { return x % 2 == 0; };
+        std::vector<long long> expected = std::vector<long long>();
+        std::copy_if(a.begin(), a.end(), std::back_inserter(expected), even);
+        if (Parallel::filter(a, even, 1000) != expected) return 1;
+
+        std::vector<long long> partitioned = a;
+        std::vector<long long> stable = a;
+        int evens = Parallel::partition(partitioned, even, 1000);
+        std::stable_partition(stable.begin(), stable.end(), even);
+        if (evens != expected.size() || partitioned != stable) return 1;
+    }
+
+    // floating-point results depend on the grain only, not on the threads
+    std::vector<double> x = std::vector<double>(1000000);
+    for (double& v : x)
+        v = StdRandom::uniform_double();
+    double first = Parallel::reduce(x, 0.0, std::plus<double>());
+    for (int run = 0; run < 5; run++)
+        if (Parallel::reduce(x, 0.0, std::plus<double>()) != first) return 1;
+    StdOut::printf("sum of %d random doubles = %.6f\n", (int) x.size(), first);
+
+    // primitives nest inside pool tasks
+    std::vector<long long> ones = std::vector<long long>(100000, 1);
+    std::vector<long long> sums = std::vector<long long>(8);
+    Parallel::for_each(0, 8, [&ones, &sums](int i) { sums[i] = Parallel::reduce(ones, 0LL, std::plus<long long>(), 1000); }, 1);
+    for (long long s : sums)
+        if (s != (long long) ones.size()) return 1;
+
+    return 0;
+}
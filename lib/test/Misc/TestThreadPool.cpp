@@ -0,0 +1,66 @@
+#include "ThreadPool.h"
+#include "StdOut.h"
+
+// sum of 1..n computed by recursive fork-join on the pool
+static long sum(int lo, int hi)
+{
+    if (hi - lo < 1000)
+    {
+        long total = 0;
+        for (int i = lo; i <= hi; i++)
+            total += i;
+        return total;
+    }
+
+    int mid = lo + (hi - lo) / 2;
+    long left = 0;
+    TaskGroup group;
+    group.run([&] { left = sum(lo, mid); });
+    long right = sum(mid + 1, hi);
+    group.wait();
+    return left + right;
+}
+
+/**
+ * Unit tests the {@code ThreadPool} data type.
+ *
+ * @param args the command-line arguments
+ */
+int Misc_TestThreadPool(int argc, char** argv)
+{
+    ThreadPool& pool = ThreadPool::shared();
+    StdOut::printf("%d worker threads\n", pool.size());
+
+    int n = 1000000;
+    long total = sum(1, n);
+    StdOut::printf("sum of 1..%d = %ld\n", n, total);
+    if (total != (long) n * (n + 1) / 2) return 1;
+
+    // an exception thrown by a task reaches the thread that waits, after every other task has finished
+    std::atomic<int> finished = 0;
+    bool caught = false;
+    TaskGroup group;
+    for (int i = 0; i < 100; i++)
+        group.run([&finished, i]
+        {
+            if (i % 10 == 3) throw std::runtime_error("task " + std::to_string(i));
+            finished++;
+        });
+    try
+    {
+        group.wait();
+    }
+    catch (const std::runtime_error& e)
+    {
+        caught = true;
+        StdOut::printf("caught: %s\n", e.what());
+    }
+    if (!caught || finished != 90) return 1;
+
+    // the exception was taken by wait(), so the group can be reused
+    group.run([&finished] { finished++; });
+    group.wait();
+    if (finished != 91) return 1;
+
+    return 0;
+}
@@ -0,0 +1,40 @@
+#ifndef ADVERSARYTEST_H
+#define ADVERSARYTEST_H
+
+/******************************************************************************
+ *  McIlroy's adversary, shared by the tests of the introsorts: Quick,
+ *  QuickX and QuickBentleyMcIlroy.
+ ******************************************************************************/
+
+// sorts the keys 0 to n-1 by sort(keys, less) against McIlroy's adversary, which fixes each key's
+// value only when a compare needs it, so that every pivot is nearly the smallest key: the number
+// of compares made, or -1 if the keys do not come out in the order the adversary fixed
+template <typename Sort>
+long long adversary_compares(int n, Sort sort)
+{
+    std::vector<int> val = std::vector<int>(n, n);      // n marks a key not yet fixed
+    int solid = 0, candidate = 0;
+    long long compares = 0;
+    auto adversary = [&](int x, int y)
+    {
+        compares++;
+        if (val[x] == n && val[y] == n)
+        {
+            if (x == candidate) val[x] = solid++;
+            else                val[y] = solid++;
+        }
+        if      (val[x] == n) candidate = x;
+        else if (val[y] == n) candidate = y;
+        return val[x] < val[y];
+    };
+
+    std::vector<int> keys = std::vector<int>(n);
+    for (int i = 0; i < n; i++)
+        keys[i] = i;
+    sort(keys, adversary);
+    for (int i = 1; i < n; i++)
+        if (val[keys[i]] < val[keys[i-1]]) return -1;
+    return compares;
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef MONOTONEPQTEST_H
+#define MONOTONEPQTEST_H
+
+#include "IndexMinPQ.h"
+#include "StdRandom.h"
+
+/******************************************************************************
+ *  Checks shared by the tests of the monotone indexed priority queues,
+ *  RadixHeap and BucketQueue, against IndexMinPQ.
+ ******************************************************************************/
+
+// random inserts, decreases and deletes no less than the last minimum and at most range above it,
+// as Dijkstra's algorithm makes them, on the empty queue for indices 0 to n-1 whose keys start at
+// -range: does every minimum match that of an IndexMinPQ?
+template <typename Queue>
+bool matches_index_min_pq(Queue queue, int n, int range, int operations)
+{
+    IndexMinPQ<int> pq = IndexMinPQ<int>(n);
+    int last = -range;
+    queue.insert(0, last);
+    pq.insert(0, last);
+    for (int t = 0; t < operations; t++)
+    {
+        int i = StdRandom::uniform_int(n);
+        int key = last + StdRandom::uniform_int(range + 1);
+        int op = StdRandom::uniform_int(4);
+        if (op == 0 && !pq.is_empty())
+        {
+            int min = queue.min_key();
+            int j = queue.del_min();
+            if (min != pq.min_key() || !pq.contains(j) || pq.key_of(j) != min) return false;
+            pq.delete_key(j);
+            last = min;
+        }
+        else if (op == 1 && pq.contains(i))
+        {
+            queue.delete_key(i);
+            pq.delete_key(i);
+        }
+        else if (op == 2 && pq.contains(i) && key < pq.key_of(i))
+        {
+            queue.decrease_key(i, key);
+            pq.decrease_key(i, key);
+        }
+        else if (queue.push_or_decrease(i, key) != pq.push_or_decrease(i, key)) return false;
+        if (queue.size() != pq.size() || (pq.contains(i) && queue.key_of(i) != pq.key_of(i))) return false;
+    }
+
+    while (!pq.is_empty())
+    {
+        int min = queue.min_key();
+        int j = queue.del_min();
+        if (min != pq.min_key() || !pq.contains(j) || pq.key_of(j) != min) return false;
+        pq.delete_key(j);
+    }
+    return queue.is_empty();
+}
+
+// the distances from the top left corner of an n-by-n grid whose edges go right and down with
+// weights 1 to 9, by Dijkstra's algorithm on the empty queue for indices 0 to n*n - 1
+template <typename Queue>
+std::vector<int> grid_distances(Queue queue, int n)
+{
+    std::vector<int> distance = std::vector<int>(n * n, -1);
+    queue.insert(0, 0);
+    while (!queue.is_empty())
+    {
+        int d = queue.min_key();
+        int v = queue.del_min();
+        distance[v] = d;
+        int row = v / n, col = v % n;
+        for (int w : { row + 1 < n ? v + n : -1, col + 1 < n ? v + 1 : -1 })
+            if (w != -1 && distance[w] == -1) queue.push_or_decrease(w, d + 1 + (v * 7 + w) % 9);
+    }
+    return distance;
+}
+
+#endif
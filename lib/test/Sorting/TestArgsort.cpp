@@ -0,0 +1,67 @@
+#include "Argsort.h"
+#include "StdOut.h"
+#include "StdRandom.h"
+
+/**
+ * Argsorts columns of random records by several keys and checks each
+ * permutation against std::stable_sort, then gathers the columns.
+ *
+ * @param args the command-line arguments
+ */
+int Sorting_TestArgsort(int argc, char** argv)
+{
+    for (int n : { 0, 1, 100, 300000 })
+    {
+        // columns of records: few distinct scores and names, so stability matters
+        std::vector<double> scores = std::vector<double>(n);
+        std::vector<std::string> names = std::vector<std::string>(n);
+        std::vector<int> ids = std::vector<int>(n);
+        for (int i = 0; i < n; i++)
+        {
+            scores[i] = StdRandom::uniform_int(-50, 50) / 4.0;
+            names[i] = std::string(1, 'a' + StdRandom::uniform_int(26)) + std::to_string(StdRandom::uniform_int(10));
+            ids[i] = i;
+        }
+
+        auto expected = [n](auto less)
+        {
+            std::vector<uint32_t> p = std::vector<uint32_t>(n);
+            for (int i = 0; i < n; i++)
+                p[i] = i;
+            std::stable_sort(p.begin(), p.end(), less);
+            return p;
+        };
+
+        // radix path, comparator path, descending order and a key extractor
+        if (Argsort::sort(scores) != expected([&](int i, int j) { return scores[i] < scores[j]; })) return 1;
+        if (Argsort::sort(names) != expected([&](int i, int j) { return names[i] < names[j]; })) return 1;
+        if (Argsort::sort(scores, std::greater<double>()) != expected([&](int i, int j) { return scores[i] > scores[j]; })) return 1;
+        std::vector<uint32_t> by_length = Argsort::sort_by(names, [](const std::string& s) { return (int) s.size(); });
+        if (by_length != expected([&](int i, int j) { return names[i].size() < names[j].size(); })) return 1;
+        std::vector<int> by_name = Argsort::sort_by<int>(ids, [&names](int id) { return names[id]; }, std::greater<std::string>());
+        std::vector<uint32_t> by_name_expected = expected([&](int i, int j) { return names[i] > names[j]; });
+        if (!std::equal(by_name.begin(), by_name.end(), by_name_expected.begin(), by_name_expected.end())) return 1;
+        std::vector<uint32_t> by_sign = Argsort::sort_by(scores, [](double score) { return score >= 0; });
+        if (by_sign != expected([&](int i, int j) { return (scores[i] >= 0) < (scores[j] >= 0); })) return 1;
+
+        // sort the records by name, then stably by score
+        std::vector<uint32_t> index = Argsort::sort(names);
+        Argsort::apply(index, names, scores, ids);
+        Argsort::apply(Argsort::sort(scores), names, scores, ids);
+        for (int i = 1; i < n; i++)
+        {
+            if (scores[i-1] > scores[i]) return 1;
+            if (scores[i-1] == scores[i] && names[i-1] > names[i]) return 1;
+        }
+        std::vector<int> sorted_ids = ids;
+        std::sort(sorted_ids.begin(), sorted_ids.end());
+        for (int i = 0; i < n; i++)
+            if (sorted_ids[i] != i) return 1;
+        if (n == 100)
+        {
+            for (int i = 0; i < 5; i++)
+                StdOut::printf("%5.2f %s %d\n", scores[i], names[i].c_str(), ids[i]);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,26 @@
+#include "BucketQueue.h"
+#include "MonotonePQTest.h"
+#include "StdRandom.h"
+#include "StdOut.h"
+
+/**
+ * Unit tests the {@code BucketQueue} data type.
+ *
+ * @param args the command-line arguments
+ */
+int Sorting_TestBucketQueue(int argc, char** argv)
+{
+    // nodes of a grid by their distance from a corner, with edge weights 1 to 9
+    const int N = 30;
+    std::vector<int> distance = grid_distances(BucketQueue<int>(N * N, 9), N);
+    StdOut::printf("distance to the far corner: %d\n", distance[N * N - 1]);
+    if (std::count(distance.begin(), distance.end(), -1) != 0) return 1;
+    if (distance != grid_distances(IndexMinPQ<int>(N * N), N)) return 1;
+
+    StdRandom::set_seed(24);
+    for (int n : { 1, 2, 10, 300 })
+        for (int range : { 0, 1, 100, 1 << 16 })
+            if (!matches_index_min_pq(BucketQueue<int>(n, range, -range), n, range, 3000)) return 1;
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include "Counted.h"
+#include "Insertion.h"
+#include "Heap.h"
+#include "Quick.h"
+#include "MinPQ.h"
+#include "IndexMinPQ.h"
+#include "BST.h"
+#include "StdOut.h"
+#include "StdRandom.h"
+
+/**
+ * Counts the operations of sorts, priority queues and a symbol table on counted keys.
+ *
+ * @param args the command-line arguments
+ */
+int Sorting_TestCounted(int argc, char** argv)
+{
+    // insertion sort of a reversed array exchanges every pair once
+    int n = 100;
+    std::vector<Counted<int>> reversed = std::vector<Counted<int>>();
+    for (int i = 0; i < n; i++)
+        reversed.push_back(n - i);
+    Counted<int>::reset();
+    Insertion<Counted<int>>::sort(reversed);
+    OperationCounts counts = Counted<int>::counts();
+    StdOut::printf("insertion: %lld compares, %lld swaps, %lld moves\n", counts.compares, counts.swaps, counts.moves);
+    if (counts.swaps != n * (n - 1) / 2 || counts.moves != 0 || counts.compares < n * (n - 1) / 2) return 1;
+    for (int i = 0; i < n; i++)
+        if (reversed[i].key() != i + 1) return 1;
+
+    // heapsort moves keys instead of exchanging them
+    std::vector<Counted<double>> doubles = std::vector<Counted<double>>();
+    for (int i = 0; i < 10000; i++)
+        doubles.push_back(StdRandom::uniform_double());
+    Counted<double>::reset();
+    Heap<Counted<double>>::sort(doubles);
+    counts = Counted<double>::counts();
+    StdOut::printf("heap: %lld compares, %lld swaps, %lld moves\n", counts.compares, counts.swaps, counts.moves);
+    if (counts.swaps != 0 || counts.moves == 0 || counts.compares == 0) return 1;
+
+    // the counts add up across the threads of a parallel sort
+    std::vector<Counted<double>> copy = doubles;
+    StdRandom::shuffle(doubles);
+    Counted<double>::reset();
+    Quick<Counted<double>>::parallel_sort(doubles);
+    counts = Counted<double>::counts();
+    if (counts.compares < 10000 || counts.swaps == 0 || doubles != copy) return 1;
+
+    // priority queues move their keys into holes rather than exchanging them
+    MinPQ<Counted<int>> pq = MinPQ<Counted<int>>();
+    for (int i = 0; i < 1000; i++)
+        pq.insert(StdRandom::uniform_int(1000));
+    Counted<int>::reset();
+    for (int i = 0; i < 1000; i++)
+        pq.del_min();
+    counts = Counted<int>::counts();
+    StdOut::printf("MinPQ: %lld compares, %lld moves\n", counts.compares, counts.moves);
+    if (counts.compares == 0 || counts.swaps != 0 || counts.moves < 1000) return 1;
+
+    IndexMinPQ<Counted<int>> index_pq = IndexMinPQ<Counted<int>>(1000);
+    Counted<int>::reset();
+    for (int i = 0; i < 1000; i++)
+        index_pq.insert(i, 1000 - i);
+    counts = Counted<int>::counts();
+    if (counts.compares == 0 || counts.swaps != 0 || counts.moves < 1000) return 1;
+
+    // a symbol table counts its key compares as probes
+    BST<Counted<std::string>, int> st = BST<Counted<std::string>, int>();
+    for (int i = 0; i < 1000; i++)
+        st.put(std::to_string(StdRandom::uniform_int(1 << 20)), i);
+    Counted<std::string>::reset();
+    st.get(std::string("12345"));
+    counts = Counted<std::string>::counts();
+    StdOut::printf("BST: %lld probes\n", counts.compares);
+    if (counts.compares == 0 || counts.compares > 2 * st.height() + 2) return 1;
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include "ExternalSort.h"
+#include "StdOut.h"
+#include "StdRandom.h"
+
+/**
+ * Writes files of random lines and integers, sorts them with a small memory
+ * budget and fan-in so that they are merged in several passes, and checks
+ * the output against std::sort. A malformed integer file must fail without
+ * leaving runs behind.
+ *
+ * @param args the command-line arguments
+ */
+int Sorting_TestExternalSort(int argc, char** argv)
+{
+    std::filesystem::path dir = std::filesystem::temp_directory_path();
+    std::string input = (dir / "algs4cpp-external-in.txt").string();
+    std::string output = (dir / "algs4cpp-external-out.txt").string();
+    ExternalSort sorter = ExternalSort(64 * 1024, 4);
+
+    // lines of random lengths with a shared prefix, an empty line, and no final newline
+    int n = 50000;
+    std::vector<std::string> lines = std::vector<std::string>();
+    for (int i = 0; i < n; i++)
+    {
+        std::string line = StdRandom::uniform_int(2) == 0 ? "http://" : "";
+        int length = StdRandom::uniform_int(30);
+        for (int j = 0; j < length; j++)
+            line += (char) ('a' + StdRandom::uniform_int(26));
+        lines.push_back(line);
+    }
+    lines[n / 2] = "";
+    {
+        std::ofstream out = std::ofstream(input, std::ios::binary);
+        for (int i = 0; i < n; i++)
+            out << lines[i] << (i < n - 1 ? "\n" : "");
+    }
+    sorter.sort_lines(input, output);
+    StdOut::printf("lines: %d runs, %d merge passes\n", sorter.runs(), sorter.merge_passes());
+    if (sorter.merge_passes() < 2) return 1;
+
+    std::sort(lines.begin(), lines.end());
+    std::ifstream in = std::ifstream(output, std::ios::binary);
+    std::string line;
+    for (int i = 0; i < n; i++)
+        if (!std::getline(in, line) || line != lines[i]) return 1;
+    if (std::getline(in, line)) return 1;
+    in.close();
+
+    // integers of every size, separated by assorted whitespace
+    std::vector<int64_t> values = std::vector<int64_t>();
+    for (int i = 0; i < n; i++)
+        values.push_back((int64_t) StdRandom::uniform_int(-1000000, 1000000) << StdRandom::uniform_int(40));
+    values.push_back(std::numeric_limits<int64_t>::min());
+    values.push_back(std::numeric_limits<int64_t>::max());
+    {
+        std::ofstream out = std::ofstream(input, std::ios::binary);
+        for (int64_t x : values)
+            out << x << (StdRandom::uniform_int(3) == 0 ? "\n" : " \t ");
+    }
+    sorter.sort_integers(input, output);
+    StdOut::printf("integers: %d runs, %d merge passes\n", sorter.runs(), sorter.merge_passes());
+
+    std::sort(values.begin(), values.end());
+    in.open(output, std::ios::binary);
+    int64_t x;
+    for (int64_t expected : values)
+        if (!(in >> x) || x != expected) return 1;
+    if (in >> x) return 1;
+    in.close();
+
+    // an empty file sorts to an empty file
+    std::ofstream(input, std::ios::binary).close();
+    sorter.sort_lines(input, output);
+    if (std::filesystem::file_size(output) != 0) return 1;
+
+    // a bad token after several runs are written throws, and the runs go with it
+    std::filesystem::path temp = dir / "algs4cpp-external-temp";
+    std::filesystem::create_directory(temp);
+    {
+        std::ofstream out = std::ofstream(input, std::ios::binary);
+        for (int i = 0; i < n; i++)
+            out << i << "\n";
+        out << "12x\n";
+    }
+    bool failed = false;
+    try
+    {
+        ExternalSort(64 * 1024, 4, temp.string()).sort_integers(input, output);
+    }
+    catch (const std::invalid_argument&)
+    {
+        failed = true;
+    }
+    bool clean = std::filesystem::is_empty(temp);
+    std::filesystem::remove_all(temp);
+    if (!failed || !clean) return 1;
+
+    std::filesystem::remove(input);
+    std::filesystem::remove(output);
+    return 0;
+}
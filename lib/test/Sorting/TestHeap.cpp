@@ -1,6 +1,8 @@
 #include "Heap.h"
+#include "Counted.h"
 #include "StdOut.h"
 #include "In.h"
+#include "StdRandom.h"
 
 /**
  * Reads in a sequence of strings from standard input; heapsorts them;
@@ -23,5 +25,74 @@ int Sorting_TestHeap(int argc, char** argv)
     StdOut::println("Sorted Words3 Data");
     Heap<std::string>::show(words3_data);
 
+    // the order can be given as a functor type or as a lambda
+    std::vector<std::string> descending = words3_data;
+    Heap<std::string, std::greater<std::string>>::sort(descending);
+    if (!std::is_sorted(descending.rbegin(), descending.rend())) return 1;
+    Heap<std::string>::sort(descending, [](const std::string& v, const std::string& w) { return v < w; });
+    if (descending != words3_data) return 1;
+
+    // binary, 4-ary and 8-ary heaps, whatever the root offset, on whole arrays and subarrays
+    for (int n : { 0, 1, 2, 3, 7, 8, 9, 17, 64, 100, 1000, 100000 })
+    {
+        std::vector<double> a = std::vector<double>(n);
+        for (int i = 0; i < n; i++)
+            a[i] = StdRandom::uniform_int(n / 2 + 1);
+        std::vector<double> expected = a;
+        std::sort(expected.begin(), expected.end());
+        std::vector<double> b = a, c = a;
+        Heap<double>::sort(a);
+        Heap<double>::sort<4>(b);
+        Heap<double>::sort<8>(c, std::greater<double>());
+        std::reverse(c.begin(), c.end());
+        if (a != expected || b != expected || c != expected) return 1;
+
+        for (int lo = 0; lo < std::min(n, 9); lo++)
+        {
+            std::vector<double> d = expected;
+            std::reverse(d.begin() + lo, d.end());
+            Heap<double>::sort<8>(d, lo, n - 1);
+            if (d != expected) return 1;
+        }
+    }
+    std::vector<std::string> words = words3_data;
+    StdRandom::shuffle(words);
+    Heap<std::string>::sort<4>(words);
+    if (words != words3_data) return 1;
+
+    // the keys waiting before an aligned root cost at most about one more move each, whatever the offset
+    {
+        int n = 100000;
+        std::vector<Counted<double>> keys = std::vector<Counted<double>>();
+        for (int i = 0; i < n; i++)
+            keys.push_back(StdRandom::uniform_double());
+        long long fewest = std::numeric_limits<long long>::max(), most = 0;
+        for (int lo = 0; lo < 8; lo++)
+        {
+            std::vector<Counted<double>> a = std::vector<Counted<double>>(lo);
+            a.insert(a.end(), keys.begin(), keys.end());
+            Counted<double>::reset();
+            Heap<Counted<double>>::sort<8>(a, lo, lo + n - 1);
+            long long moves = Counted<double>::counts().moves;
+            if (!std::is_sorted(a.begin() + lo, a.end())) return 1;
+            fewest = std::min(fewest, moves);
+            most = std::max(most, moves);
+        }
+        StdOut::printf("%lld to %lld moves for %d keys\n", fewest, most, n);
+        if (most - fewest > 1.25 * n) return 1;
+    }
+
+    // the bottom-up sink makes about one compare per level, n lg n in all
+    int n = 1 << 16;
+    std::vector<int> keys = std::vector<int>(n);
+    for (int i = 0; i < n; i++)
+        keys[i] = i;
+    StdRandom::shuffle(keys);
+    long long compares = 0;
+    Heap<int>::sort(keys, [&compares](int x, int y) { compares++; return x < y; });
+    StdOut::printf("%lld compares for %d keys\n", compares, n);
+    if (!std::is_sorted(keys.begin(), keys.end())) return 1;
+    if (compares > 1.2 * n * std::log2(n)) return 1;
+
     return 0;
 }
\ No newline at end of file
@@ -64,5 +64,20 @@ int Sorting_TestIndexMaxPQ(int argc, char** argv)
         StdOut::printf(("%d %s\n"), perm[i], key.c_str());
     }
 
+    // a 4-ary heap, its keys raised by push_or_increase()
+    IndexMaxPQ<int, std::less<int>, 4> ints = IndexMaxPQ<int, std::less<int>, 4>(100);
+    for (int i = 0; i < 100; i++)
+        ints.insert(i, i % 10);
+    for (int i = 0; i < 100; i += 3)
+        if (!ints.push_or_increase(i, 100 + i) || ints.push_or_increase(i, 100)) return 1;
+    int last = ints.max_key();
+    while (!ints.is_empty())
+    {
+        int key = ints.max_key();
+        int i = ints.del_max();
+        if (key > last || (i % 3 == 0) != (key >= 100)) return 1;
+        last = key;
+    }
+
     return 0;
 }
\ No newline at end of file
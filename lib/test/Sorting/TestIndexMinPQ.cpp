@@ -1,9 +1,52 @@
 #include "IndexMinPQ.h"
 #include "In.h"
+#include "StdRandom.h"
 #include "StdOut.h"
 
+// random inserts, decreases, changes and deletes of n indices: does the minimum always match a plain array of the keys?
+template <int D>
+static bool matches_keys(int n, int operations)
+{
+    IndexMinPQ<int, std::less<int>, D> pq = IndexMinPQ<int, std::less<int>, D>(n);
+    std::vector<int> keys = std::vector<int>(n, -1);    // key of each index, -1 if not on pq
+    for (int t = 0; t < operations; t++)
+    {
+        int i = StdRandom::uniform_int(n);
+        int key = StdRandom::uniform_int(1000000);
+        int op = StdRandom::uniform_int(5);
+        if (op == 0 && keys[i] != -1)
+        {
+            pq.delete_key(i);
+            keys[i] = -1;
+        }
+        else if (op == 1 && keys[i] != -1)
+        {
+            pq.change_key(i, key);
+            keys[i] = key;
+        }
+        else if (op == 2 && !pq.is_empty())
+        {
+            keys[pq.del_min()] = -1;
+        }
+        else
+        {
+            bool pushed = keys[i] == -1 || key < keys[i];
+            if (pq.push_or_decrease(i, key) != pushed) return false;
+            if (pushed) keys[i] = key;
+        }
+
+        int min = -1;
+        for (int k : keys)
+            if (k != -1 && (min == -1 || k < min)) min = k;
+        if (pq.size() != n - std::count(keys.begin(), keys.end(), -1)) return false;
+        if (min != -1 && (pq.min_key() != min || keys[pq.min_index()] != min)) return false;
+        if (keys[i] != -1 && pq.key_of(i) != keys[i]) return false;
+    }
+    return true;
+}
+
 /**
- * Unit tests the {@code IndexMaxPQ} data type.
+ * Unit tests the {@code IndexMinPQ} data type.
  *
  * @param args the command-line arguments
  */
@@ -42,5 +85,18 @@ int Sorting_TestIndexMinPQ(int argc, char** argv)
         pq.del_min();
     }
 
+    // decrease_key() raises the index to its place
+    for (int i = 0; i < strings.size(); i++)
+        pq.insert(i, strings[i]);
+    pq.decrease_key(9, "a");
+    if (pq.min_index() != 9 || pq.min_key() != "a") return 1;
+    pq.increase_key(9, "zz");
+    if (pq.min_key() != "best") return 1;
+
+    // every branching factor against a plain array of the keys
+    StdRandom::set_seed(22);
+    for (int n : { 1, 2, 10, 300 })
+        if (!matches_keys<2>(n, 3000) || !matches_keys<4>(n, 3000)) return 1;
+
     return 0;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Inversions.h"
 #include "StdOut.h"
 #include "StdIn.h"
+#include "StdRandom.h"
 
 /**
  * Reads a sequence of integers from standard input and
@@ -17,5 +18,42 @@ int Sorting_TestInversions(int argc, char** argv)
     }
     StdOut::println(Inversions::count(a));
 
+    // the parallel count agrees with the serial one, duplicates included
+    for (int n : { 0, 1, 10, 1000, 3000 })
+    {
+        std::vector<int> b = std::vector<int>(n);
+        for (int i = 0; i < n; i++)
+            b[i] = StdRandom::uniform_int(n / 4 + 1);
+        std::vector<int> copy = b;
+        if (Inversions::parallel_count(b) != Inversions::count(b)) return 1;
+        if (b != copy) return 1;
+    }
+
+    // large enough to split merges: reversed, sorted and descending-order counts
+    int n = 1000000;
+    std::vector<int> reversed = std::vector<int>(n);
+    for (int i = 0; i < n; i++)
+        reversed[i] = n - i;
+    long all = (long) n * (n - 1) / 2;
+    if (Inversions::parallel_count(reversed) != all) return 1;
+    if (Inversions::parallel_count(reversed, std::greater<int>()) != 0) return 1;
+    std::vector<int> pairs = std::vector<int>(n);
+    for (int i = 0; i < n; i++)
+        pairs[i] = i ^ 1;
+    if (Inversions::parallel_count(pairs) != n / 2) return 1;
+
+    // Kendall tau distance between two rankings
+    std::vector<int> x = { 0, 3, 1, 6, 2, 5, 4 };
+    std::vector<int> y = { 1, 0, 3, 6, 4, 2, 5 };
+    StdOut::println(Inversions::kendall_tau(x, y));
+    if (Inversions::kendall_tau(x, y) != 4) return 1;
+    std::vector<int> identity = std::vector<int>(n);
+    for (int i = 0; i < n; i++)
+        identity[i] = i;
+    for (int i = 0; i < n; i++)
+        reversed[i] = n - 1 - i;
+    if (Inversions::kendall_tau(identity, reversed) != all) return 1;
+    if (Inversions::kendall_tau(reversed, reversed) != 0) return 1;
+
     return 0;
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "MaxPQ.h"
 #include "In.h"
+#include "StdRandom.h"
 #include "StdOut.h"
 
 
@@ -21,5 +22,28 @@ int Sorting_TestMaxPQ(int argc, char** argv)
     }
     StdOut::printf("(%d left on pq)\n",pq.size()); 
 
+    // a 4-ary heap of random keys comes out in descending order
+    StdRandom::set_seed(21);
+    std::vector<int> keys = std::vector<int>(10000);
+    for (int& key : keys)
+        key = StdRandom::uniform_int(1000);
+    MaxPQ<int, std::less<int>, 4> max_pq = MaxPQ<int, std::less<int>, 4>(keys);
+    std::sort(keys.begin(), keys.end(), std::greater<int>());
+    for (int key : keys)
+        if (max_pq.del_max() != key) return 1;
+    for (int key : keys)
+        max_pq.insert(key);
+    if (max_pq.size() != keys.size() || max_pq.max() != keys[0]) return 1;
+
+    // the largest keys in one pass, then a batch back in, then the smallest key replaced
+    std::vector<int> largest = std::vector<int>();
+    max_pq.pop_k(5000, largest);
+    if (largest != std::vector<int>(keys.begin(), keys.begin() + 5000)) return 1;
+    max_pq.insert_range(largest.begin(), largest.end());
+    if (max_pq.replace_max(-1) != keys[0] || max_pq.size() != keys.size()) return 1;
+    largest.clear();
+    max_pq.pop_k(max_pq.size(), largest);
+    if (largest.back() != -1 || !std::is_sorted(largest.rbegin(), largest.rend())) return 1;
+
     return 0;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Merge.h"
 #include "StdOut.h"
 #include "In.h"
+#include "StdRandom.h"
 
 /**
  * Reads in a sequence of strings from standard input; mergesorts them;
@@ -23,6 +24,20 @@ int Sorting_TestMerge(int argc, char** argv)
     Merge<std::string>::sort(words3_data);
     StdOut::println("Sorted Words3 Data");
     Merge<std::string>::show(words3_data);
+    StdOut::println();
+
+    In words3_parallel_file("res/words3.txt");
+    std::vector<std::string> words3_parallel_data = words3_parallel_file.read_all_strings();
+    Merge<std::string>::parallel_sort(words3_parallel_data);
+    StdOut::println("Parallel Sorted Words3 Data");
+    Merge<std::string>::show(words3_parallel_data);
+
+    // large enough to fork and to split merges across the pool
+    std::vector<int> numbers = std::vector<int>(1000000);
+    for (int i = 0; i < numbers.size(); i++)
+        numbers[i] = StdRandom::uniform_int(1000);
+    Merge<int>::parallel_sort(numbers);
+    if (!std::is_sorted(numbers.begin(), numbers.end())) return 1;
 
     return 0;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "MergeBU.h"
 #include "StdOut.h"
 #include "In.h"
+#include "StdRandom.h"
 
 /**
  * Reads in a sequence of strings from standard input; bottom-up
@@ -23,5 +24,33 @@ int Sorting_TestMergeBU(int argc, char** argv)
     StdOut::println("Sorted Words3 Data");
     MergeBU<std::string>::show(words3_data);
 
+    // runs: sorted, reverse sorted, sorted with a random tail, and a few random edits
+    int n = 100000;
+    std::vector<int> sorted = std::vector<int>(n);
+    for (int i = 0; i < n; i++)
+        sorted[i] = StdRandom::uniform_int(n);
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<int> reversed = std::vector<int>(sorted.rbegin(), sorted.rend());
+    std::vector<int> appended = sorted;
+    for (int i = 0; i < 1000; i++)
+        appended.push_back(StdRandom::uniform_int(n));
+    std::vector<int> edited = sorted;
+    for (int i = 0; i < 100; i++)
+        edited[StdRandom::uniform_int(n)] = StdRandom::uniform_int(n);
+    for (std::vector<int>* a : { &sorted, &reversed, &appended, &edited })
+    {
+        std::vector<int> expected = *a;
+        std::sort(expected.begin(), expected.end());
+        MergeBU<int>::sort(*a);
+        if (*a != expected) return 1;
+    }
+
+    // stability: keys with few distinct values keep their original order
+    std::vector<std::pair<int, int>> pairs = std::vector<std::pair<int, int>>(n);
+    for (int i = 0; i < n; i++)
+        pairs[i] = std::make_pair(StdRandom::uniform_int(10), i);
+    MergeBU<std::pair<int, int>>::sort(pairs, [](const std::pair<int, int>& v, const std::pair<int, int>& w) { return v.first < w.first; });
+    if (!std::is_sorted(pairs.begin(), pairs.end())) return 1;
+
     return 0;
 }
\ No newline at end of file
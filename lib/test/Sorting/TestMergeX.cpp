@@ -1,6 +1,8 @@
 #include "MergeX.h"
 #include "StdOut.h"
 #include "In.h"
+#include "StdRandom.h"
+#include "Transaction.h"
 
 /**
  * Reads in a sequence of strings from standard input; mergesorts them
@@ -23,6 +25,33 @@ int Sorting_TestMergeX(int argc, char** argv)
     MergeX<std::string>::sort(words3_data);
     StdOut::println("Sorted Words3 Data");
     MergeX<std::string>::show(words3_data);
+    StdOut::println();
+
+    In words3_parallel_file("res/words3.txt");
+    std::vector<std::string> words3_parallel_data = words3_parallel_file.read_all_strings();
+    MergeX<std::string>::parallel_sort(words3_parallel_data);
+    StdOut::println("Parallel Sorted Words3 Data");
+    MergeX<std::string>::show(words3_parallel_data);
+
+    // large enough to fork and to split merges across the pool
+    std::vector<int> numbers = std::vector<int>(1000000);
+    for (int i = 0; i < numbers.size(); i++)
+        numbers[i] = StdRandom::uniform_int(1000);
+    MergeX<int>::parallel_sort(numbers);
+    if (!std::is_sorted(numbers.begin(), numbers.end())) return 1;
+
+    std::vector<Transaction> transactions = std::vector<Transaction>();
+    for (int i = 0; i < 100000; i++)
+        transactions.push_back(Transaction(std::to_string(i), Date(1, 1 + i % 28, 2000), i % 97));
+    MergeX<Transaction>::parallel_sort(transactions, Transaction::how_much_order);
+    for (int i = 1; i < transactions.size(); i++)
+    {
+        if (transactions[i].amount() < transactions[i-1].amount()) return 1;
+
+        // stable: equal amounts keep their original order
+        if (transactions[i].amount() == transactions[i-1].amount()
+            && std::stoi(transactions[i].who()) < std::stoi(transactions[i-1].who())) return 1;
+    }
 
     return 0;
 }
\ No newline at end of file
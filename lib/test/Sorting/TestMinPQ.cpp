@@ -1,7 +1,33 @@
 #include "MinPQ.h"
 #include "In.h"
+#include "StdRandom.h"
 #include "StdOut.h"
 
+// insert random keys, deleting the minimum after every third: do the keys come out in order?
+template <int D>
+static bool drains_in_order(int n)
+{
+    MinPQ<int, std::less<int>, D> pq = MinPQ<int, std::less<int>, D>();
+    std::map<int, int> count = std::map<int, int>();     // how many of each key are on pq
+    for (int i = 0; i < n; i++)
+    {
+        int key = StdRandom::uniform_int(n);
+        pq.insert(key);
+        count[key]++;
+        if (i % 3 == 2)
+        {
+            int min = count.begin()->first;
+            if (pq.del_min() != min) return false;
+            if (--count[min] == 0) count.erase(min);
+        }
+    }
+
+    for (auto [key, times] : count)
+        for (int t = 0; t < times; t++)
+            if (pq.del_min() != key) return false;
+    return pq.is_empty();
+}
+
 /**
  * Unit tests the {@code MinPQ} data type.
  *
@@ -20,5 +46,82 @@ int Sorting_TestMinPQ(int argc, char** argv)
     }
     StdOut::printf("(%d left on pq)\n",pq.size()); 
 
+    // a reversed order turns the min priority queue into a max priority queue
+    MinPQ<std::string, std::greater<std::string>> max_pq = MinPQ<std::string, std::greater<std::string>>();
+    for (std::string item : items)
+        if (!(item == "-")) max_pq.insert(item);
+    std::string last = max_pq.min();
+    while (!max_pq.is_empty())
+    {
+        std::string item = max_pq.del_min();
+        if (last < item) return 1;
+        last = item;
+    }
+
+    // every branching factor, and the keys of an array heapified in place
+    StdRandom::set_seed(21);
+    for (int n : { 1, 2, 3, 100, 10000 })
+        if (!drains_in_order<2>(n) || !drains_in_order<4>(n) || !drains_in_order<8>(n)) return 1;
+
+    std::vector<std::string> keys = std::vector<std::string>();
+    for (std::string item : items)
+        if (!(item == "-")) keys.push_back(item);
+    MinPQ<std::string, std::less<std::string>, 4> heapified = MinPQ<std::string, std::less<std::string>, 4>(keys);
+    std::sort(keys.begin(), keys.end());
+    if (heapified.size() != keys.size()) return 1;
+    for (const std::string& key : keys)
+        if (heapified.del_min() != key) return 1;
+
+    // keys constructed in place
+    MinPQ<std::string> emplaced = MinPQ<std::string>();
+    emplaced.emplace(3, 'c');
+    emplaced.emplace(1, 'a');
+    emplaced.emplace(2, 'b');
+    if (emplaced.del_min() != "a" || emplaced.min() != "bb") return 1;
+
+    // batches swum up or heapified over their ancestors, and the smallest keys taken a few or many at a time
+    for (int batch : { 1, 3, 100, 5000 })
+    {
+        MinPQ<int, std::less<int>, 4> batched = MinPQ<int, std::less<int>, 4>();
+        std::vector<int> all = std::vector<int>();
+        for (int round = 0; round < 3; round++)
+        {
+            std::vector<int> keys = std::vector<int>(batch);
+            for (int& key : keys)
+                key = StdRandom::uniform_int(1000);
+            batched.insert_range(keys.begin(), keys.end());
+            all.insert(all.end(), keys.begin(), keys.end());
+        }
+        std::sort(all.begin(), all.end());
+
+        std::vector<int> removed = std::vector<int>();
+        batched.pop_k(2, removed);
+        batched.pop_k(batched.size() / 2, removed);
+        batched.pop_k(batched.size(), removed);
+        if (removed != all || !batched.is_empty()) return 1;
+    }
+
+    // replace_min() keeps the 10 largest keys of a stream
+    std::vector<int> stream = std::vector<int>(1000);
+    for (int& key : stream)
+        key = StdRandom::uniform_int(100000);
+    MinPQ<int> top = MinPQ<int>(10);
+    for (int key : stream)
+    {
+        if (top.size() < 10) top.insert(key);
+        else if (top.min() < key) top.replace_min(key);
+    }
+    std::sort(stream.begin(), stream.end());
+    std::vector<int> largest = std::vector<int>();
+    top.pop_k(10, largest);
+    if (largest != std::vector<int>(stream.end() - 10, stream.end())) return 1;
+
+    // keys copied out of their allocations, which keep them
+    std::vector<ptr<std::string>> allocated = std::vector<ptr<std::string>>();
+    for (const std::string& key : keys)
+        allocated.push_back(alloc<std::string>(key));
+    MinPQ<std::string> copied = MinPQ<std::string>(allocated);
+    if (copied.size() != allocated.size() || copied.min() != keys[0] || *allocated[0] != keys[0]) return 1;
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "MultiQueue.h"
+#include "StdRandom.h"
+#include "StdOut.h"
+#include "ThreadPool.h"
+
+/**
+ * Unit tests the {@code MultiQueue} data type.
+ *
+ * @param args the command-line arguments
+ */
+int Sorting_TestMultiQueue(int argc, char** argv)
+{
+    StdRandom::set_seed(23);
+    std::vector<int> keys = std::vector<int>(10000);
+    for (int& key : keys)
+        key = StdRandom::uniform_int(1000000);
+    std::vector<int> sorted = keys;
+    std::sort(sorted.begin(), sorted.end());
+
+    // a strict queue removes the keys in order
+    MultiQueue<int> strict = MultiQueue<int>::strict();
+    strict.insert_batch(keys.begin(), keys.end());
+    if (!strict.is_strict() || strict.size() != keys.size()) return 1;
+    int key;
+    for (int expected : sorted)
+        if (!strict.try_del_min(key) || key != expected) return 1;
+    if (strict.try_del_min(key) || !strict.is_empty()) return 1;
+    MultiQueue<int>::RankError exact = strict.rank_error();
+    if (exact.samples != keys.size() || exact.max != 0) return 1;
+
+    // a relaxed queue removes every key, each close to the minimum
+    MultiQueue<int> relaxed = MultiQueue<int>(8, 1, 1);
+    for (int k : keys)
+        relaxed.insert(k);
+    std::vector<int> removed = std::vector<int>();
+    while (relaxed.try_del_min_batch(StdRandom::uniform_int(1, 4), removed) > 0)
+    {
+    }
+    std::sort(removed.begin(), removed.end());
+    if (removed != sorted) return 1;
+    MultiQueue<int>::RankError error = relaxed.rank_error();
+    StdOut::printf("8 heaps: mean rank error %.2f, max %lld\n", error.mean, error.max);
+    if (error.samples != keys.size() || error.mean > 4 * relaxed.heaps()) return 1;
+
+    // a thread that works on two queues in turn keeps its state on each
+    MultiQueue<int> left = MultiQueue<int>(4, 8, 16);
+    MultiQueue<int> right = MultiQueue<int>(4, 8, 16);
+    for (int k : keys)
+    {
+        left.insert(k);
+        right.insert(k);
+    }
+    for (int i = 0; i < 1000; i++)
+        if (!left.try_del_min(key) || !right.try_del_min(key)) return 1;
+    if (left.rank_error().samples != 1000 / 16 || right.rank_error().samples != 1000 / 16) return 1;
+
+    // producers and consumers at once: every key comes out exactly once
+    MultiQueue<int> shared = MultiQueue<int>(16);
+    const int TASKS = 8;
+    std::vector<std::vector<int>> taken = std::vector<std::vector<int>>(TASKS);
+    TaskGroup group;
+    for (int t = 0; t < TASKS; t++)
+    {
+        group.run([&shared, &keys, &taken, t]
+        {
+            int n = keys.size() / TASKS;
+            auto first = keys.begin() + t * n;
+            shared.insert_batch(first, first + n / 2);
+            for (auto it = first + n / 2; it != first + n; ++it)
+            {
+                shared.insert(*it);
+                int key;
+                if (it - first < n * 3 / 4 && shared.try_del_min(key)) taken[t].push_back(key);
+            }
+            shared.try_del_min_batch(n / 4, taken[t]);
+        });
+    }
+    group.wait();
+    std::vector<int> all = std::vector<int>();
+    while (shared.try_del_min(key))
+        all.push_back(key);
+    for (const std::vector<int>& keys_of_task : taken)
+        all.insert(all.end(), keys_of_task.begin(), keys_of_task.end());
+    std::sort(all.begin(), all.end());
+    if (all != sorted || !shared.is_empty()) return 1;
+
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include "Quick.h"
+#include "AdversaryTest.h"
 #include "StdOut.h"
 #include "In.h"
 #include "StdRandom.h"
@@ -42,8 +43,88 @@ int Sorting_TestQuick(int argc, char** argv)
         StdOut::println(ith);
     }
 
-    return 0;
-    
+    In words3_parallel_file("res/words3.txt");
+    std::vector<std::string> words3_parallel_data = words3_parallel_file.read_all_strings();
+    Quick<std::string>::parallel_sort(words3_parallel_data);
+    StdOut::println("Parallel Sorted Words3 Data");
+    Quick<std::string>::show(words3_parallel_data);
+    if (!Quick<std::string>::is_sorted(words3_parallel_data)) return 1;
+
+    // duplicate-heavy and already sorted inputs, large enough to partition in parallel
+    std::vector<int> numbers = std::vector<int>(1000000);
+    for (int i = 0; i < numbers.size(); i++)
+        numbers[i] = StdRandom::uniform_int(10);
+    Quick<int>::parallel_sort(numbers);
+    if (!Quick<int>::is_sorted(numbers)) return 1;
+    Quick<int>::parallel_sort(numbers);
+    if (!Quick<int>::is_sorted(numbers)) return 1;
+
+    // introsort: sorted, reversed, organ pipe and random inputs without the shuffle
+    std::vector<std::vector<int>> inputs = std::vector<std::vector<int>>(4, std::vector<int>(100000));
+    for (int i = 0; i < 100000; i++)
+    {
+        inputs[0][i] = i;
+        inputs[1][i] = -i;
+        inputs[2][i] = std::min(i, 100000 - i);
+        inputs[3][i] = StdRandom::uniform_int(100000);
+    }
+    for (std::vector<int>& input : inputs)
+    {
+        Quick<int>::intro_sort(input);
+        if (!Quick<int>::is_sorted(input)) return 1;
+    }
+    In words3_intro_file("res/words3.txt");
+    std::vector<std::string> words3_intro_data = words3_intro_file.read_all_strings();
+    Quick<std::string>::intro_sort(words3_intro_data, std::greater<std::string>());
+    if (!std::is_sorted(words3_intro_data.rbegin(), words3_intro_data.rend())) return 1;
 
-return 0;
+    // McIlroy's adversary makes every pivot nearly the smallest key; introsort bounds the compares anyway
+    int n = 20000;
+    long long compares = adversary_compares(n, [](std::vector<int>& keys, auto less)
+    {
+        Quick<int>::intro_sort(keys, less);
+    });
+    StdOut::printf("%lld compares on the adversary\n", compares);
+    if (compares < 0 || compares > 5LL * n * (int) std::log2(n)) return 1;
+
+    // multi-select: every listed rank holds its key, and the keys between two ranks stay between them
+    for (int size : { 1, 10, 1000, 100000, 1000000 })
+    {
+        std::vector<int> a = std::vector<int>(size);
+        for (int i = 0; i < size; i++)
+            a[i] = StdRandom::uniform_int(size / 4 + 1);
+        std::vector<int> expected = a;
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<int> ranks = { size - 1, size / 2, 0, 99 * size / 100, size / 2 };
+        std::vector<int> b = a;
+        std::vector<int> selected = Quick<int>::select(a, ranks);
+        std::vector<int> parallel_selected = Quick<int>::parallel_select(b, ranks);
+        std::sort(ranks.begin(), ranks.end());
+        for (int i = 0; i < ranks.size(); i++)
+        {
+            int k = ranks[i];
+            if (a[k] != expected[k] || b[k] != expected[k]) return 1;
+            int next = i + 1 < ranks.size() ? ranks[i+1] : size;
+            for (int j = k + 1; j < next; j++)
+                if (a[j] < a[k] || b[j] < b[k] || (next < size && (a[j] > a[next] || b[j] > b[next]))) return 1;
+        }
+        if (selected != parallel_selected || selected[1] != expected[size / 2]) return 1;
+    }
+
+    // one rank costs about n + min(k, n - k) compares
+    std::vector<double> latencies = std::vector<double>(1000000);
+    for (int i = 0; i < latencies.size(); i++)
+        latencies[i] = StdRandom::uniform_int(1000000);
+    std::vector<double> sorted_latencies = latencies;
+    std::sort(sorted_latencies.begin(), sorted_latencies.end());
+    compares = 0;
+    Quick<double>::select(latencies, { 500000 }, [&compares](double x, double y) { compares++; return x < y; });
+    StdOut::printf("%lld compares to select the median\n", compares);
+    if (latencies[500000] != sorted_latencies[500000] || compares > 2 * latencies.size()) return 1;
+    std::vector<double> q = Quick<double>::quantiles(latencies, { 0.5, 0.9, 0.99, 0.999, 0, 1 });
+    if (q != std::vector<double>({ sorted_latencies[499999], sorted_latencies[899999], sorted_latencies[989999],
+                                   sorted_latencies[998999], sorted_latencies[0], sorted_latencies[999999] })) return 1;
+
+    return 0;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Quick3way.h"
 #include "StdOut.h"
 #include "In.h"
+#include "StdRandom.h"
 
 /**
  * Reads in a sequence of strings from standard input; 3-way
@@ -25,5 +26,21 @@ int Sorting_TestQuick3way(int argc, char** argv)
     Quick3way<std::string>::show(words3_data);
     if (!Quick3way<std::string>::is_sorted(words3_data)) return 1;
 
+    In words3_parallel_file("res/words3.txt");
+    std::vector<std::string> words3_parallel_data = words3_parallel_file.read_all_strings();
+    Quick3way<std::string>::parallel_sort(words3_parallel_data);
+    StdOut::println("Parallel Sorted Words3 Data");
+    Quick3way<std::string>::show(words3_parallel_data);
+    if (!Quick3way<std::string>::is_sorted(words3_parallel_data)) return 1;
+
+    // duplicate-heavy and already sorted inputs, large enough to partition in parallel
+    std::vector<int> numbers = std::vector<int>(1000000);
+    for (int i = 0; i < numbers.size(); i++)
+        numbers[i] = StdRandom::uniform_int(10);
+    Quick3way<int>::parallel_sort(numbers);
+    if (!Quick3way<int>::is_sorted(numbers)) return 1;
+    Quick3way<int>::parallel_sort(numbers);
+    if (!Quick3way<int>::is_sorted(numbers)) return 1;
+
     return 0;
 }
\ No newline at end of file
@@ -1,11 +1,13 @@
 #include "QuickBentleyMcIlroy.h"
+#include "AdversaryTest.h"
 #include "StdOut.h"
 #include "In.h"
 
 /**
  * Reads in a sequence of strings from standard input; quicksorts them
  * (using an optimized version of quicksort);
- * and prints them to standard output in ascending order.
+ * and prints them to standard output in ascending order. Then checks that
+ * McIlroy's adversary cannot drive it quadratic.
  *
  * @param args the command-line arguments
  */
@@ -26,5 +28,14 @@ int Sorting_TestQuickBentleyMcIlroy(int argc, char** argv)
     QuickBentleyMcIlroy<std::string>::show(words3_data);
     if (!QuickBentleyMcIlroy<std::string>::is_sorted(words3_data)) return 1;
 
+    // McIlroy's adversary makes every pivot nearly the smallest key; introsort bounds the compares anyway
+    int n = 20000;
+    long long compares = adversary_compares(n, [](std::vector<int>& keys, auto less)
+    {
+        QuickBentleyMcIlroy<int>::sort(keys, less);
+    });
+    StdOut::printf("%lld compares on the adversary\n", compares);
+    if (compares < 0 || compares > 5LL * n * (int) std::log2(n)) return 1;
+
     return 0;
 }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #include "QuickX.h"
+#include "AdversaryTest.h"
 #include "StdOut.h"
 #include "In.h"
+#include "StdRandom.h"
 
 /**
  * Reads in a sequence of strings from standard input; quicksorts them
@@ -26,5 +28,52 @@ int Sorting_TestQuickX(int argc, char** argv)
     QuickX<std::string>::show(words3_data);
     if (!QuickX<std::string>::is_sorted(words3_data)) return 1;
 
+    In words3_parallel_file("res/words3.txt");
+    std::vector<std::string> words3_parallel_data = words3_parallel_file.read_all_strings();
+    QuickX<std::string>::parallel_sort(words3_parallel_data);
+    StdOut::println("Parallel Sorted Words3 Data");
+    QuickX<std::string>::show(words3_parallel_data);
+    if (!QuickX<std::string>::is_sorted(words3_parallel_data)) return 1;
+
+    // duplicate-heavy and already sorted inputs, large enough to partition in parallel
+    std::vector<int> numbers = std::vector<int>(1000000);
+    for (int i = 0; i < numbers.size(); i++)
+        numbers[i] = StdRandom::uniform_int(10);
+    QuickX<int>::parallel_sort(numbers);
+    if (!QuickX<int>::is_sorted(numbers)) return 1;
+    QuickX<int>::parallel_sort(numbers);
+    if (!QuickX<int>::is_sorted(numbers)) return 1;
+
+    // block and Hoare partitioning on every size up to a few blocks, and on large inputs
+    for (int n : { 0, 1, 2, 9, 40, 127, 128, 129, 200, 256, 300, 1000, 100000 })
+    {
+        for (int distinct : { 2, n + 1 })
+        {
+            std::vector<double> a = std::vector<double>(n);
+            for (int i = 0; i < n; i++)
+                a[i] = StdRandom::uniform_int(distinct) - distinct/2;
+            std::vector<double> expected = a;
+            std::sort(expected.begin(), expected.end());
+            std::vector<double> b = a;
+            QuickX<double>::sort(a, QuickX<double>::Partitioning::BLOCK);
+            QuickX<double>::sort(b, std::greater<double>(), QuickX<double>::Partitioning::HOARE);
+            std::reverse(b.begin(), b.end());
+            if (a != expected || b != expected) return 1;
+        }
+    }
+    std::vector<std::string> words = words3_data;
+    StdRandom::shuffle(words);
+    QuickX<std::string>::sort(words, QuickX<std::string>::Partitioning::BLOCK);
+    if (words != words3_data) return 1;
+
+    // McIlroy's adversary makes every pivot nearly the smallest key; introsort bounds the compares anyway
+    int n = 20000;
+    long long compares = adversary_compares(n, [](std::vector<int>& keys, auto less)
+    {
+        QuickX<int>::sort(keys, less, QuickX<int>::Partitioning::BLOCK);
+    });
+    StdOut::printf("%lld compares on the adversary\n", compares);
+    if (compares < 0 || compares > 5LL * n * (int) std::log2(n)) return 1;
+
     return 0;
 }
\ No newline at end of file
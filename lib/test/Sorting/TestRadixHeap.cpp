@@ -0,0 +1,40 @@
+#include "RadixHeap.h"
+#include "MonotonePQTest.h"
+#include "StdRandom.h"
+#include "StdOut.h"
+
+/**
+ * Unit tests the {@code RadixHeap} data type.
+ *
+ * @param args the command-line arguments
+ */
+int Sorting_TestRadixHeap(int argc, char** argv)
+{
+    // event times: each event schedules the next one a random delay later
+    RadixHeap<long long> events = RadixHeap<long long>(10);
+    for (int i = 0; i < 10; i++)
+        events.insert(i, StdRandom::uniform_int(1000));
+    long long now = 0;
+    for (int t = 0; t < 1000; t++)
+    {
+        long long time = events.min_key();
+        if (time < now) return 1;
+        now = time;
+        int i = events.del_min();
+        events.insert(i, now + (1LL << StdRandom::uniform_int(40)));
+    }
+    StdOut::printf("1000 events simulated up to time %lld\n", now);
+
+    // nodes of a grid by their distance from a corner, with edge weights 1 to 9
+    const int N = 30;
+    std::vector<int> distance = grid_distances(RadixHeap<int>(N * N), N);
+    if (std::count(distance.begin(), distance.end(), -1) != 0) return 1;
+    if (distance != grid_distances(IndexMinPQ<int>(N * N), N)) return 1;
+
+    StdRandom::set_seed(24);
+    for (int n : { 1, 2, 10, 300 })
+        for (int range : { 0, 1, 100, 1 << 20 })
+            if (!matches_index_min_pq(RadixHeap<int>(n), n, range, 3000)) return 1;
+
+    return 0;
+}
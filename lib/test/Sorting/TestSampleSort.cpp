@@ -0,0 +1,51 @@
+#include "SampleSort.h"
+#include "StdOut.h"
+#include "StdRandom.h"
+#include "In.h"
+
+/**
+ * Sample sorts arrays of several sizes and distributions, serially and in parallel,
+ * and checks them against std::sort.
+ *
+ * @param args the command-line arguments
+ */
+int Sorting_TestSampleSort(int argc, char** argv)
+{
+    // random, few distinct, all equal, sorted and reversed keys, from below the grain to several levels
+    for (int n : { 0, 1, 1000, SampleSort<int>::SORT_GRAIN, 100000, 3000000 })
+    {
+        for (int distinct : { 1, 3, 1000, std::numeric_limits<int>::max() })
+        {
+            std::vector<int> a = std::vector<int>(n);
+            for (int i = 0; i < n; i++)
+                a[i] = StdRandom::uniform_int(distinct);
+            std::vector<int> expected = a;
+            std::sort(expected.begin(), expected.end());
+
+            std::vector<int> b = a;
+            SampleSort<int>::parallel_sort(a);
+            SampleSort<int>::sort(b);
+            if (a != expected || b != expected) return 1;
+        }
+    }
+
+    std::vector<double> sorted = std::vector<double>(200000);
+    for (int i = 0; i < sorted.size(); i++)
+        sorted[i] = i / 3;
+    std::vector<double> reversed = std::vector<double>(sorted.rbegin(), sorted.rend());
+    std::vector<double> a = sorted;
+    SampleSort<double>::parallel_sort(a);
+    SampleSort<double>::parallel_sort(reversed);
+    if (a != sorted || reversed != sorted) return 1;
+
+    // strings in descending order
+    In large_file("res/largeText.txt");
+    std::vector<std::string> words = large_file.read_all_strings();
+    std::vector<std::string> expected = words;
+    std::sort(expected.begin(), expected.end(), std::greater<std::string>());
+    SampleSort<std::string, std::greater<std::string>>::parallel_sort(words);
+    StdOut::printf("Sample sorted %d words of largeText.txt\n", (int) words.size());
+    if (words != expected) return 1;
+
+    return 0;
+}
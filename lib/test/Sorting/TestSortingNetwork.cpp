@@ -0,0 +1,59 @@
+#include "SortingNetwork.h"
+#include "QuickX.h"
+#include "MergeX.h"
+#include "StdOut.h"
+#include "StdRandom.h"
+
+// sorts random arrays of every length the network takes and compares with std::sort
+template <typename T>
+static bool check(int range)
+{
+    for (int n = 0; n <= SortingNetwork::MAX_SIZE; n++)
+    {
+        for (int trial = 0; trial < 50; trial++)
+        {
+            std::vector<T> a = std::vector<T>(n);
+            for (int i = 0; i < n; i++)
+                a[i] = (T) (StdRandom::uniform_int(2 * range) - range);
+            std::vector<T> expected = a;
+            std::sort(expected.begin(), expected.end());
+            SortingNetwork::sort(a.data(), n);
+            if (a != expected) return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Unit tests the {@code SortingNetwork} base case, on its own and at the
+ * leaves of QuickX and MergeX.
+ *
+ * @param args the command-line arguments
+ */
+int Sorting_TestSortingNetwork(int argc, char** argv)
+{
+    if (!check<int>(1000) || !check<int>(3)) return 1;
+    if (!check<long long>(1000000)) return 1;
+    if (!check<float>(100) || !check<double>(5)) return 1;
+    if (!check<short>(100) || !check<unsigned char>(100)) return 1;
+
+    // -0.0 and 0.0 compare equal but must both survive
+    std::vector<double> zeros = { 0.0, -0.0, 1.0, -0.0, 0.0, -1.0, -0.0 };
+    SortingNetwork::sort(zeros.data(), zeros.size());
+    int negative = 0;
+    for (double z : zeros)
+        if (z == 0.0 && std::signbit(z)) negative++;
+    if (negative != 3) return 1;
+
+    std::vector<int> numbers = std::vector<int>(1000000);
+    for (int i = 0; i < numbers.size(); i++)
+        numbers[i] = StdRandom::uniform_int(1000000);
+    std::vector<int> merged = numbers;
+    QuickX<int>::sort(numbers);
+    MergeX<int>::sort(merged);
+    if (!std::is_sorted(numbers.begin(), numbers.end()) || numbers != merged) return 1;
+
+    StdOut::printf("network sorts %s blocks of up to %d keys\n",
+        SortingNetwork::applies<int, std::less<int>> ? "vectorized" : "scalar", SortingNetwork::MAX_SIZE);
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include "LSD.h"
+#include "StdOut.h"
+#include "StdRandom.h"
+#include "Transaction.h"
+#include "In.h"
+
+/**
+ * Reads in a sequence of fixed-length strings from standard input;
+ * LSD radix sorts them;
+ * and prints them to standard output in ascending order.
+ *
+ * @param args the command-line arguments
+ */
+int Strings_TestLSD(int argc, char** argv)
+{
+    In words3_file("res/words3.txt");
+    std::vector<std::string> a = words3_file.read_all_strings();
+    int n = a.size();
+
+    // check that strings have fixed length
+    int w = a[0].length();
+    for (int i = 0; i < n; i++)
+        if (a[i].length() != w) return 1;
+
+    // sort the strings
+    LSD::sort(a, w);
+
+    // print results
+    for (int i = 0; i < n; i++)
+        StdOut::println(a[i]);
+    if (!std::is_sorted(a.begin(), a.end())) return 1;
+
+    // integers, longs and doubles of both signs, serially and in parallel
+    std::vector<int> ints = std::vector<int>(200000);
+    std::vector<long> longs = std::vector<long>(200000);
+    std::vector<double> doubles = std::vector<double>(200000);
+    for (int i = 0; i < ints.size(); i++)
+    {
+        ints[i] = StdRandom::uniform_int(-1000000, 1000000);
+        longs[i] = StdRandom::uniform_long(1L << 40) - (1L << 39);
+        doubles[i] = StdRandom::gaussian();
+    }
+    std::vector<int> parallel_ints = ints;
+    std::vector<long> parallel_longs = longs;
+    std::vector<double> parallel_doubles = doubles;
+
+    LSD::sort(ints);
+    LSD::sort(longs);
+    LSD::sort(doubles);
+    LSD::parallel_sort(parallel_ints);
+    LSD::parallel_sort(parallel_longs);
+    LSD::parallel_sort(parallel_doubles);
+    if (!std::is_sorted(ints.begin(), ints.end()) || ints != parallel_ints) return 1;
+    if (!std::is_sorted(longs.begin(), longs.end()) || longs != parallel_longs) return 1;
+    if (!std::is_sorted(doubles.begin(), doubles.end()) || doubles != parallel_doubles) return 1;
+
+    // transactions by date, then stably by amount
+    std::vector<Transaction> transactions = std::vector<Transaction>();
+    for (int i = 0; i < 100000; i++)
+    {
+        Date when = Date(1 + StdRandom::uniform_int(12), 1 + StdRandom::uniform_int(28), 1990 + StdRandom::uniform_int(20));
+        transactions.push_back(Transaction("Turing", when, StdRandom::uniform_int(-500, 500) / 4.0));
+    }
+    LSD::sort(transactions, [](const Transaction& t) { return t.when(); });
+    LSD::parallel_sort(transactions, [](const Transaction& t) { return t.amount(); });
+    for (int i = 1; i < transactions.size(); i++)
+    {
+        Transaction& v = transactions[i-1];
+        Transaction& w = transactions[i];
+        if (w.amount() < v.amount()) return 1;
+        if (w.amount() == v.amount() && LSD::radix_key(w.when()) < LSD::radix_key(v.when())) return 1;
+    }
+
+    return 0;
+}
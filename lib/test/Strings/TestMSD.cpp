@@ -0,0 +1,36 @@
+#include "MSD.h"
+#include "StdOut.h"
+#include "In.h"
+
+/**
+ * Reads in a sequence of extended ASCII strings from standard input;
+ * MSD radix sorts them;
+ * and prints them to standard output in ascending order.
+ *
+ * @param args the command-line arguments
+ */
+int Strings_TestMSD(int argc, char** argv)
+{
+    In words3_file("res/words3.txt");
+    std::vector<std::string> words3_data = words3_file.read_all_strings();
+    MSD<std::string>::sort(words3_data);
+    StdOut::println("Sorted Words3 Data");
+    MSD<std::string>::show(words3_data);
+    if (!std::is_sorted(words3_data.begin(), words3_data.end())) return 1;
+    StdOut::println();
+
+    In large_file("res/largeText.txt");
+    std::vector<std::string> large_data = large_file.read_all_strings();
+    std::vector<std::string> expected = large_data;
+    std::sort(expected.begin(), expected.end());
+    MSD<std::string>::sort(large_data);
+    StdOut::printf("Sorted %d words of largeText.txt\n", (int) large_data.size());
+    if (large_data != expected) return 1;
+
+    // views share the storage of the sorted strings
+    std::vector<std::string_view> views = std::vector<std::string_view>(expected.rbegin(), expected.rend());
+    MSD<std::string_view>::sort(views);
+    if (!std::equal(views.begin(), views.end(), expected.begin(), expected.end())) return 1;
+
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include "Quick3string.h"
+#include "StdOut.h"
+#include "In.h"
+#include "StdRandom.h"
+
+/**
+ * Reads in a sequence of extended ASCII strings from standard input;
+ * 3-way radix quicksorts them;
+ * and prints them to standard output in ascending order.
+ *
+ * @param args the command-line arguments
+ */
+int Strings_TestQuick3string(int argc, char** argv)
+{
+    In words3_file("res/words3.txt");
+    std::vector<std::string> words3_data = words3_file.read_all_strings();
+    Quick3string<std::string>::sort(words3_data);
+    StdOut::println("Sorted Words3 Data");
+    Quick3string<std::string>::show(words3_data);
+    if (!std::is_sorted(words3_data.begin(), words3_data.end())) return 1;
+    StdOut::println();
+
+    In large_file("res/largeText.txt");
+    std::vector<std::string> large_data = large_file.read_all_strings();
+    std::vector<std::string> expected = large_data;
+    std::sort(expected.begin(), expected.end());
+    Quick3string<std::string>::sort(large_data);
+    StdOut::printf("Sorted %d words of largeText.txt\n", (int) large_data.size());
+    if (large_data != expected) return 1;
+
+    // views share the storage of the sorted strings
+    std::vector<std::string_view> views = std::vector<std::string_view>(expected.rbegin(), expected.rend());
+    Quick3string<std::string_view>::sort(views);
+    if (!std::equal(views.begin(), views.end(), expected.begin(), expected.end())) return 1;
+
+    // cached prefixes: long shared prefixes, embedded and trailing zero bytes, empty strings and duplicates
+    std::vector<std::string> prefixed = large_data;
+    StdRandom::shuffle(prefixed);
+    Quick3string<std::string>::prefix_sort(prefixed);
+    if (prefixed != expected) return 1;
+
+    std::vector<std::string> urls = std::vector<std::string>();
+    for (int i = 0; i < 20000; i++)
+    {
+        std::string url = StdRandom::bernoulli() ? "https://algs4.cs.princeton.edu/" : "https://algs4.cs.princeton.edu/5";
+        int length = StdRandom::uniform_int(20);
+        for (int c = 0; c < length; c++)
+            url += "ab\0"[StdRandom::uniform_int(3)];
+        urls.push_back(StdRandom::uniform_int(100) == 0 ? "" : url);
+    }
+    expected = urls;
+    std::sort(expected.begin(), expected.end());
+    Quick3string<std::string>::prefix_sort(urls);
+    if (urls != expected) return 1;
+
+    views = std::vector<std::string_view>(expected.rbegin(), expected.rend());
+    Quick3string<std::string_view>::prefix_sort(views);
+    if (!std::equal(views.begin(), views.end(), expected.begin(), expected.end())) return 1;
+
+    return 0;
+}